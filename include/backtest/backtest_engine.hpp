@@ -0,0 +1,184 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "common/config.hpp"
+#include "common/clock.hpp"
+#include "order_book/order_book.hpp"
+#include "risk/risk_manager.hpp"
+#include "strategy/strategy_interface.hpp"
+#include <array>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+struct BacktestConfig {
+    Timestamp order_latency_ns = 5'000;     // Strategy -> exchange
+    Timestamp report_latency_ns = 5'000;    // Exchange -> strategy
+    bool enable_risk_checks = true;
+    RiskLimits risk_limits;
+    bool record_fills = true;
+};
+
+struct BacktestFill {
+    Timestamp timestamp;        // Exchange (event) time
+    OrderId order_id;
+    InstrumentId instrument;
+    Side side;
+    bool aggressive;            // Took displayed liquidity on arrival
+    Price price;
+    Quantity quantity;
+};
+
+struct BacktestResult {
+    uint64_t events = 0;
+    uint64_t orders_sent = 0;
+    uint64_t orders_rejected = 0;   // By pre-trade risk
+    uint64_t duplicate_ids = 0;     // New/Replace reusing an open order's id, rejected
+    uint64_t self_trades_prevented = 0; // Resting orders cancelled as their own strategy crossed them
+    uint64_t fills = 0;
+    Quantity filled_quantity = 0;
+    double realized_pnl = 0.0;
+    double total_pnl = 0.0;
+    Timestamp first_event_time = 0;
+    Timestamp last_event_time = 0;
+    double wall_seconds = 0.0;
+
+    double events_per_second() const noexcept {
+        return wall_seconds > 0.0 ? static_cast<double>(events) / wall_seconds : 0.0;
+    }
+};
+
+/// Deterministic, single-threaded, event-time backtest runner.
+/// - Replays recorded market data in timestamp order on a simulated clock
+///   (ThreadClock), so strategy/risk timestamps and throttles follow event time
+/// - Orders reach the exchange after order_latency_ns; reports reach the
+///   strategy after report_latency_ns (FIFO delay queues)
+/// - Marketable orders fill against the displayed BBO on arrival, consuming
+///   its quantity until the next update; the rest rests in a per-instrument
+///   OrderBook holding only our orders
+/// - Resting orders fill passively when the market BBO or a trade print
+///   crosses them (matched in the OrderBook by a synthetic IOC)
+/// - Self-trade prevention: an order that would match a resting order of
+///   the same strategy cancels the resting one first (cancel-oldest);
+///   orders of different strategies still trade with each other
+/// - P&L from the RiskManager's PositionTracker, marked to mid
+/// Identical inputs and fresh strategies always give identical results.
+class BacktestEngine {
+public:
+    static constexpr size_t MAX_STRATEGIES = 8;
+
+    explicit BacktestEngine(const BacktestConfig& config);
+
+    /// Register a strategy (not owned). Returns false when full.
+    bool add_strategy(StrategyInterface* strategy);
+
+    /// Run over events sorted by timestamp. Resets all exchange/risk state first.
+    BacktestResult run(std::span<const MarketDataMessage> events);
+
+    std::span<const BacktestFill> fills() const noexcept { return fills_; }
+    const PositionTracker& positions() const noexcept { return risk_.position_tracker(); }
+    const RiskManager& risk() const noexcept { return risk_; }
+
+private:
+    struct OpenOrder {
+        uint8_t strategy;
+        InstrumentId instrument;
+        Side side;
+        Quantity quantity;
+        Quantity leaves;
+        Price price = 0;
+    };
+
+    struct MarketState {
+        Price bid = 0;
+        Price ask = 0;
+        Quantity bid_qty = 0;   // Displayed liquidity left for our orders
+        Quantity ask_qty = 0;
+    };
+
+    /// FIFO of items released at a due time. Latency is constant per queue,
+    /// so due times are non-decreasing and a FIFO is a priority queue.
+    template<typename T>
+    class DelayQueue {
+    public:
+        struct Item {
+            Timestamp due;
+            uint8_t strategy;
+            T value;
+        };
+
+        void push(Timestamp due, uint8_t strategy, const T& value) {
+            if (head_ >= COMPACT_THRESHOLD && head_ * 2 >= items_.size()) {
+                items_.erase(items_.begin(), items_.begin() + static_cast<std::ptrdiff_t>(head_));
+                head_ = 0;
+            }
+            items_.push_back({due, strategy, value});
+        }
+
+        bool empty() const noexcept { return head_ == items_.size(); }
+        const Item& front() const noexcept { return items_[head_]; }
+
+        void pop() noexcept {
+            if (++head_ == items_.size()) {
+                items_.clear();
+                head_ = 0;
+            }
+        }
+
+        void clear() noexcept { items_.clear(); head_ = 0; }
+        void reserve(size_t n) { items_.reserve(n); }
+
+    private:
+        static constexpr size_t COMPACT_THRESHOLD = 4096;
+        std::vector<Item> items_;
+        size_t head_ = 0;
+    };
+
+    void reset();
+    void drain(Timestamp until);
+    void on_event(const MarketDataMessage& md);
+    void on_order_arrival(const OrderRequest& request, uint8_t strategy, Timestamp now);
+    void on_report_delivery(const ExecutionReport& report, uint8_t strategy);
+
+    void execute_new(const OrderRequest& request, uint8_t strategy, Timestamp now);
+    void prevent_self_trade(const OrderRequest& request, uint8_t strategy, Timestamp now);
+    void match_passive(InstrumentId instrument, const MarketDataMessage& md);
+    void apply_trades(std::span<Trade> trades, Timestamp now);
+    void fill(OrderId order_id, Price price, Quantity quantity, bool aggressive, Timestamp now);
+    void send_report(const ExecutionReport& report, uint8_t strategy, Timestamp now);
+    ExecutionReport make_report(OrderId order_id, const OpenOrder& order, OrderStatus status,
+                                Timestamp now) noexcept;
+    OrderBook& book(InstrumentId instrument);
+
+    BacktestConfig config_;
+    RiskManager risk_;
+
+    std::array<StrategyInterface*, MAX_STRATEGIES> strategies_{};
+    size_t num_strategies_ = 0;
+
+    std::array<MarketState, MAX_INSTRUMENTS> market_{};
+    std::array<std::unique_ptr<OrderBook>, MAX_INSTRUMENTS> books_;
+    std::unordered_map<OrderId, OpenOrder> open_orders_;
+
+    DelayQueue<OrderRequest> order_queue_;
+    DelayQueue<ExecutionReport> report_queue_;
+
+    std::vector<BacktestFill> fills_;
+    BacktestResult result_;
+    OrderId next_exec_id_ = 1;
+    OrderId next_synthetic_id_ = SYNTHETIC_ID_BASE;
+
+    // Ids of the synthetic IOCs that represent market flow; never ours
+    static constexpr OrderId SYNTHETIC_ID_BASE = 1ULL << 62;
+};
+
+/// Load recorded market data for replay.
+/// CSV columns: timestamp,instrument,bid,ask,bid_qty,ask_qty,last,last_qty
+/// (header line skipped; prices in decimal, instrument as symbol).
+bool load_market_data_csv(const std::string& path, std::vector<MarketDataMessage>& out);
+
+} // namespace trading
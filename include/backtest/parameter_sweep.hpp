@@ -0,0 +1,65 @@
+#pragma once
+
+#include "backtest/backtest_engine.hpp"
+#include "common/config.hpp"
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trading {
+
+/// Set a strategy parameter by its system_config.json key
+/// (market_maker_spread_bps, pairs_entry_z, momentum_fast_window, ...).
+/// Returns false for keys that cannot be swept.
+bool set_sweep_parameter(SystemConfig& config, std::string_view key, double value) noexcept;
+
+/// Backtest the standard strategy set (market maker, pairs, momentum),
+/// configured from SystemConfig the same way as the live system.
+BacktestResult run_strategy_backtest(const SystemConfig& config, const BacktestConfig& backtest,
+                                     std::span<const MarketDataMessage> events);
+
+/// Grid search over strategy parameters.
+/// - Every grid point is an independent backtest with its own strategies,
+///   risk manager and simulated exchange; the event span is shared read-only
+/// - Workers claim points through one atomic cursor (dynamic scheduling), so
+///   slow points do not leave other cores idle; results land in per-point
+///   slots, no other shared writes
+class ParameterSweep {
+public:
+    struct Axis {
+        std::string key;
+        std::vector<double> values;
+    };
+
+    ParameterSweep(const SystemConfig& base, const BacktestConfig& backtest);
+
+    /// Add a grid dimension. Returns false for unknown keys or no values.
+    bool add_axis(const std::string& key, std::vector<double> values);
+
+    /// Number of grid points (product of axis sizes; 1 with no axes).
+    size_t point_count() const noexcept;
+
+    /// Parameter values of a grid point, one per axis (last axis varies fastest).
+    std::vector<double> point_values(size_t point) const;
+    SystemConfig point_config(size_t point) const;
+
+    /// Run every grid point on up to `threads` threads (0 = hardware concurrency).
+    const std::vector<BacktestResult>& run(std::span<const MarketDataMessage> events, size_t threads);
+
+    /// One row per grid point: axis values followed by the backtest result.
+    bool write_csv(const std::string& path) const;
+
+    const std::vector<Axis>& axes() const noexcept { return axes_; }
+    const std::vector<BacktestResult>& results() const noexcept { return results_; }
+    double wall_seconds() const noexcept { return wall_seconds_; }
+
+private:
+    SystemConfig base_;
+    BacktestConfig backtest_;
+    std::vector<Axis> axes_;
+    std::vector<BacktestResult> results_;
+    double wall_seconds_ = 0.0;
+};
+
+} // namespace trading
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "common/types.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace trading {
+
+/// Read-only memory-mapped replay file: a fixed header followed by packed
+/// MarketDataMessage records in timestamp order. The mapping is shared by
+/// all threads of a sweep with no copy and no synchronisation.
+class ReplayDataset {
+public:
+    static constexpr uint64_t MAGIC = 0x3159414c50455254ULL;   // "TREPLAY1"
+    static constexpr uint32_t VERSION = 1;
+
+    struct Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t record_size;   // sizeof(MarketDataMessage) of the writer
+        uint64_t count;
+    };
+
+    ReplayDataset() noexcept = default;
+    ~ReplayDataset();
+
+    ReplayDataset(ReplayDataset&& other) noexcept;
+    ReplayDataset& operator=(ReplayDataset&& other) noexcept;
+    ReplayDataset(const ReplayDataset&) = delete;
+    ReplayDataset& operator=(const ReplayDataset&) = delete;
+
+    /// Map a file written by write(). Returns false if missing or malformed.
+    bool open(const std::string& path);
+    void close() noexcept;
+
+    std::span<const MarketDataMessage> events() const noexcept {
+        return {events_, count_};
+    }
+    size_t size() const noexcept { return count_; }
+    bool is_open() const noexcept { return mapping_ != nullptr; }
+
+    /// Write events in replay format.
+    static bool write(const std::string& path, std::span<const MarketDataMessage> events);
+
+private:
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    const MarketDataMessage* events_ = nullptr;
+    size_t count_ = 0;
+};
+
+} // namespace trading
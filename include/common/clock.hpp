@@ -0,0 +1,96 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "common/tsc_clock.hpp"
+
+namespace trading {
+
+/// Per-thread time source for hot-path code (instead of calling now_ns()
+/// directly):
+/// - System: CLOCK_MONOTONIC via now_ns() on every call (default)
+/// - Cached: the value of the last refresh(); an event loop refreshes once per
+///   iteration and every stage of that iteration sees the same "now" for free
+/// - Simulated: time only moves when set/advanced; used by backtests so a
+///   run is a pure function of its input events
+/// - Tsc: calibrated rdtsc (TscClock) on every call
+/// State is thread_local: each thread picks its own mode, and backtest
+/// threads keep independent timelines.
+class ThreadClock {
+public:
+    enum class Mode : uint8_t {
+        System = 0,
+        Cached = 1,
+        Simulated = 2,
+        Tsc = 3
+    };
+
+    static Timestamp now() noexcept {
+        switch (state_.mode) {
+            case Mode::System: return now_ns();
+            case Mode::Tsc: return TscClock::now();
+            default: return state_.now;
+        }
+    }
+
+    /// Re-read the clock in Cached mode (from the TSC once calibrated);
+    /// returns the current now().
+    static Timestamp refresh() noexcept {
+        if (state_.mode == Mode::Cached) state_.now = TscClock::now();
+        return now();
+    }
+
+    static void use_system() noexcept { state_.mode = Mode::System; }
+
+    static void use_cached() noexcept {
+        state_.mode = Mode::Cached;
+        state_.now = TscClock::now();
+    }
+
+    /// Requires TscClock::calibrate() to have succeeded; returns false otherwise.
+    static bool use_tsc() noexcept {
+        if (!TscClock::calibrated()) return false;
+        state_.mode = Mode::Tsc;
+        return true;
+    }
+
+    static void use_simulated(Timestamp start) noexcept {
+        state_.mode = Mode::Simulated;
+        state_.now = start;
+    }
+
+    /// Simulated mode only.
+    static void set(Timestamp t) noexcept { state_.now = t; }
+    static void advance(Timestamp delta) noexcept { state_.now += delta; }
+
+    static Mode mode() noexcept { return state_.mode; }
+
+private:
+    friend class SimulatedClockScope;
+
+    struct State {
+        Mode mode;
+        Timestamp now;
+    };
+
+    static inline thread_local State state_{Mode::System, 0};
+};
+
+/// Puts the calling thread on simulated time for the lifetime of the scope.
+class SimulatedClockScope {
+public:
+    explicit SimulatedClockScope(Timestamp start) noexcept
+        : saved_(ThreadClock::state_)
+    {
+        ThreadClock::use_simulated(start);
+    }
+
+    ~SimulatedClockScope() { ThreadClock::state_ = saved_; }
+
+    SimulatedClockScope(const SimulatedClockScope&) = delete;
+    SimulatedClockScope& operator=(const SimulatedClockScope&) = delete;
+
+private:
+    ThreadClock::State saved_;
+};
+
+} // namespace trading
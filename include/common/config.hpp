@@ -12,6 +12,7 @@ struct ExchangeConfig {
     uint64_t latency_ns = 1000;         // Simulated latency in nanoseconds
     double fill_probability = 0.95;
     bool enabled = true;
+    double taker_fee_bps = 0.0;         // Fee on liquidity taken (BestPrice routing ranks net of it)
 };
 
 struct RiskLimits {
@@ -20,8 +21,12 @@ struct RiskLimits {
     double max_capital = 10'000'000.0;
     Quantity max_order_size = 1000;
     uint32_t max_orders_per_second = 10000;
+    uint32_t max_orders_per_second_per_instrument = 0;  // 0 = no per-instrument bucket
+    uint32_t max_orders_per_second_per_exchange = 0;    // Per request.exchange tag (pre-routing); 0 = off
     double max_price_deviation_pct = 5.0;   // Fat finger: 5% from market
     double max_drawdown_pct = 2.0;          // 2% max drawdown triggers kill switch
+    double max_order_notional = 0.0;        // Dollars per order (MaxNotional check); 0 = off
+    double price_collar_bps = 0.0;          // Price collar vs market (PriceCollar check); 0 = off
 };
 
 struct SystemConfig {
@@ -67,10 +72,19 @@ struct SystemConfig {
 
     // Runtime
     uint64_t simulation_duration_ms = 10000;  // 10 seconds default
+    uint64_t pnl_monitor_interval_us = 1000;  // Drawdown evaluation cadence
     bool enable_logging = true;
 };
 
 SystemConfig load_config(const std::string& path);
 SystemConfig default_config();
 
+/// Overlay the file's values onto config. Returns false if the file cannot
+/// be read or any value fails to parse (config may then be partly updated).
+bool try_load_config(const std::string& path, SystemConfig& config);
+
+/// Sanity check before limits go live: sizes and caps positive, percentages
+/// in (0, 100], nothing NaN. Rate limits, notional cap and collar may be 0 (off).
+bool validate_risk_limits(const RiskLimits& limits) noexcept;
+
 } // namespace trading
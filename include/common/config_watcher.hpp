@@ -0,0 +1,63 @@
+#pragma once
+
+#include "common/config.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace trading {
+
+/// Watches a config file and hands each new version to a callback.
+/// - Change detection by modification time and size (one stat per poll)
+/// - poll() runs synchronously; start() polls on a background thread
+/// - The callback runs on the polling thread and returns false to have the
+///   same change offered again on the next poll (e.g. publish was Busy)
+/// - A file that fails to parse is skipped until it changes again
+/// Not on any hot path: allocation and std::function are fine here.
+class ConfigWatcher {
+public:
+    using Callback = std::function<bool(const SystemConfig&)>;
+
+    /// The file's current state is the baseline: only later edits fire.
+    ConfigWatcher(std::string path, Callback on_change);
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /// Check once; returns true if a new config was delivered and accepted.
+    bool poll();
+
+    void start(std::chrono::milliseconds interval = std::chrono::milliseconds(250));
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+    uint64_t reloads() const noexcept { return reloads_.load(std::memory_order_relaxed); }
+    uint64_t parse_failures() const noexcept { return parse_failures_.load(std::memory_order_relaxed); }
+
+private:
+    struct Stamp {
+        std::filesystem::file_time_type mtime{};
+        uintmax_t size = 0;
+        bool exists = false;
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    Stamp stat() const;
+    void run_loop(std::chrono::milliseconds interval);
+
+    std::string path_;
+    Callback on_change_;
+    Stamp seen_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::atomic<uint64_t> reloads_{0};
+    std::atomic<uint64_t> parse_failures_{0};
+};
+
+} // namespace trading
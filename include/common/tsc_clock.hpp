@@ -0,0 +1,120 @@
+#pragma once
+
+#include "common/types.hpp"
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRADING_HAS_TSC 1
+#else
+#define TRADING_HAS_TSC 0
+#endif
+
+namespace trading {
+
+/// Time stamp counter clock:
+/// - rdtsc for cheap timestamps (a few ns on bare metal vs ~20-40ns for
+///   clock_gettime; under virtualisation the gap narrows)
+/// - Calibrated once at startup against CLOCK_MONOTONIC; cycles convert to
+///   nanoseconds with a fixed-point multiply and shift (no division)
+/// - Only trusted when the CPU reports an invariant TSC (constant rate across
+///   P-states and C-states, synchronised across cores)
+/// Until calibrate() succeeds, now() falls back to now_ns() and cycles are
+/// reported 1:1 as nanoseconds.
+class TscClock {
+public:
+    static constexpr uint32_t SHIFT = 32;
+
+    /// Unserialised read; may be reordered with surrounding loads.
+    static uint64_t rdtsc() noexcept {
+#if TRADING_HAS_TSC
+        return __rdtsc();
+#else
+        return now_ns();
+#endif
+    }
+
+    /// Read for the start of a measured region: earlier instructions retire
+    /// first, later ones do not start before the read.
+    static uint64_t start() noexcept {
+#if TRADING_HAS_TSC
+        _mm_lfence();
+        uint64_t t = __rdtsc();
+        _mm_lfence();
+        return t;
+#else
+        return now_ns();
+#endif
+    }
+
+    /// Read for the end of a measured region: rdtscp waits for the region to
+    /// retire, the fence keeps later instructions out of it.
+    static uint64_t stop() noexcept {
+#if TRADING_HAS_TSC
+        unsigned int aux;
+        uint64_t t = __rdtscp(&aux);
+        _mm_lfence();
+        return t;
+#else
+        return now_ns();
+#endif
+    }
+
+    /// CPUID.80000007H:EDX[8]
+    static bool invariant_tsc() noexcept;
+
+    /// Measure the TSC rate against CLOCK_MONOTONIC over `duration_ns`.
+    /// Returns false (and keeps the fallback) without an invariant TSC.
+    static bool calibrate(uint64_t duration_ns = 20'000'000) noexcept;
+
+    static bool calibrated() noexcept { return calibration_.valid; }
+
+    /// Nanoseconds on the CLOCK_MONOTONIC timeline.
+    static Timestamp now() noexcept {
+        if (!calibration_.valid) return now_ns();
+        return calibration_.base_ns + cycles_to_ns(rdtsc() - calibration_.base_tsc);
+    }
+
+    static uint64_t cycles_to_ns(uint64_t cycles) noexcept {
+        return static_cast<uint64_t>(
+            (static_cast<UInt128>(cycles) * calibration_.mult) >> SHIFT);
+    }
+
+    /// Calibrated TSC frequency (1.0 when uncalibrated).
+    static double ghz() noexcept {
+        return static_cast<double>(1ULL << SHIFT) / static_cast<double>(calibration_.mult);
+    }
+
+private:
+    struct Calibration {
+        uint64_t base_tsc;
+        Timestamp base_ns;
+        uint64_t mult;      // ns per cycle << SHIFT
+        bool valid;
+    };
+
+    // Written once by calibrate() before worker threads start, read-only after
+    static inline Calibration calibration_{0, 0, 1ULL << SHIFT, false};
+};
+
+/// Fenced cycle timer for tiny code regions:
+///     CycleTimer t; t.start(); work(); uint64_t cycles = t.stop();
+class CycleTimer {
+public:
+    void start() noexcept { begin_ = TscClock::start(); }
+
+    /// Cycles since start().
+    uint64_t stop() noexcept {
+        elapsed_ = TscClock::stop() - begin_;
+        return elapsed_;
+    }
+
+    uint64_t cycles() const noexcept { return elapsed_; }
+    uint64_t nanoseconds() const noexcept { return TscClock::cycles_to_ns(elapsed_); }
+
+private:
+    uint64_t begin_ = 0;
+    uint64_t elapsed_ = 0;
+};
+
+} // namespace trading
@@ -12,12 +12,18 @@ using Quantity = uint64_t;
 using OrderId = uint64_t;
 using InstrumentId = uint32_t;
 using ExchangeId = uint8_t;
+using StrategyId = uint8_t;
 using Timestamp = uint64_t;     // Nanoseconds since epoch
 
+// 128-bit intermediates for fixed-point multiply/shift (GCC/Clang extension)
+__extension__ using Int128 = __int128;
+__extension__ using UInt128 = unsigned __int128;
+
 // Constants
 constexpr int PRICE_SCALE = 100;    // 2 decimal places
 constexpr size_t MAX_INSTRUMENTS = 256;
 constexpr size_t MAX_EXCHANGES = 16;
+constexpr size_t MAX_STRATEGIES = 32;
 constexpr size_t CACHE_LINE_SIZE = 64;
 
 // Enums
@@ -33,6 +39,12 @@ enum class OrderType : uint8_t {
     FOK = 3     // Fill or Kill
 };
 
+enum class OrderAction : uint8_t {
+    New = 0,
+    Cancel = 1,     // Cancel orig_id
+    Replace = 2     // Cancel/replace orig_id with id at new price/quantity
+};
+
 enum class OrderStatus : uint8_t {
     New = 0,
     PartiallyFilled = 1,
@@ -87,7 +99,10 @@ struct OrderRequest {
     Price price;
     Quantity quantity;
     ExchangeId exchange;
+    StrategyId strategy = 0;    // Originating strategy (halt scope)
     Timestamp timestamp;
+    OrderAction action = OrderAction::New;
+    OrderId orig_id = 0;        // Target of Cancel/Replace
 };
 
 struct ExecutionReport {
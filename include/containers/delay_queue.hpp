@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace trading {
+
+/// Fixed-capacity timer queue: items become visible once their due time has
+/// passed. Binary min-heap on (due, insertion order), so items due at the
+/// same time come out FIFO.
+/// - push/pop O(log n), peek O(1); storage allocated once at construction
+/// - push returns false when full (caller applies backpressure)
+template<typename T, size_t Capacity>
+class DelayQueue {
+    static_assert(Capacity > 0, "Capacity must be > 0");
+
+public:
+    DelayQueue() : heap_(std::make_unique<Entry[]>(Capacity)) {}
+
+    bool push(uint64_t due, const T& value) noexcept {
+        if (size_ == Capacity) [[unlikely]] return false;
+        size_t i = size_++;
+        Entry entry{due, next_seq_++, value};
+        // Sift up
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!earlier(entry, heap_[parent])) break;
+            heap_[i] = std::move(heap_[parent]);
+            i = parent;
+        }
+        heap_[i] = std::move(entry);
+        return true;
+    }
+
+    /// Earliest item if it is due at `now`, else nullptr
+    const T* peek_due(uint64_t now) const noexcept {
+        return (size_ > 0 && heap_[0].due <= now) ? &heap_[0].value : nullptr;
+    }
+
+    /// Remove the earliest item (queue must not be empty)
+    void pop() noexcept {
+        Entry last = std::move(heap_[--size_]);
+        if (size_ == 0) return;
+        // Sift the last entry down from the root
+        size_t i = 0;
+        for (;;) {
+            size_t child = 2 * i + 1;
+            if (child >= size_) break;
+            if (child + 1 < size_ && earlier(heap_[child + 1], heap_[child])) ++child;
+            if (!earlier(heap_[child], last)) break;
+            heap_[i] = std::move(heap_[child]);
+            i = child;
+        }
+        heap_[i] = std::move(last);
+    }
+
+    /// Due time of the earliest item, max() if empty
+    uint64_t next_due() const noexcept {
+        return size_ > 0 ? heap_[0].due : std::numeric_limits<uint64_t>::max();
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == Capacity; }
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+    void clear() noexcept { size_ = 0; }
+
+private:
+    struct Entry {
+        uint64_t due;
+        uint64_t seq;
+        T value;
+    };
+
+    static bool earlier(const Entry& a, const Entry& b) noexcept {
+        return a.due < b.due || (a.due == b.due && a.seq < b.seq);
+    }
+
+    std::unique_ptr<Entry[]> heap_;
+    size_t size_ = 0;
+    uint64_t next_seq_ = 0;
+};
+
+} // namespace trading
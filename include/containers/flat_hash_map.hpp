@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace trading {
+
+/// Fixed-capacity open-addressing hash map for integer keys (order ids).
+/// - Linear probing over one flat slot array: a lookup touches one or two
+///   cache lines, no per-node allocation
+/// - Fibonacci hashing, so sequential ids spread across the table
+/// - Backward-shift deletion: no tombstones, probe lengths stay short under churn
+/// - Inserts fail (return false) beyond 3/4 load instead of rehashing
+/// Slots are heap-allocated once at construction (not on hot path).
+/// Pointers returned by find() are invalidated by insert() and erase().
+template<typename Key, typename Value, size_t Capacity>
+class FlatHashMap {
+    static_assert(std::is_unsigned_v<Key>, "Key must be an unsigned integer");
+    static_assert(Capacity >= 8 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+public:
+    /// Reserved: cannot be used as a key
+    static constexpr Key EMPTY_KEY = std::numeric_limits<Key>::max();
+    static constexpr size_t MAX_SIZE = Capacity - Capacity / 4;
+
+    FlatHashMap() : slots_(std::make_unique<Slot[]>(Capacity)) {
+        clear();
+    }
+
+    Value* find(Key key) noexcept {
+        for (size_t i = home(key);; i = next(i)) {
+            if (slots_[i].key == key) return &slots_[i].value;
+            if (slots_[i].key == EMPTY_KEY) return nullptr;
+        }
+    }
+
+    const Value* find(Key key) const noexcept {
+        return const_cast<FlatHashMap*>(this)->find(key);
+    }
+
+    /// Insert or overwrite. Returns false if the table is at MAX_SIZE.
+    bool insert(Key key, const Value& value) noexcept {
+        size_t i = home(key);
+        for (; slots_[i].key != EMPTY_KEY; i = next(i)) {
+            if (slots_[i].key == key) {
+                slots_[i].value = value;
+                return true;
+            }
+        }
+        if (size_ >= MAX_SIZE) [[unlikely]] return false;
+        slots_[i].key = key;
+        slots_[i].value = value;
+        ++size_;
+        return true;
+    }
+
+    bool erase(Key key) noexcept {
+        size_t i = home(key);
+        for (; slots_[i].key != key; i = next(i)) {
+            if (slots_[i].key == EMPTY_KEY) return false;
+        }
+
+        // Shift later members of the probe run back into the hole
+        for (size_t j = next(i);; j = next(j)) {
+            if (slots_[j].key == EMPTY_KEY) break;
+            size_t want = home(slots_[j].key);
+            // Move j into the hole unless its home lies cyclically in (i, j]
+            bool stays = (i <= j) ? (i < want && want <= j) : (i < want || want <= j);
+            if (!stays) {
+                slots_[i] = slots_[j];
+                i = j;
+            }
+        }
+        slots_[i].key = EMPTY_KEY;
+        --size_;
+        return true;
+    }
+
+    bool contains(Key key) const noexcept { return find(key) != nullptr; }
+
+    /// Visit every entry in slot order (a full table scan: not for hot paths).
+    /// fn must not insert or erase.
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t i = 0; i < Capacity; ++i) {
+            if (slots_[i].key != EMPTY_KEY) fn(slots_[i].key, slots_[i].value);
+        }
+    }
+
+    void clear() noexcept {
+        for (size_t i = 0; i < Capacity; ++i) slots_[i].key = EMPTY_KEY;
+        size_ = 0;
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+    struct Slot {
+        Key key;
+        Value value;
+    };
+
+    static constexpr unsigned SHIFT = 64 - __builtin_ctzll(Capacity);   // Top log2(Capacity) bits
+
+    static size_t home(Key key) noexcept {
+        return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> SHIFT);
+    }
+    static size_t next(size_t i) noexcept { return (i + 1) & (Capacity - 1); }
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t size_ = 0;
+};
+
+} // namespace trading
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace trading {
+
+/// Single-writer sequence lock for publishing a small POD snapshot.
+/// - The writer never blocks or waits: bump the sequence to odd, copy, bump
+///   to even
+/// - Readers copy optimistically and retry if the sequence was odd or moved,
+///   so they always see one complete write, never a mix of two
+/// - The payload lives in relaxed atomic words, so the racy copy a reader may
+///   discard is still well-defined
+/// Meant for a hot-path writer and a slow-cadence reader (monitoring core).
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+public:
+    SeqLock() noexcept {
+        std::array<uint64_t, WORDS> buffer{};
+        T initial{};
+        std::memcpy(buffer.data(), &initial, sizeof(T));
+        for (size_t i = 0; i < WORDS; ++i) words_[i].store(buffer[i], std::memory_order_relaxed);
+    }
+
+    /// Writer thread only
+    void store(const T& value) noexcept {
+        std::array<uint64_t, WORDS> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) words_[i].store(buffer[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /// One attempt; false if a write was in progress or landed during the copy
+    bool try_load(T& out) const noexcept {
+        uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+
+        std::array<uint64_t, WORDS> buffer;
+        for (size_t i = 0; i < WORDS; ++i) buffer[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before) return false;
+
+        std::memcpy(&out, buffer.data(), sizeof(T));
+        return true;
+    }
+
+    /// Spin until a consistent copy is read
+    T load() const noexcept {
+        T value;
+        while (!try_load(value)) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        return value;
+    }
+
+    /// Number of completed writes
+    uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> seq_{0};
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+};
+
+} // namespace trading
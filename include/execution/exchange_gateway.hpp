@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common/config.hpp"
+#include "execution/exchange_simulator.hpp"
+#include "execution/fix_session.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace trading {
+
+/// A simulated exchange behind a real socket: accepts one FIX client at a
+/// time on 127.0.0.1 and runs its orders through an ExchangeSimulator.
+/// - NewOrderSingle (D), OrderCancelRequest (F) and OrderCancelReplaceRequest
+///   (G) in; ExecutionReport (8) out, one per request
+/// - Reports for one read's worth of requests go out in one batched write
+/// - The socket round trip replaces the simulator's configured latency, which
+///   only shows in the simulator's own report timestamps
+/// Symbol (55) carries the numeric InstrumentId; OrderID (37) the id the
+/// report is about (the original order for a cancel).
+class ExchangeGateway {
+public:
+    explicit ExchangeGateway(const ExchangeConfig& config);
+    ~ExchangeGateway();
+
+    ExchangeGateway(const ExchangeGateway&) = delete;
+    ExchangeGateway& operator=(const ExchangeGateway&) = delete;
+
+    /// Bind and listen on 127.0.0.1:port (0 = any free port). Returns false on failure.
+    bool listen(uint16_t port = 0);
+    uint16_t port() const noexcept { return port_; }
+
+    /// Serve on a background thread pinned to core_id (after listen())
+    void start(int core_id);
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+    /// Call before start()
+    ExchangeSimulator& exchange() noexcept { return exchange_; }
+
+    uint64_t orders_received() const noexcept { return orders_received_.load(std::memory_order_relaxed); }
+    uint64_t sessions_accepted() const noexcept { return sessions_accepted_.load(std::memory_order_relaxed); }
+
+private:
+    void run_loop(int core_id);
+    void on_message(const FixParser& message);
+    void send_report(const ExecutionReport& report, OrderId cl_ord_id);
+
+    ExchangeSimulator exchange_;
+    FixSession session_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::atomic<uint64_t> orders_received_{0};
+    std::atomic<uint64_t> sessions_accepted_{0};
+};
+
+} // namespace trading
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/types.hpp"
+#include "common/clock.hpp"
 #include "common/config.hpp"
 #include "order_book/order_book.hpp"
 #include <random>
@@ -19,9 +20,19 @@ public:
     /// Cancel an order. Returns execution report.
     ExecutionReport cancel_order(OrderId order_id);
 
+    /// Cancel/replace: pulls request.orig_id and submits request.id in its place.
+    /// Rejected if the original is no longer resting.
+    ExecutionReport replace_order(const OrderRequest& request);
+
     /// Seed the book with resting orders for realistic simulation.
     void seed_book(Price mid_price, int levels, Quantity qty_per_level);
 
+    /// Top `levels` price levels of one side of the book, best first.
+    /// Returns the number filled. No allocation.
+    size_t depth(Side side, OrderBook::DepthEntry* entries, size_t levels) const {
+        return book_.get_side_depth(side, entries, levels);
+    }
+
     /// Update the book with a market data message (for price tracking).
     void update_book(const MarketDataMessage& md);
 
@@ -30,6 +41,9 @@ public:
     uint64_t orders_processed() const noexcept { return orders_processed_; }
     uint64_t fills() const noexcept { return fills_; }
     uint64_t rejects() const noexcept { return rejects_; }
+    /// Sum of trade price x quantity of the last submit/replace (0 without
+    /// fills). Its report carries the last trade's price only.
+    Price last_fill_notional() const noexcept { return last_fill_notional_; }
 
 private:
     ExchangeConfig config_;
@@ -39,6 +53,7 @@ private:
     uint64_t orders_processed_ = 0;
     uint64_t fills_ = 0;
     uint64_t rejects_ = 0;
+    Price last_fill_notional_ = 0;
 };
 
 } // namespace trading
@@ -2,9 +2,16 @@
 
 #include "common/types.hpp"
 #include "common/config.hpp"
+#include "containers/delay_queue.hpp"
+#include "containers/flat_hash_map.hpp"
 #include "containers/lock_free_queue.hpp"
 #include "execution/exchange_simulator.hpp"
+#include "execution/gateway_transport.hpp"
+#include "execution/order_manager.hpp"
 #include "execution/order_router.hpp"
+#include "monitoring/histogram.hpp"
+#include "risk/kill_switch.hpp"
+#include "risk/rate_limiter.hpp"
 #include <atomic>
 #include <thread>
 #include <vector>
@@ -15,9 +22,29 @@ namespace trading {
 /// Execution Engine: consumes OrderRequest from input queue,
 /// routes to exchanges, produces ExecutionReport on output queue.
 /// Includes order state machine and rate limiting.
+///
+/// Every order sent is tracked by an OrderManager (PendingNew on send), and
+/// each report passes through it before it is published: duplicate and
+/// out-of-order reports are dropped, fills are published as increments, and
+/// the children of a split order are sent as separate venue orders whose
+/// reports arrive on their own venue's latency and roll up into the parent.
+///
+/// Event-driven: the engine thread sends orders without waiting for them.
+/// - send_order() routes the order, records it in the in-flight table and
+///   schedules the venue's report in a delay queue, due after that venue's
+///   latency (ExchangeConfig::latency_ns)
+/// - deliver_reports() publishes reports whose due time has passed and feeds
+///   each venue report's round trip and outcome to the router's estimators
+/// - Up to MAX_IN_FLIGHT orders are outstanding at once; beyond that the
+///   input queue backs up
+/// With a GatewayTransport attached, orders leave over a FIX session instead
+/// of going to the in-process simulators, and reports come back off the wire.
 class ExecutionEngine {
 public:
     static constexpr size_t QUEUE_CAPACITY = 65536;
+    static constexpr size_t MAX_IN_FLIGHT = 1 << 14;
+    /// Resting orders cancel-on-halt can track; beyond that new orders are refused
+    static constexpr size_t MAX_WORKING_ORDERS = 3 << 14;
 
     using InputQueue = LockFreeRingBuffer<OrderRequest, QUEUE_CAPACITY>;
     using OutputQueue = LockFreeRingBuffer<ExecutionReport, QUEUE_CAPACITY>;
@@ -27,29 +54,151 @@ public:
     /// Add an exchange simulator
     void add_exchange(const ExchangeConfig& config);
 
-    /// Set order rate limit (orders per second)
-    void set_rate_limit(uint32_t max_orders_per_sec) { max_orders_per_sec_ = max_orders_per_sec; }
+    /// Set order rate limit (orders per second, burst of one second's worth)
+    void set_rate_limit(uint32_t max_orders_per_sec) {
+        rate_limiter_.set_limit(RateLimiter::Scope::Global, max_orders_per_sec);
+    }
+
+    /// Per-instrument buckets, charged on admission, and per-exchange
+    /// buckets, charged for the venue each order (each sweep child) is
+    /// actually sent to; a venue over its rate is routed around
+    RateLimiter& rate_limiter() noexcept { return rate_limiter_; }
+
+    /// Cancel-on-halt: reject new orders in halted scopes and, once per
+    /// halt, cancel working orders that the halt covers. The switch is polled
+    /// from the engine thread (one load per loop); nullptr disables.
+    /// Attach before start(): only orders routed afterwards are tracked.
+    void set_kill_switch(const KillSwitch* halts) noexcept {
+        halts_ = halts;
+        halt_generation_ = halts ? halts->generation() : 0;
+    }
+
+    /// Cancel working orders blocked by the current halts; the cancel
+    /// reports are delivered like any other. Cancels only as many as the
+    /// report queue has room for; the rest wait for a later call (the engine
+    /// loop keeps calling until none are left). Returns the number cancelled.
+    /// Called by the engine loop when the halt generation moves.
+    size_t cancel_halted_orders();
+    bool halt_cancels_pending() const noexcept { return halt_cancel_backlog_; }
+
+    /// Orders resting on an exchange, as seen through the engine's reports
+    /// (tracked only while a kill switch is attached)
+    size_t working_order_count() const noexcept { return working_.size(); }
+    /// Orders refused (or left untracked) because the working-order table was full
+    uint64_t working_overflows() const noexcept { return working_overflows_; }
+
+    /// Send orders over the wire instead of to the in-process exchanges
+    /// (nullptr reverts). The transport must be connected, and is driven from
+    /// the engine thread from then on. Cancel-on-halt still walks the
+    /// in-process books only.
+    void set_transport(GatewayTransport* transport) noexcept { transport_ = transport; }
 
     /// Set routing strategy
     void set_routing_strategy(OrderRouter::RoutingStrategy strategy);
 
-    /// Process a single order (non-threaded, for testing)
+    /// Process a single order synchronously: the report is returned at once,
+    /// latency only shows in its timestamp (non-threaded, for testing)
     ExecutionReport process_order(const OrderRequest& request);
 
+    /// Send an order asynchronously; its report is delivered by a later
+    /// deliver_reports() once the venue latency has elapsed. Returns false
+    /// (nothing sent) if MAX_IN_FLIGHT orders are already outstanding.
+    bool send_order(const OrderRequest& request);
+
+    /// Push every report due at `now` to the output queue, in due order.
+    /// Stops early if the output queue is full. Returns the number delivered.
+    size_t deliver_reports(Timestamp now);
+
+    /// In-flight table: orders sent whose report has not been delivered
+    size_t in_flight() const noexcept { return in_flight_.size(); }
+    bool is_in_flight(OrderId id) const noexcept { return in_flight_.contains(id); }
+    Timestamp next_report_due() const noexcept { return pending_reports_.next_due(); }
+
+    /// Send-to-due time of async orders (the modelled venue round trip)
+    const Histogram& round_trip_histogram() const noexcept { return round_trip_; }
+    uint64_t round_trip_count() const noexcept { return round_trip_count_; }
+    double mean_round_trip_ns() const noexcept {
+        return round_trip_count_ ? static_cast<double>(round_trip_total_ns_) / static_cast<double>(round_trip_count_) : 0.0;
+    }
+    size_t peak_in_flight() const noexcept { return peak_in_flight_; }
+
+    /// Router (per-venue latency and fill-rate estimates)
+    const OrderRouter& router() const noexcept { return router_; }
+
+    /// Live orders and their states (send_order() path)
+    const OrderManager& orders() const noexcept { return orders_; }
+    /// Reports dropped as duplicate, stale, or absorbed into a parent, and
+    /// reports the consumer left no room for at shutdown
+    uint64_t reports_dropped() const noexcept { return reports_dropped_; }
+    /// Reports lost to a full report queue (zero unless a bound is broken)
+    uint64_t reports_overflowed() const noexcept { return reports_overflowed_; }
+
     /// Start engine thread pinned to core_id
     void start(int core_id);
     void stop();
 
     bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
     uint64_t orders_processed() const noexcept { return orders_processed_; }
-    uint64_t orders_throttled() const noexcept { return orders_throttled_; }
+    uint64_t orders_throttled() const noexcept { return orders_throttled_ + router_.venue_throttled(); }
+    uint64_t orders_halted() const noexcept { return orders_halted_; }
+    uint64_t halt_cancels() const noexcept { return halt_cancels_; }
 
     /// Seed all exchange books
     void seed_books(Price mid_price, int levels, Quantity qty_per_level);
 
 private:
+    /// What cancel-on-halt needs to know about a resting order
+    struct WorkingOrder {
+        InstrumentId instrument;
+        Side side;
+        ExchangeId exchange;        // Venue it was routed to
+        StrategyId strategy;
+    };
+
+    /// An order's report waiting out the venue latency
+    struct PendingReport {
+        ExecutionReport report;
+        OrderId request_id;         // Differs from report.order_id for cancels and children
+        OrderAction action;         // Of the request it answers
+        bool managed;               // Passes through orders_ and in_flight_ (not a reject of an untracked id)
+    };
+
+    /// In-flight table entry
+    struct InFlight {
+        Timestamp sent;
+        OrderAction action;
+        uint16_t outstanding;       // Reports still to deliver (one per child of a split order)
+    };
+
+    /// Reports one transport poll can decode: a receive buffer of the
+    /// smallest sequenced message ("8=FIX.4.4|9=N|35=8|34=N|10=NNN|")
+    static constexpr size_t REPORTS_PER_POLL = FixSession::RECV_BUFFER_SIZE / 32;
+    /// Room for every in-flight order's reports, one split order's, and one
+    /// transport poll's. Halt cancels take what is left.
+    static constexpr size_t PENDING_CAPACITY = MAX_IN_FLIGHT + MAX_EXCHANGES + REPORTS_PER_POLL;
+    /// How long shutdown waits for the gateway to answer, and for the
+    /// consumer to make room for the last reports
+    static constexpr Timestamp SHUTDOWN_GRACE_NS = 100'000'000;
+
     void run_loop(int core_id);
-    bool check_rate_limit();
+    void poll_transport(Timestamp now);
+    void flush_reports();
+    bool admit(const OrderRequest& request) noexcept;
+    ExecutionReport reject(const OrderRequest& request) const noexcept;
+    ExecutionReport route(const OrderRequest& request, OrderRouter::ChildReports* children);
+    bool schedule(const ExecutionReport& report, OrderId request_id, OrderAction action, Timestamp now,
+                  bool managed = true);
+    size_t pending_room() const noexcept { return PENDING_CAPACITY - pending_reports_.size(); }
+    bool can_send() const noexcept {
+        return in_flight_.size() < MAX_IN_FLIGHT && pending_reports_.size() <= MAX_IN_FLIGHT;
+    }
+    void track(const OrderRequest& request, const ExecutionReport& report) noexcept;
+    void poll_halts() {
+        if (halts_ && (halts_->generation() != halt_generation_ || halt_cancel_backlog_)) [[unlikely]] {
+            halt_generation_ = halts_->generation();
+            cancel_halted_orders();
+        }
+    }
 
     InputQueue& input_;
     OutputQueue& output_;
@@ -58,13 +207,33 @@ private:
     std::atomic<bool> running_{false};
     std::thread thread_;
 
-    uint32_t max_orders_per_sec_ = 10000;
     uint64_t orders_processed_ = 0;
     uint64_t orders_throttled_ = 0;
-
-    // Rate limiter state
-    Timestamp rate_window_start_ = 0;
-    uint32_t orders_in_window_ = 0;
+    uint64_t orders_halted_ = 0;
+    uint64_t halt_cancels_ = 0;
+
+    RateLimiter rate_limiter_;
+    GatewayTransport* transport_ = nullptr;
+
+    const KillSwitch* halts_ = nullptr;
+    uint64_t halt_generation_ = 0;
+    bool halt_cancel_backlog_ = false;     // Halted orders left for the next loop
+    FlatHashMap<OrderId, WorkingOrder, 1 << 16> working_;
+    static_assert(decltype(working_)::MAX_SIZE == MAX_WORKING_ORDERS);
+    uint64_t working_overflows_ = 0;
+    std::vector<OrderId> cancel_scratch_;
+
+    DelayQueue<PendingReport, PENDING_CAPACITY> pending_reports_;
+    FlatHashMap<OrderId, InFlight, 2 * MAX_IN_FLIGHT> in_flight_;
+    Histogram round_trip_;
+    uint64_t round_trip_count_ = 0;
+    uint64_t round_trip_total_ns_ = 0;
+    size_t peak_in_flight_ = 0;
+
+    OrderManager orders_;
+    OrderRouter::ChildReports child_reports_;
+    uint64_t reports_dropped_ = 0;
+    uint64_t reports_overflowed_ = 0;
 };
 
 } // namespace trading
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "execution/fix_session.hpp"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace trading {
+
+/// Renders OrderRequests as NewOrderSingle (D), OrderCancelRequest (F) and
+/// OrderCancelReplaceRequest (G) without formatting whole messages.
+/// - One template per message type, rendered once per session (comp ids
+///   baked in) with every variable field at a fixed width and offset, so
+///   BodyLength is a constant of the template
+/// - encode() copies the template and overwrites only the variable fields:
+///   MsgSeqNum, SendingTime/TransactTime, ClOrdID (+OrigClOrdID), Symbol,
+///   Side, OrderQty, OrdType, Price, TimeInForce
+/// - SendingTime/TransactTime follow the thread's ThreadClock (cached on the
+///   engine thread), so the hot path makes no clock syscall
+/// - CheckSum starts from the template's precomputed sum of the fixed bytes
+///   and adds each field's bytes as they are written
+/// Numbers are zero-padded (FIX allows leading zeros in numeric fields):
+/// ClOrdID 20 digits, MsgSeqNum 20, Symbol 10, OrderQty 12, Price 10.2.
+/// ClOrdID, MsgSeqNum and Symbol hold any value of their type; an order
+/// whose OrderQty or Price does not fit, or whose price is negative, is not
+/// encoded (encode() returns 0). Market orders carry Price 0.
+class FixOrderEncoder {
+public:
+    static constexpr size_t MAX_MESSAGE_SIZE = 256;
+
+    FixOrderEncoder(std::string_view sender_comp_id, std::string_view target_comp_id);
+
+    /// Render request (New -> D, Cancel -> F, Replace -> G) with MsgSeqNum
+    /// seq_num into out, which must hold MAX_MESSAGE_SIZE bytes. Returns the
+    /// length, or 0 (nothing usable written) if the order cannot be rendered.
+    size_t encode(const OrderRequest& request, uint64_t seq_num, char* out) noexcept;
+
+    /// Template for an action as rendered at construction
+    std::string_view message_template(OrderAction action) const noexcept {
+        const Template& t = templates_[static_cast<size_t>(action)];
+        return std::string_view(t.bytes.data(), t.length);
+    }
+
+private:
+    static constexpr uint16_t ABSENT = 0;   // Offset 0 is "8=", never a variable field
+
+    /// Offsets are of each field's first value byte
+    struct Template {
+        std::array<char, MAX_MESSAGE_SIZE> bytes{};
+        uint16_t length = 0;
+        uint32_t fixed_sum = 0;     // Checksum base: zero-padded digits included, timestamps and chars not
+        uint16_t seq_num = ABSENT;
+        uint16_t sending_time = ABSENT;
+        uint16_t transact_time = ABSENT;
+        uint16_t cl_ord_id = ABSENT;
+        uint16_t orig_cl_ord_id = ABSENT;
+        uint16_t symbol = ABSENT;
+        uint16_t side = ABSENT;
+        uint16_t quantity = ABSENT;
+        uint16_t ord_type = ABSENT;
+        uint16_t price = ABSENT;
+        uint16_t time_in_force = ABSENT;
+        uint16_t checksum = ABSENT;
+    };
+
+    static Template build(OrderAction action, std::string_view sender, std::string_view target);
+
+    std::array<Template, 3> templates_;     // Indexed by OrderAction
+    UtcTimestamp clock_;
+};
+
+} // namespace trading
@@ -0,0 +1,243 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "market_data/fix_parser.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <sys/uio.h>
+
+namespace trading {
+
+/// OrdStatus (39) / ExecType (150) code for an order status
+constexpr char to_fix_status(OrderStatus status) noexcept {
+    switch (status) {
+        case OrderStatus::New: return '0';
+        case OrderStatus::PartiallyFilled: return '1';
+        case OrderStatus::Filled: return '2';
+        case OrderStatus::Cancelled: return '4';
+        default: return '8';
+    }
+}
+
+constexpr OrderStatus from_fix_status(char code) noexcept {
+    switch (code) {
+        case '0': return OrderStatus::New;
+        case '1': return OrderStatus::PartiallyFilled;
+        case '2': return OrderStatus::Filled;
+        case '4': return OrderStatus::Cancelled;
+        default: return OrderStatus::Rejected;
+    }
+}
+
+/// UTCTimestamp "YYYYMMDD-HH:MM:SS.mmm" for SendingTime (52) / TransactTime
+/// (60), driven by the caller's ThreadClock reading (free in cached mode).
+/// Wall time is that reading plus an offset resampled from CLOCK_REALTIME
+/// once per second of clock time; the text is only touched when the
+/// millisecond changes, the date-time part only when the second does.
+/// Also keeps the byte sum of the text, for callers that checksum incrementally.
+class UtcTimestamp {
+public:
+    static constexpr size_t SIZE = 21;
+
+    std::string_view update(Timestamp now) noexcept;
+
+    std::string_view text() const noexcept { return std::string_view(text_.data(), SIZE); }
+    uint32_t byte_sum() const noexcept { return byte_sum_; }
+
+private:
+    std::array<char, SIZE> text_{};
+    int64_t wall_offset_ = 0;           // CLOCK_REALTIME minus clock reading
+    Timestamp next_sample_ = 0;         // Clock reading at which to resample it
+    uint64_t millisecond_ = UINT64_MAX;
+    uint64_t second_ = UINT64_MAX;
+    uint32_t second_sum_ = 0;   // Bytes up to and including the '.'
+    uint32_t byte_sum_ = 0;
+};
+
+/// FIX 4.4 session layer over a connected stream socket (one per peer).
+/// - Framing: BeginString (8) / BodyLength (9) / CheckSum (10), verified on
+///   receipt; a message split across reads waits for the rest
+/// - MsgSeqNum (34) stamped on send; inbound duplicates (seq below expected)
+///   are dropped, gaps are counted and skipped (no resend: nothing is stored)
+/// - Logon (A), Heartbeat (0), TestRequest (1) and Logout (5) are handled
+///   here; application messages go to the poll() callback
+/// - Outbound messages are built in place in preallocated slots and leave in
+///   one writev() per flush(); inbound bytes land in one fixed buffer
+/// - flush() never waits on the socket: what the kernel does not take stays
+///   queued for the next flush(). With all MAX_BATCH slots still unsent, new
+///   messages are refused until the peer reads
+/// Fields are delimited by FixParser::DELIMITER ('|') instead of SOH, so
+/// captures stay readable; both ends of the simulator agree on it.
+/// Single-threaded: the owning thread sends, polls and services the session.
+class FixSession {
+public:
+    enum class State : uint8_t {
+        Disconnected = 0,   // No socket
+        Connected = 1,      // Socket attached, no Logon yet
+        LogonSent = 2,      // Initiator waiting for the Logon reply
+        Active = 3,
+        Closed = 4          // Logout, timeout, peer gone or framing error
+    };
+
+    static constexpr size_t MAX_MESSAGE_SIZE = 512;
+    static constexpr size_t MAX_BATCH = 64;             // Messages per writev()
+    static constexpr size_t RECV_BUFFER_SIZE = 64 * 1024;
+
+    /// Builds one outbound message body in its send slot. Obtained from
+    /// begin(), finished by send(); nothing is written to the socket until
+    /// flush(). Fields that do not fit mark the message bad and send() drops it.
+    class Writer {
+    public:
+        Writer& field(int tag, std::string_view value) noexcept;
+        Writer& field(int tag, uint64_t value) noexcept;
+        Writer& field(int tag, char value) noexcept;
+        Writer& price(int tag, Price value) noexcept;  // PRICE_SCALE fixed point
+
+        bool ok() const noexcept { return ok_; }
+
+    private:
+        friend class FixSession;
+        Writer(char* begin, char* end) noexcept : pos_(begin), end_(end) {}
+
+        void put(std::string_view s) noexcept;
+        void put(uint64_t value) noexcept;
+        void put(char c) noexcept;
+
+        char* pos_;
+        char* end_;
+        bool ok_ = true;
+    };
+
+    FixSession(std::string_view sender_comp_id, std::string_view target_comp_id);
+    ~FixSession();
+
+    FixSession(const FixSession&) = delete;
+    FixSession& operator=(const FixSession&) = delete;
+
+    /// Take ownership of a connected socket (made non-blocking, TCP_NODELAY
+    /// where applicable) and reset sequence numbers for a new session.
+    void attach(int fd) noexcept;
+    void close() noexcept;
+
+    /// Initiator: send Logon with the given heartbeat interval (HeartBtInt)
+    bool logon(uint32_t heartbeat_interval_s) noexcept;
+    /// Send Logout; the session closes once the peer answers (or now, if closed)
+    void logout() noexcept;
+
+    /// Start a message of type msg_type with the standard header filled in;
+    /// flushes first if MAX_BATCH messages are already queued
+    Writer begin(std::string_view msg_type) noexcept;
+    /// Queue a finished message. Returns false (nothing queued) if the writer
+    /// overflowed, the socket is gone or every slot is still unsent.
+    bool send(Writer& writer) noexcept;
+
+    /// Queue a complete message rendered elsewhere (e.g. by FixOrderEncoder)
+    /// straight into the next send slot. render(char* out, uint64_t seq_num)
+    /// writes at most MAX_MESSAGE_SIZE bytes and returns the length, 0 to drop.
+    template<typename Render>
+    bool send_rendered(Render&& render) {
+        if (queued_ == MAX_BATCH) flush();
+        if (fd_ < 0 || queued_ == MAX_BATCH) [[unlikely]] return false;
+        char* slot = slots_.get() + queued_ * MAX_MESSAGE_SIZE;
+        size_t length = render(slot, next_out_seq_);
+        if (length == 0) [[unlikely]] return false;
+        iov_[queued_] = iovec{slot, length};
+        ++queued_;
+        ++next_out_seq_;
+        ++messages_sent_;
+        return true;
+    }
+    /// Write every queued message with one writev(), without blocking.
+    /// Returns false if anything is left: the socket failed (closed), or
+    /// its send buffer is full and the unsent tail waits for the next call.
+    bool flush() noexcept;
+    /// Queued bytes the socket has not taken yet
+    bool write_pending() const noexcept { return queued_ != 0; }
+
+    /// Read what the socket has, run session messages, and hand each
+    /// in-sequence application message to fn(const FixParser&). The parser's
+    /// views are valid only during the call. Returns the number handed out.
+    template<typename Fn>
+    size_t poll(Fn&& fn) {
+        receive();
+        size_t delivered = 0;
+        while (next_application_message()) {
+            fn(static_cast<const FixParser&>(parser_));
+            ++delivered;
+        }
+        compact();
+        return delivered;
+    }
+
+    /// Heartbeat after an idle interval; TestRequest when the peer has been
+    /// silent for 1.5 intervals; close after 3. Call every loop or so.
+    void service(Timestamp now) noexcept;
+
+    State state() const noexcept { return state_; }
+    bool active() const noexcept { return state_ == State::Active; }
+    int fd() const noexcept { return fd_; }
+
+    uint64_t next_outbound_seq() const noexcept { return next_out_seq_; }
+    uint64_t next_inbound_seq() const noexcept { return next_in_seq_; }
+    Timestamp heartbeat_interval_ns() const noexcept { return heartbeat_ns_; }
+
+    uint64_t messages_sent() const noexcept { return messages_sent_; }
+    uint64_t messages_received() const noexcept { return messages_received_; }
+    uint64_t writev_calls() const noexcept { return writev_calls_; }
+    uint64_t send_stalls() const noexcept { return send_stalls_; }     // Flushes cut short by a full send buffer
+    uint64_t sequence_gaps() const noexcept { return sequence_gaps_; }
+    uint64_t duplicates() const noexcept { return duplicates_; }
+    uint64_t checksum_errors() const noexcept { return checksum_errors_; }
+
+private:
+    static constexpr size_t MAX_COMP_ID = 16;
+    static constexpr size_t HEADER_RESERVE = 24;    // "8=FIX.4.4|9=NNNN|" goes in front of the body
+    static constexpr size_t TRAILER_SIZE = 7;       // "10=NNN|"
+
+    void receive() noexcept;
+    bool next_application_message() noexcept;
+    bool handle_session_message(std::string_view msg_type) noexcept;
+    void send_session_message(std::string_view msg_type, int tag = 0, std::string_view value = {}) noexcept;
+    void compact() noexcept;
+
+    int fd_ = -1;
+    State state_ = State::Disconnected;
+    std::array<char, MAX_COMP_ID> sender_{};
+    std::array<char, MAX_COMP_ID> target_{};
+    size_t sender_len_ = 0;
+    size_t target_len_ = 0;
+
+    uint64_t next_out_seq_ = 1;
+    uint64_t next_in_seq_ = 1;
+    Timestamp heartbeat_ns_ = 30'000'000'000ULL;
+    Timestamp last_sent_ = 0;
+    Timestamp last_received_ = 0;
+    bool test_request_pending_ = false;
+    bool logout_sent_ = false;
+
+    UtcTimestamp sending_time_;
+
+    // Outbound: one slot per queued message
+    std::unique_ptr<char[]> slots_;
+    std::array<iovec, MAX_BATCH> iov_{};
+    size_t queued_ = 0;
+    size_t unsent_ = 0;         // First iov_ entry not fully written
+
+    // Inbound
+    std::unique_ptr<char[]> recv_buffer_;
+    size_t recv_begin_ = 0;     // First unconsumed byte
+    size_t recv_end_ = 0;
+    FixParser parser_;
+
+    uint64_t messages_sent_ = 0;
+    uint64_t messages_received_ = 0;
+    uint64_t writev_calls_ = 0;
+    uint64_t send_stalls_ = 0;
+    uint64_t sequence_gaps_ = 0;
+    uint64_t duplicates_ = 0;
+    uint64_t checksum_errors_ = 0;
+};
+
+} // namespace trading
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "execution/fix_order_encoder.hpp"
+#include "execution/fix_session.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace trading {
+
+/// Client end of an ExchangeGateway: carries orders over a FIX session.
+/// - connect() opens the TCP connection and completes the Logon handshake
+/// - send_order() renders D/F/G from pre-rendered templates straight into
+///   the session's send slots; flush() writes everything queued in one call
+/// - poll_reports() decodes inbound ExecutionReports and hands each to
+///   fn(const ExecutionReport&, OrderId cl_ord_id), cl_ord_id being the id
+///   of the request it answers
+/// Owned and driven by one thread (the execution engine's).
+class GatewayTransport {
+public:
+    explicit GatewayTransport(ExchangeId exchange,
+                              std::string_view sender_comp_id = "CLIENT",
+                              std::string_view target_comp_id = "EXCHANGE");
+
+    /// Connect to 127.0.0.1:port and log on. Returns false if the gateway
+    /// does not answer the Logon within the timeout.
+    bool connect(uint16_t port,
+                 std::chrono::milliseconds timeout = std::chrono::milliseconds(1000),
+                 uint32_t heartbeat_interval_s = 30);
+    void disconnect() noexcept;
+    bool connected() const noexcept { return session_.active(); }
+
+    /// Queue an order (New, Cancel or Replace). False if not logged on, or
+    /// if the encoder refuses it (FixOrderEncoder::encode() returned 0).
+    bool send_order(const OrderRequest& request) noexcept;
+    bool flush() noexcept { return session_.flush(); }
+
+    template<typename Fn>
+    size_t poll_reports(Fn&& fn) {
+        size_t reports = 0;
+        session_.poll([&](const FixParser& message) {
+            if (message.msg_type() != "8") return;
+            OrderId cl_ord_id = 0;
+            ExecutionReport report = decode_report(message, cl_ord_id);
+            fn(static_cast<const ExecutionReport&>(report), cl_ord_id);
+            ++reports;
+        });
+        return reports;
+    }
+
+    /// Heartbeats / liveness; call from the owning loop
+    void service(Timestamp now) noexcept { session_.service(now); }
+
+    ExchangeId exchange() const noexcept { return exchange_; }
+    const FixSession& session() const noexcept { return session_; }
+
+private:
+    ExecutionReport decode_report(const FixParser& message, OrderId& cl_ord_id) const noexcept;
+
+    static_assert(FixOrderEncoder::MAX_MESSAGE_SIZE <= FixSession::MAX_MESSAGE_SIZE);
+
+    ExchangeId exchange_;
+    FixSession session_;
+    FixOrderEncoder encoder_;
+};
+
+} // namespace trading
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "containers/flat_hash_map.hpp"
+#include "containers/memory_pool.hpp"
+#include <array>
+#include <cstdint>
+
+namespace trading {
+
+enum class OrderState : uint8_t {
+    PendingNew = 0,     // Sent, not acknowledged yet
+    New = 1,
+    PartiallyFilled = 2,
+    Filled = 3,
+    Cancelled = 4,
+    Rejected = 5
+};
+
+constexpr bool is_terminal(OrderState state) noexcept {
+    return state >= OrderState::Filled;
+}
+
+/// One live order. Parents are what strategies sent; children are the venue
+/// orders a parent was split into (BestPrice sweeps), linked from the parent.
+struct ManagedOrder {
+    OrderId id;
+    OrderId parent;             // 0 for a parent
+    OrderId replaces;           // Original of a Replace, 0 otherwise
+    ManagedOrder* first_child;
+    ManagedOrder* next_sibling;
+    InstrumentId instrument;
+    Side side;
+    OrderType type;
+    OrderState state;
+    bool replaced;              // Pulled by a Replace; open only for reports still in flight
+    ExchangeId exchange;
+    StrategyId strategy;
+    uint16_t children;
+    uint16_t open_children;     // Children not yet terminal
+    uint16_t rejected_children;
+    Price price;
+    Quantity quantity;
+    Quantity filled;            // Cumulative
+    int64_t fill_notional;      // Sum of fill quantity x price (PRICE_SCALE units)
+    OrderId last_exec_id;
+
+    Quantity leaves() const noexcept { return is_terminal(state) ? 0 : quantity - filled; }
+    Price average_price() const noexcept {
+        return filled ? fill_notional / static_cast<int64_t>(filled) : 0;
+    }
+};
+
+/// Order state machine for the execution engine's live orders.
+/// - Orders live in a MemoryPool, found by id through a FlatHashMap: O(1)
+///   lookup, nothing allocated after construction
+/// - PendingNew on send; reports move an order forward only:
+///   PendingNew -> New -> PartiallyFilled -> Filled / Cancelled / Rejected
+///   (steps may be skipped, e.g. a fill before the ack)
+/// - Reports carry the cumulative filled quantity (FIX CumQty). One that
+///   repeats the last exec id, or the current state and fill, is a duplicate;
+///   one behind the order (less filled, or an earlier state) is stale. Both
+///   are dropped. Reports for recently closed orders are duplicates too
+/// - Published reports carry the quantity newly filled by that report, so
+///   consumers (positions, strategies) never count a fill twice
+/// - A child's fills and terminal state roll up into its parent, which is
+///   what gets published. Children are released with their parent
+/// - Terminal orders are released at once; their ids go to a direct-mapped
+///   cache of recently closed ids for duplicate detection
+/// - A Replace's first report pulls the original. Whatever of the original
+///   has not reported yet (itself, or children still PendingNew) stays open
+///   until its in-flight report lands, so fills that report carries are
+///   still applied and published; it then ends Cancelled (or Filled)
+/// IOC, FOK and market orders are terminal on their first execution report
+/// other than a New ack (the venue does not rest them).
+class OrderManager {
+public:
+    static constexpr size_t MAX_ORDERS = 1 << 16;
+    static constexpr size_t CLOSED_CACHE_SIZE = 1 << 12;
+
+    enum class ReportResult : uint8_t {
+        Applied,        // State or fill advanced: publish
+        Absorbed,       // Child update with nothing new for the parent: drop
+        Untracked,      // Not a transition of a live order (unknown id, rejected cancel): publish as is
+        Duplicate,      // Already seen: drop
+        Stale           // Behind the order's state (out of order): drop
+    };
+
+    OrderManager() noexcept;
+
+    /// Start tracking a New or Replace request in PendingNew. Returns nullptr
+    /// if the id is already live or the table is full.
+    ManagedOrder* open(const OrderRequest& request) noexcept;
+
+    /// Start tracking a venue child of a live parent.
+    ManagedOrder* open_child(OrderId parent_id, OrderId child_id, ExchangeId exchange,
+                             Quantity quantity) noexcept;
+
+    /// Apply a report answering a request with `action`. Fills `publish` with
+    /// the report to pass on when the result is Applied or Untracked.
+    ReportResult on_report(const ExecutionReport& report, OrderAction action,
+                           ExecutionReport& publish) noexcept;
+
+    const ManagedOrder* find(OrderId id) const noexcept {
+        ManagedOrder* const* order = orders_.find(id);
+        return order ? *order : nullptr;
+    }
+    size_t live_count() const noexcept { return orders_.size(); }
+
+    uint64_t duplicates() const noexcept { return duplicates_; }
+    uint64_t stale_reports() const noexcept { return stale_; }
+
+private:
+    ManagedOrder* allocate(OrderId id) noexcept;
+    void close(ManagedOrder* order) noexcept;
+    void retire_replaced(ManagedOrder* original) noexcept;
+    bool recently_closed(OrderId id) const noexcept { return closed_[closed_slot(id)] == id; }
+    static size_t closed_slot(OrderId id) noexcept {
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ULL) >> (64 - __builtin_ctzll(CLOSED_CACHE_SIZE)));
+    }
+
+    /// Move order to what report says; newly_filled gets the quantity it adds.
+    /// Anything but Applied means the report is dropped.
+    ReportResult advance(ManagedOrder& order, const ExecutionReport& report, Quantity& newly_filled) noexcept;
+    /// Parent state after child's update; returns whether it changed
+    bool roll_up(ManagedOrder& parent, const ManagedOrder& child, Quantity newly_filled,
+                 Price fill_price) noexcept;
+
+    MemoryPool<ManagedOrder, MAX_ORDERS> pool_;
+    FlatHashMap<OrderId, ManagedOrder*, 2 * MAX_ORDERS> orders_;
+    std::array<OrderId, CLOSED_CACHE_SIZE> closed_;
+
+    uint64_t duplicates_ = 0;
+    uint64_t stale_ = 0;
+};
+
+} // namespace trading
@@ -1,14 +1,51 @@
 #pragma once
 
 #include "common/types.hpp"
+#include "containers/flat_hash_map.hpp"
 #include "execution/exchange_simulator.hpp"
+#include "monitoring/latency_estimator.hpp"
+#include "risk/rate_limiter.hpp"
+#include <array>
 #include <vector>
-#include <unordered_map>
 
 namespace trading {
 
 /// Routes orders to the best exchange based on price, latency, or round-robin.
-/// Maintains order-to-exchange mapping for cancel routing.
+/// Maintains order-to-exchange mapping for cancel routing:
+/// - Only orders left resting on a book are tracked; fills, IOC/market
+///   remainders and rejects leave nothing behind, and cancels (accepted or
+///   answered "unknown order" by the venue) and replaces drop the entry
+/// - The tables are preallocated FlatHashMaps: routing does not allocate and
+///   memory is constant for the session. A new order that could not be
+///   tracked (table at capacity) is rejected before it is sent
+///
+/// BestPrice sweeps the venues' books:
+/// - plan_sweep() reads the top SWEEP_DEPTH levels of the opposite side on
+///   every enabled venue and takes levels best-first by fee-adjusted price
+///   (taker_fee_bps) up to the order's quantity and limit
+/// - Each venue with liquidity taken gets one child order; what the books
+///   cannot fill goes to the best-ranked venue (or the cheapest one when no
+///   book has liquidity). FOK orders are never split
+/// - Children are sent back to back (they travel in parallel: the parent's
+///   report time is the latest child's) and their reports are aggregated into
+///   one report for the parent id, priced at the VWAP of every child's trades
+///   (a child report carries only its last trade's price); cancel/replace of
+///   the parent applies to every resting child
+/// plan_sweep() is allocation-free: fixed arrays on the stack, one pass.
+///
+/// LowestLatency ranks venues on what they have measurably delivered:
+/// - record_latency() feeds each venue's LatencyEstimator with send-to-ack
+///   times; record_fill_outcome() an EWMA of accepted (not rejected) orders
+/// - Predicted latency = mean blended with the tail quantile (TAIL_WEIGHT);
+///   the score divides it by the fill rate (a reject costs another trip)
+/// - Before its first sample a venue is scored on its configured latency_ns
+///   and fill_probability
+/// Both record calls are O(1): ExchangeId indexes the venue directly.
+///
+/// With a RateLimiter attached, its exchange buckets throttle real venues:
+/// every strategy skips a venue whose bucket is exhausted, and each order
+/// sent (each sweep child, each replace) charges the venue it goes to.
+/// Cancels are never throttled.
 class OrderRouter {
 public:
     enum class RoutingStrategy {
@@ -17,26 +54,128 @@ public:
         RoundRobin
     };
 
+    static constexpr size_t SWEEP_DEPTH = 5;                    // Levels read per venue
+    static constexpr double TAIL_WEIGHT = 0.25;                 // Share of p99 in predicted latency
+    static constexpr double FILL_RATE_ALPHA = 1.0 / 32;         // EWMA weight of one outcome
+    static constexpr OrderId CHILD_ORDER_ID_BIT = 1ULL << 63;   // Marks router-assigned child ids
+    static constexpr size_t ORDER_MAP_CAPACITY = 1 << 16;       // Resting orders (3/4 usable)
+    static constexpr size_t SWEEP_MAP_CAPACITY = 1 << 12;       // Resting split parents (3/4 usable)
+
+    struct SweepChild {
+        ExchangeSimulator* exchange;
+        Quantity quantity;
+    };
+
+    /// Child orders in rank order (best venue first)
+    struct SweepPlan {
+        std::array<SweepChild, MAX_EXCHANGES> children;
+        size_t count = 0;
+        Quantity displayed = 0;     // Quantity matched against displayed depth
+    };
+
     OrderRouter();
 
     void add_exchange(ExchangeSimulator* exchange);
     void set_routing_strategy(RoutingStrategy strategy) { strategy_ = strategy; }
+    /// Per-venue order rate (exchange buckets only); nullptr disables
+    void set_rate_limiter(RateLimiter* limiter) noexcept { limiter_ = limiter; }
+
+    /// Reports of the child orders a split parent was sent as
+    struct ChildReports {
+        std::array<ExecutionReport, MAX_EXCHANGES> reports;     // order_id = child id
+        std::array<Quantity, MAX_EXCHANGES> quantities;         // Child order quantity
+        std::array<Price, MAX_EXCHANGES> notionals;             // Sum of fill price x quantity
+        size_t count = 0;
+    };
 
     /// Route an order. Returns execution report.
-    ExecutionReport route_order(const OrderRequest& request);
+    /// Cancel and Replace actions go to the exchange holding orig_id.
+    /// A split order still returns the aggregated parent report; with
+    /// `children` set, the per-child reports are copied there too (count 0
+    /// when the order was not split).
+    ExecutionReport route_order(const OrderRequest& request, ChildReports* children = nullptr);
 
     /// Cancel an order (routes to correct exchange).
     ExecutionReport cancel_order(OrderId order_id);
 
+    /// Cancel/replace request.orig_id with request.id on the same exchange.
+    ExecutionReport replace_order(const OrderRequest& request, ChildReports* children = nullptr);
+
+    /// Split request across venues (BestPrice). Returns the child count:
+    /// 0 only when no venue is enabled and within its rate.
+    size_t plan_sweep(const OrderRequest& request, SweepPlan& plan) const noexcept;
+
+    /// Measured send-to-ack time of a report from `exchange`
+    void record_latency(ExchangeId exchange, uint64_t round_trip_ns) noexcept;
+    /// Outcome of a new order at `exchange`: accepted, or rejected by the venue
+    void record_fill_outcome(ExchangeId exchange, bool accepted) noexcept;
+
+    /// Model inputs for LowestLatency; 0 for an unknown exchange
+    double predicted_latency_ns(ExchangeId exchange) const noexcept;
+    double fill_rate(ExchangeId exchange) const noexcept;
+    const LatencyEstimator* latency_estimator(ExchangeId exchange) const noexcept {
+        const VenueStats* venue = stats(exchange);
+        return venue ? &venue->latency : nullptr;
+    }
+
+    /// Parent orders count once however many children they rest as.
+    size_t open_order_count() const noexcept { return order_exchange_map_.size() + sweep_orders_.size(); }
+
     size_t exchange_count() const noexcept { return exchanges_.size(); }
+    /// Orders rejected because every candidate venue was over its rate
+    uint64_t venue_throttled() const noexcept { return venue_throttled_; }
 
 private:
+    /// Resting children of a split parent
+    struct SweepOrder {
+        std::array<OrderId, MAX_EXCHANGES> child_ids;
+        std::array<ExchangeId, MAX_EXCHANGES> exchanges;
+        size_t count = 0;
+    };
+
+    /// Measured behaviour of one venue (slot = position in exchanges_)
+    struct VenueStats {
+        LatencyEstimator latency;
+        double fill_rate = 1.0;
+        uint64_t outcomes = 0;
+    };
+
+    static constexpr uint8_t NO_VENUE = 0xFF;
+
+    const VenueStats* stats(ExchangeId exchange) const noexcept {
+        uint8_t slot = venue_slot_[exchange];
+        return slot == NO_VENUE ? nullptr : &venue_stats_[slot];
+    }
+    double latency_score(size_t slot) const noexcept;
+    bool throttled(const ExchangeSimulator* exchange) const noexcept {
+        return limiter_ && !limiter_->exchange_conforms(exchange->id(), ThreadClock::now());
+    }
+    bool charge(const ExchangeSimulator* exchange) noexcept {
+        return !limiter_ || limiter_->try_acquire_exchange(exchange->id(), ThreadClock::now());
+    }
+
     ExchangeSimulator* select_exchange(const OrderRequest& request);
+    ExchangeSimulator* find_exchange(ExchangeId id) const noexcept;
+    ExecutionReport route_sweep(const OrderRequest& request, const SweepPlan& plan, ChildReports* children);
+    ExecutionReport cancel_sweep(OrderId order_id);
+    static ExecutionReport reject(const OrderRequest& request) noexcept;
+
+    /// Whether the order behind report is left working on the venue's book
+    static bool rests(const OrderRequest& request, const ExecutionReport& report) noexcept {
+        return report.status == OrderStatus::New ||
+               (report.status == OrderStatus::PartiallyFilled && request.type == OrderType::Limit);
+    }
 
     std::vector<ExchangeSimulator*> exchanges_;
-    std::unordered_map<OrderId, ExchangeId> order_exchange_map_;
+    FlatHashMap<OrderId, ExchangeId, ORDER_MAP_CAPACITY> order_exchange_map_;
+    FlatHashMap<OrderId, SweepOrder, SWEEP_MAP_CAPACITY> sweep_orders_;    // Parent id -> resting children
+    std::array<VenueStats, MAX_EXCHANGES> venue_stats_;
+    std::array<uint8_t, 256> venue_slot_;                      // ExchangeId -> venue_stats_ slot
+    OrderId next_child_id_ = CHILD_ORDER_ID_BIT | 1;
     RoutingStrategy strategy_ = RoutingStrategy::RoundRobin;
     size_t round_robin_idx_ = 0;
+    RateLimiter* limiter_ = nullptr;
+    uint64_t venue_throttled_ = 0;
 };
 
 } // namespace trading
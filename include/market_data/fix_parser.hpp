@@ -31,6 +31,7 @@ public:
     Price get_price() const noexcept;               // Tag 44
     Quantity get_quantity() const noexcept;          // Tag 38
     OrderType get_order_type() const noexcept;      // Tag 40
+    uint64_t get_uint(int tag) const noexcept { return parse_uint64_field(get_field(tag)); }
 
     /// Market data fields
     Price get_bid_price() const noexcept;           // Tag 132
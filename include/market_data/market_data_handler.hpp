@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/types.hpp"
+#include "common/clock.hpp"
 #include "containers/lock_free_queue.hpp"
 #include "market_data/fix_parser.hpp"
 #include <atomic>
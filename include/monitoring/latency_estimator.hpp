@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace trading {
+
+/// P² streaming quantile estimate (Jain & Chlamtac): five markers track the
+/// minimum, p/2, p, (1+p)/2 and the maximum, moved by piecewise-parabolic
+/// interpolation as samples arrive.
+/// - O(1) time and constant space per sample, no stored samples
+/// - Exact while fewer than five samples have been seen
+class P2Quantile {
+public:
+    explicit P2Quantile(double quantile = 0.99) noexcept;
+
+    void record(double value) noexcept;
+    double value() const noexcept;
+
+    uint64_t count() const noexcept { return count_; }
+    double quantile() const noexcept { return p_; }
+    void reset() noexcept;
+
+private:
+    double parabolic(int i, double d) const noexcept;
+    double linear(int i, int d) const noexcept;
+
+    double p_;
+    uint64_t count_ = 0;
+    std::array<double, 5> heights_{};       // Marker values
+    std::array<int64_t, 5> positions_{};    // Actual marker positions
+    std::array<double, 5> desired_{};       // Desired marker positions
+    std::array<double, 5> increments_{};    // Desired position step per sample
+};
+
+/// Online round-trip latency model for one venue:
+/// - mean(): EWMA of the samples (alpha per sample)
+/// - tail(): P² estimate of a high quantile over recent samples. The sketch
+///   restarts every `window` samples and the previous window's estimate is
+///   served until the new one has MIN_WINDOW_SAMPLES, so a venue that
+///   degrades (or recovers) shows up within a window instead of being
+///   averaged into its whole history
+/// record() is O(1) and allocation-free.
+class LatencyEstimator {
+public:
+    static constexpr uint32_t MIN_WINDOW_SAMPLES = 32;
+
+    explicit LatencyEstimator(double quantile = 0.99, double alpha = 0.125,
+                              uint32_t window = 1024) noexcept;
+
+    void record(uint64_t latency_ns) noexcept;
+
+    double mean() const noexcept { return mean_; }
+    double tail() const noexcept;
+    uint64_t count() const noexcept { return count_; }
+
+private:
+    double alpha_;
+    uint32_t window_;
+    double mean_ = 0.0;
+    uint64_t count_ = 0;
+    P2Quantile current_;
+    P2Quantile previous_;
+};
+
+} // namespace trading
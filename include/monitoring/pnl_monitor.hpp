@@ -0,0 +1,82 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "containers/seqlock.hpp"
+#include "risk/kill_switch.hpp"
+#include "risk/position_tracker.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace trading {
+
+/// Real-time P&L and drawdown, evaluated off the trading thread.
+/// - The trading thread publishes an O(1) P&L snapshot (the position tracker
+///   keeps it incrementally) into a seqlock after processing fills/marks
+/// - A monitor thread on the monitoring core reads a consistent snapshot at a
+///   bounded cadence, tracks peak and drawdown, and fires the global halt
+///   through the kill switch's atomic bitmap when the limit is crossed
+/// - evaluate() runs one step synchronously (tests, single-threaded callers)
+class PnlMonitor {
+public:
+    /// Totals in PRICE_SCALE units, as published by the trading thread
+    struct Snapshot {
+        int64_t realized_pnl;
+        int64_t unrealized_pnl;
+        int64_t gross_notional;
+        int64_t total_absolute_position;
+        Timestamp timestamp;
+
+        int64_t total_pnl() const noexcept { return realized_pnl + unrealized_pnl; }
+    };
+
+    PnlMonitor(KillSwitch& halts, double max_drawdown_pct) noexcept;
+    ~PnlMonitor();
+
+    PnlMonitor(const PnlMonitor&) = delete;
+    PnlMonitor& operator=(const PnlMonitor&) = delete;
+
+    /// Trading thread: publish current totals. A handful of stores, no waits.
+    void publish(const PositionTracker& positions, Timestamp now) noexcept {
+        snapshot_.store(Snapshot{positions.realized_pnl_scaled(), positions.unrealized_pnl_scaled(),
+                                 positions.gross_notional(), positions.total_absolute_position(), now});
+    }
+
+    /// Monitor side: read the latest snapshot and update peak / drawdown.
+    /// Returns true if this step fired the kill switch.
+    bool evaluate() noexcept;
+
+    void start(int core_id, std::chrono::microseconds interval = std::chrono::microseconds(1000));
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+    /// May be changed from any thread (e.g. on a limits reload)
+    void set_max_drawdown_pct(double pct) noexcept { max_drawdown_.store(pct / 100.0, std::memory_order_relaxed); }
+
+    /// Latest consistent snapshot
+    Snapshot snapshot() const noexcept { return snapshot_.load(); }
+
+    /// Monitor-side results, readable from any thread
+    double peak_pnl() const noexcept { return peak_pnl_.load(std::memory_order_relaxed); }
+    double max_drawdown() const noexcept { return max_drawdown_seen_.load(std::memory_order_relaxed); }
+    uint64_t evaluations() const noexcept { return evaluations_.load(std::memory_order_relaxed); }
+
+private:
+    void run_loop(int core_id, std::chrono::microseconds interval);
+
+    SeqLock<Snapshot> snapshot_;
+    KillSwitch& halts_;
+    std::atomic<double> max_drawdown_;          // Fraction of peak, e.g. 0.02
+
+    // Written by the evaluating thread only
+    uint64_t last_version_ = 0;
+    std::atomic<double> peak_pnl_{0.0};
+    std::atomic<double> max_drawdown_seen_{0.0};
+    std::atomic<uint64_t> evaluations_{0};
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace trading
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "order_book/order_book.hpp"
+#include <array>
+
+namespace trading {
+
+/// Incremental order book features for one instrument:
+/// - Top-N quantity imbalance, top-of-book imbalance
+/// - Microprice (size-weighted mid)
+/// - Depth-weighted (1 / (level + 1)) quantity per side
+/// Maintained from OrderBook level-change notifications: a quantity change on
+/// a cached level is an O(1) delta, a new level inside the window is an O(N)
+/// shift. Only removing a cached level from a full window re-reads the book.
+/// All reads are O(1).
+class BookFeatures : public OrderBookListener {
+public:
+    static constexpr size_t MAX_LEVELS = 10;
+
+    explicit BookFeatures(const OrderBook& book, size_t levels = 5) noexcept;
+
+    void on_level_update(InstrumentId instrument, Side side,
+                         Price price, Quantity total_quantity) override;
+
+    /// Rebuild both sides from the book (after attaching to a non-empty book).
+    void sync() noexcept;
+
+    /// (bid - ask) / (bid + ask) over the top N levels, in [-1, 1].
+    double imbalance() const noexcept { return ratio(bids_.quantity, asks_.quantity); }
+
+    /// Same over the best level only.
+    double top_imbalance() const noexcept { return ratio(top_quantity(bids_), top_quantity(asks_)); }
+
+    /// Imbalance of the depth-weighted quantities.
+    double weighted_imbalance() const noexcept { return ratio(bids_.weighted, asks_.weighted); }
+
+    /// Size-weighted mid: leans towards the side with less resting quantity.
+    /// Returns 0.0 when either side is empty.
+    double microprice() const noexcept;
+
+    Quantity bid_depth() const noexcept { return bids_.quantity; }
+    Quantity ask_depth() const noexcept { return asks_.quantity; }
+    double weighted_bid_depth() const noexcept { return bids_.weighted; }
+    double weighted_ask_depth() const noexcept { return asks_.weighted; }
+
+    size_t bid_levels() const noexcept { return bids_.count; }
+    size_t ask_levels() const noexcept { return asks_.count; }
+    size_t levels() const noexcept { return levels_; }
+
+    /// Number of notifications applied.
+    uint64_t updates() const noexcept { return updates_; }
+    /// Number of times a side had to be re-read from the book.
+    uint64_t refreshes() const noexcept { return refreshes_; }
+
+private:
+    struct SideCache {
+        std::array<Price, MAX_LEVELS> price{};
+        std::array<Quantity, MAX_LEVELS> quantity_at{};
+        size_t count = 0;
+        Quantity quantity = 0;   // Sum over cached levels
+        double weighted = 0.0;   // Sum of quantity_at[i] * weight(i)
+    };
+
+    static constexpr double weight(size_t level) noexcept {
+        return 1.0 / static_cast<double>(level + 1);
+    }
+
+    static double ratio(double bid, double ask) noexcept {
+        double total = bid + ask;
+        return total > 0.0 ? (bid - ask) / total : 0.0;
+    }
+
+    static Quantity top_quantity(const SideCache& c) noexcept {
+        return c.count > 0 ? c.quantity_at[0] : 0;
+    }
+
+    void refresh(Side side) noexcept;
+    static void recompute(SideCache& c) noexcept;
+
+    const OrderBook& book_;
+    size_t levels_;
+    SideCache bids_;
+    SideCache asks_;
+    uint64_t updates_ = 0;
+    uint64_t refreshes_ = 0;
+};
+
+} // namespace trading
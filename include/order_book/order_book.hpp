@@ -10,12 +10,22 @@
 
 namespace trading {
 
+/// Receives price level changes from an OrderBook.
+/// total_quantity == 0 means the level was removed.
+class OrderBookListener {
+public:
+    virtual ~OrderBookListener() = default;
+    virtual void on_level_update(InstrumentId instrument, Side side,
+                                 Price price, Quantity total_quantity) = 0;
+};
+
 /// OrderBook: price-time priority matching engine.
 /// - Bids: descending price (std::greater)
 /// - Asks: ascending price (default)
 /// - O(1) order lookup via unordered_map
 /// - O(1) cancel via intrusive list
 /// - Returns trades via std::span over thread-local static array (no heap alloc)
+/// - Optional listener notified once per changed price level
 class OrderBook {
 public:
     static constexpr size_t MAX_TRADES_PER_MATCH = 64;
@@ -47,6 +57,9 @@ public:
     };
     size_t get_depth(DepthEntry* bids, DepthEntry* asks, size_t max_levels) const;
 
+    /// Depth of one side: returns number of levels filled.
+    size_t get_side_depth(Side side, DepthEntry* entries, size_t max_levels) const;
+
     /// VWAP over top N levels on a given side.
     double vwap(Side side, size_t levels) const;
 
@@ -60,6 +73,9 @@ public:
 
     InstrumentId instrument() const noexcept { return instrument_; }
 
+    /// Attach a level-change listener (nullptr to detach). Not owned.
+    void set_listener(OrderBookListener* listener) noexcept { listener_ = listener; }
+
 private:
     std::span<Trade> match_order(OrderBookEntry* entry);
     void try_match_limit(OrderBookEntry* entry, size_t& trade_count);
@@ -69,6 +85,10 @@ private:
     void update_best_bid();
     void update_best_ask();
 
+    void notify_level(Side side, Price price, Quantity total_quantity) {
+        if (listener_) listener_->on_level_update(instrument_, side, price, total_quantity);
+    }
+
     InstrumentId instrument_;
     MemoryPool<OrderBookEntry, ORDER_POOL_SIZE> pool_;
 
@@ -85,6 +105,8 @@ private:
     Quantity best_bid_qty_ = 0;
     Quantity best_ask_qty_ = 0;
 
+    OrderBookListener* listener_ = nullptr;
+
     // Thread-local trade buffer to avoid heap allocation
     static thread_local std::array<Trade, MAX_TRADES_PER_MATCH> trade_buffer_;
 };
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "common/types.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace trading {
+
+enum class HaltScope : uint8_t {
+    Global = 0,
+    Strategy = 1,
+    Instrument = 2,
+    Exchange = 3
+};
+
+/// Hierarchical kill switch as halt bitmaps, settable from any thread.
+/// - One scope word: bit 63 global, bits 16..47 strategies, bits 0..15 exchanges
+/// - One bit per instrument in four more words, same cache line
+/// - blocks() is two acquire loads and a few bit tests; halting or resuming
+///   is a single fetch_or / fetch_and, so concurrent updates never lose a bit
+/// - generation() moves on every halt: the execution thread polls it to
+///   cancel working orders in the newly halted scopes
+class KillSwitch {
+public:
+    static constexpr size_t INSTRUMENT_WORDS = MAX_INSTRUMENTS / 64;
+
+    /// Returns false if id is out of range for the scope (id ignored for Global)
+    bool halt(HaltScope scope, uint32_t id = 0) noexcept {
+        if (!update(scope, id, true)) return false;
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    bool resume(HaltScope scope, uint32_t id = 0) noexcept {
+        return update(scope, id, false);
+    }
+
+    bool halted(HaltScope scope, uint32_t id = 0) const noexcept {
+        uint64_t bit = 0;
+        const std::atomic<uint64_t>* word = locate(scope, id, bit);
+        return word && (word->load(std::memory_order_acquire) & bit);
+    }
+
+    /// Point-in-time copy of all bitmaps, for testing many orders at once
+    struct Snapshot {
+        uint64_t scopes;
+        std::array<uint64_t, INSTRUMENT_WORDS> instruments;
+
+        bool global() const noexcept { return scopes & GLOBAL_BIT; }
+
+        bool blocks(const OrderRequest& request) const noexcept {
+            return ((scopes & order_mask(request)) |
+                    (instrument_word(instruments, request.instrument) & instrument_bit(request.instrument))) != 0;
+        }
+    };
+
+    Snapshot snapshot() const noexcept {
+        Snapshot snap;
+        snap.scopes = scopes_.load(std::memory_order_acquire);
+        for (size_t w = 0; w < INSTRUMENT_WORDS; ++w) {
+            snap.instruments[w] = instruments_[w].load(std::memory_order_acquire);
+        }
+        return snap;
+    }
+
+    /// True if any level (global, the order's strategy, instrument or
+    /// exchange) is halted. Cancels should be let through by the caller.
+    __attribute__((always_inline))
+    bool blocks(const OrderRequest& request) const noexcept {
+        uint64_t scopes = scopes_.load(std::memory_order_acquire);
+        uint64_t instruments = request.instrument < MAX_INSTRUMENTS
+            ? instruments_[request.instrument >> 6].load(std::memory_order_acquire) : 0;
+        return ((scopes & order_mask(request)) | (instruments & instrument_bit(request.instrument))) != 0;
+    }
+
+    bool global() const noexcept { return scopes_.load(std::memory_order_acquire) & GLOBAL_BIT; }
+    bool any() const noexcept {
+        Snapshot snap = snapshot();
+        uint64_t bits = snap.scopes;
+        for (uint64_t word : snap.instruments) bits |= word;
+        return bits != 0;
+    }
+
+    uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+
+    /// Resume everything
+    void clear() noexcept {
+        scopes_.store(0, std::memory_order_release);
+        for (auto& word : instruments_) word.store(0, std::memory_order_release);
+    }
+
+private:
+    static constexpr unsigned STRATEGY_SHIFT = 16;
+    static constexpr uint64_t GLOBAL_BIT = 1ULL << 63;
+    static_assert(MAX_EXCHANGES <= STRATEGY_SHIFT && STRATEGY_SHIFT + MAX_STRATEGIES <= 63,
+                  "Scope word layout");
+
+    static uint64_t order_mask(const OrderRequest& request) noexcept {
+        uint64_t mask = GLOBAL_BIT;
+        if (request.exchange < MAX_EXCHANGES) mask |= 1ULL << request.exchange;
+        if (request.strategy < MAX_STRATEGIES) mask |= 1ULL << (STRATEGY_SHIFT + request.strategy);
+        return mask;
+    }
+    static uint64_t instrument_bit(InstrumentId instrument) noexcept {
+        return 1ULL << (instrument & 63);
+    }
+    static uint64_t instrument_word(const std::array<uint64_t, INSTRUMENT_WORDS>& words,
+                                    InstrumentId instrument) noexcept {
+        return instrument < MAX_INSTRUMENTS ? words[instrument >> 6] : 0;
+    }
+
+    const std::atomic<uint64_t>* locate(HaltScope scope, uint32_t id, uint64_t& bit) const noexcept {
+        switch (scope) {
+            case HaltScope::Global:
+                bit = GLOBAL_BIT;
+                return &scopes_;
+            case HaltScope::Strategy:
+                if (id >= MAX_STRATEGIES) return nullptr;
+                bit = 1ULL << (STRATEGY_SHIFT + id);
+                return &scopes_;
+            case HaltScope::Exchange:
+                if (id >= MAX_EXCHANGES) return nullptr;
+                bit = 1ULL << id;
+                return &scopes_;
+            case HaltScope::Instrument:
+                if (id >= MAX_INSTRUMENTS) return nullptr;
+                bit = instrument_bit(id);
+                return &instruments_[id >> 6];
+        }
+        return nullptr;
+    }
+
+    bool update(HaltScope scope, uint32_t id, bool set) noexcept {
+        uint64_t bit = 0;
+        auto* word = const_cast<std::atomic<uint64_t>*>(locate(scope, id, bit));
+        if (!word) return false;
+        if (set) {
+            word->fetch_or(bit, std::memory_order_acq_rel);
+        } else {
+            word->fetch_and(~bit, std::memory_order_acq_rel);
+        }
+        return true;
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> scopes_{0};
+    std::array<std::atomic<uint64_t>, INSTRUMENT_WORDS> instruments_{};
+    std::atomic<uint64_t> generation_{0};
+};
+
+} // namespace trading
@@ -8,6 +8,18 @@ namespace trading {
 
 /// Flat-array position tracker indexed by InstrumentId. O(1) all operations.
 /// No virtual dispatch, all inline for maximum performance.
+/// Risk aggregates (absolute position, notional, capital) are maintained
+/// incrementally by on_fill/update_mark_price so reads never scan the universe.
+///
+/// Accounting is fixed-point in PRICE_SCALE units (cents):
+/// - Each instrument keeps a signed cost basis (sum of qty * price of the open
+///   position); the average price is derived from it only when asked for
+/// - Adding to a position and closing it out are division-free; a partial
+///   reduce takes one integer division (128-bit only if the product would
+///   overflow) whose remainder stays in the basis, so a round trip realizes
+///   exactly proceeds minus cost
+/// - Realized and unrealized P&L are exact integers; the double accessors
+///   convert on read
 class PositionTracker {
 public:
     PositionTracker() noexcept;
@@ -20,28 +32,54 @@ public:
 
     /// Position queries
     int64_t position(InstrumentId instrument) const noexcept;
-    int64_t total_absolute_position() const noexcept;
+    int64_t total_absolute_position() const noexcept { return total_absolute_position_; }
 
-    /// P&L
-    double realized_pnl() const noexcept { return realized_pnl_; }
-    double unrealized_pnl() const noexcept;
-    double total_pnl() const noexcept;
+    /// Sum of |position| * mark over marked instruments, in PRICE_SCALE units (exact)
+    int64_t gross_notional() const noexcept { return gross_notional_; }
+
+    /// P&L in dollars
+    double realized_pnl() const noexcept { return to_dollars(realized_pnl_); }
+    double unrealized_pnl() const noexcept { return to_dollars(unrealized_pnl_); }
+    double total_pnl() const noexcept { return to_dollars(realized_pnl_ + unrealized_pnl_); }
+
+    /// Exact P&L in PRICE_SCALE units. Unrealized covers marked instruments only.
+    int64_t realized_pnl_scaled() const noexcept { return realized_pnl_; }
+    int64_t unrealized_pnl_scaled() const noexcept { return unrealized_pnl_; }
+
+    /// Signed cost basis of the open position in PRICE_SCALE units
+    /// (negative for shorts)
+    int64_t cost_basis(InstrumentId instrument) const noexcept;
 
     /// Average price for an instrument
     double avg_price(InstrumentId instrument) const noexcept;
 
-    /// Capital used (approximate)
-    double capital_used() const noexcept;
+    /// Capital used: gross notional at mark, or at cost for instruments not
+    /// yet marked
+    double capital_used() const noexcept { return to_dollars(gross_notional_ + unmarked_cost_); }
 
     /// Reset all positions
     void reset() noexcept;
 
 private:
+    static double to_dollars(int64_t scaled) noexcept {
+        return static_cast<double>(scaled) / PRICE_SCALE;
+    }
+
+    /// Take an instrument's contribution out of / back into the aggregates
+    /// around a change to its position, cost basis or mark.
+    void remove_exposure(InstrumentId instrument) noexcept;
+    void add_exposure(InstrumentId instrument) noexcept;
+
     std::array<int64_t, MAX_INSTRUMENTS> positions_;
-    std::array<double, MAX_INSTRUMENTS> avg_prices_;       // Average entry price
+    std::array<int64_t, MAX_INSTRUMENTS> cost_basis_;      // Signed sum of qty * price
     std::array<Price, MAX_INSTRUMENTS> mark_prices_;       // Current market price
-    std::array<double, MAX_INSTRUMENTS> instrument_pnl_;   // Realized P&L per instrument
-    double realized_pnl_ = 0.0;
+    std::array<int64_t, MAX_INSTRUMENTS> instrument_pnl_;  // Realized P&L per instrument
+    int64_t realized_pnl_ = 0;
+
+    int64_t total_absolute_position_ = 0;
+    int64_t gross_notional_ = 0;
+    int64_t unrealized_pnl_ = 0;
+    int64_t unmarked_cost_ = 0;         // |cost basis| where no mark yet
 };
 
 } // namespace trading
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "common/types.hpp"
+#include <array>
+#include <cstdint>
+
+namespace trading {
+
+/// Order rate limiter using GCRA (generic cell rate algorithm), the
+/// virtual-scheduling form of a token bucket:
+/// - Each bucket keeps one theoretical arrival time (TAT); an order conforms
+///   if now >= TAT - tolerance, and then pushes TAT out by one interval
+/// - interval = 1s / rate, tolerance = (burst - 1) * interval: up to `burst`
+///   orders back to back, then a steady `rate` per second. No window edges,
+///   so no 2x burst where two windows meet
+/// - Integer nanoseconds only; the caller passes the time (cached clock)
+/// Global, per-instrument and per-exchange buckets are checked together and
+/// only charged when all of them conform. A rate of 0 disables a scope.
+/// The exchange bucket is keyed on whatever ExchangeId the caller passes:
+/// before routing that is only the request's tag (request.exchange); to
+/// throttle real venues, charge it separately with try_acquire_exchange()
+/// once the router has picked the venue.
+class RateLimiter {
+public:
+    enum class Scope : uint8_t {
+        Global = 0,
+        Instrument = 1,     // Same limit, separate bucket per instrument
+        Exchange = 2        // Same limit, separate bucket per exchange
+    };
+
+    /// burst 0 means burst == per_second (a full second's worth up front)
+    void set_limit(Scope scope, uint32_t per_second, uint32_t burst = 0) noexcept {
+        Config& config = configs_[static_cast<size_t>(scope)];
+        if (per_second == 0) {
+            config = Config{};
+            return;
+        }
+        if (burst == 0) burst = per_second;
+        config.interval_ns = ONE_SECOND_NS / per_second;
+        config.tolerance_ns = config.interval_ns * (burst - 1);
+    }
+
+    /// Charge one order to all enabled buckets, or none if any would overflow.
+    __attribute__((always_inline))
+    bool try_acquire(InstrumentId instrument, ExchangeId exchange, Timestamp now) noexcept {
+        const Config& g = configs_[0];
+        const Config& i = configs_[1];
+        const Config& e = configs_[2];
+        Timestamp& g_tat = global_tat_;
+        Timestamp& i_tat = instrument_tat_[instrument < MAX_INSTRUMENTS ? instrument : 0];
+        Timestamp& e_tat = exchange_tat_[exchange < MAX_EXCHANGES ? exchange : 0];
+
+        bool ok = conforms(g, g_tat, now) & conforms(i, i_tat, now) & conforms(e, e_tat, now);
+        if (!ok) [[unlikely]] return false;
+
+        charge(g, g_tat, now);
+        charge(i, i_tat, now);
+        charge(e, e_tat, now);
+        return true;
+    }
+
+    /// Global and per-instrument buckets only (venue not known yet)
+    __attribute__((always_inline))
+    bool try_acquire(InstrumentId instrument, Timestamp now) noexcept {
+        const Config& g = configs_[0];
+        const Config& i = configs_[1];
+        Timestamp& i_tat = instrument_tat_[instrument < MAX_INSTRUMENTS ? instrument : 0];
+
+        if (!(conforms(g, global_tat_, now) & conforms(i, i_tat, now))) [[unlikely]] return false;
+        charge(g, global_tat_, now);
+        charge(i, i_tat, now);
+        return true;
+    }
+
+    /// Per-exchange bucket only: whether one more order to `exchange` would
+    /// conform, and charging it
+    bool exchange_conforms(ExchangeId exchange, Timestamp now) const noexcept {
+        return conforms(configs_[2], exchange_tat_[exchange < MAX_EXCHANGES ? exchange : 0], now);
+    }
+    bool try_acquire_exchange(ExchangeId exchange, Timestamp now) noexcept {
+        Timestamp& e_tat = exchange_tat_[exchange < MAX_EXCHANGES ? exchange : 0];
+        if (!conforms(configs_[2], e_tat, now)) [[unlikely]] return false;
+        charge(configs_[2], e_tat, now);
+        return true;
+    }
+
+    /// Forget all history: every bucket starts full.
+    void reset() noexcept {
+        global_tat_ = 0;
+        instrument_tat_.fill(0);
+        exchange_tat_.fill(0);
+    }
+
+private:
+    static constexpr Timestamp ONE_SECOND_NS = 1'000'000'000ULL;
+
+    struct Config {
+        uint64_t interval_ns = 0;       // 0 = unlimited
+        uint64_t tolerance_ns = 0;
+    };
+
+    static bool conforms(const Config& config, Timestamp tat, Timestamp now) noexcept {
+        return config.interval_ns == 0 || tat <= now + config.tolerance_ns;
+    }
+
+    static void charge(const Config& config, Timestamp& tat, Timestamp now) noexcept {
+        if (config.interval_ns == 0) return;
+        tat = (tat > now ? tat : now) + config.interval_ns;
+    }
+
+    std::array<Config, 3> configs_{};
+    Timestamp global_tat_ = 0;
+    std::array<Timestamp, MAX_INSTRUMENTS> instrument_tat_{};
+    std::array<Timestamp, MAX_EXCHANGES> exchange_tat_{};
+};
+
+} // namespace trading
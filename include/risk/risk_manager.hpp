@@ -1,23 +1,19 @@
 #pragma once
 
 #include "common/types.hpp"
+#include "common/clock.hpp"
 #include "common/config.hpp"
+#include "risk/kill_switch.hpp"
 #include "risk/position_tracker.hpp"
+#include "risk/rate_limiter.hpp"
+#include "risk/risk_pipeline.hpp"
+#include "risk/working_orders.hpp"
 #include <atomic>
 #include <array>
+#include <span>
 
 namespace trading {
 
-enum class RiskCheckResult : uint8_t {
-    Approved = 0,
-    KillSwitchActive = 1,
-    PositionLimitBreached = 2,
-    CapitalLimitBreached = 3,
-    OrderSizeTooLarge = 4,
-    OrderRateExceeded = 5,
-    FatFingerPrice = 6
-};
-
 /// Pre-trade risk manager. All checks must complete in <100ns.
 /// Uses flat arrays, integer arithmetic, and [[unlikely]] on failure paths.
 /// No virtual dispatch, no heap allocation, no division on hot path.
@@ -25,58 +21,259 @@ class RiskManager {
 public:
     explicit RiskManager(const RiskLimits& limits);
 
-    /// Check an order against all risk limits. O(1), <100ns target.
+    /// Check an order against all risk limits (DefaultRiskPipeline). O(1), <100ns target.
     __attribute__((hot))
     RiskCheckResult check_order(const OrderRequest& request, Price current_market_price) noexcept;
 
-    /// Kill switch
-    void activate_kill_switch() noexcept { kill_switch_.store(true, std::memory_order_release); }
-    void deactivate_kill_switch() noexcept { kill_switch_.store(false, std::memory_order_release); }
-    bool kill_switch_active() const noexcept { return kill_switch_.load(std::memory_order_acquire); }
+    /// Same, with any RiskPipeline over this manager's state (limits,
+    /// positions, working orders, halts, rate buckets), e.g. without Capital
+    /// or with MaxNotional / PriceCollar added. Cancels always pass.
+    template<typename Pipeline>
+    RiskCheckResult check_order_with(const OrderRequest& request, Price current_market_price) noexcept {
+        ++checks_performed_;
+        const LimitsBlock& active = current_limits();
+
+        // Cancels only reduce exposure — always let them through, even when halted
+        if (request.action == OrderAction::Cancel) {
+            return RiskCheckResult::Approved;
+        }
+
+        const WorkingExposure working{working_.pending(request.instrument), working_.worst_case_quantity(),
+                                      working_.worst_case_notional()};
+        const RiskContext ctx{request, current_market_price, active.limits,
+                              active.price_deviation_threshold, active.price_collar_threshold,
+                              halts_, positions_, working, rate_limiter_};
+        RiskCheckResult result = Pipeline::check(ctx);
+        if (result != RiskCheckResult::Approved) [[unlikely]] ++checks_rejected_;
+        return result;
+    }
+
+    /// Check a batch in submission order; results[i] is the verdict for orders[i].
+    /// Same verdicts as check_order on each order in turn, with each approved
+    /// order recorded as sent before the next:
+    /// - Price checks use the per-instrument reference price
+    ///   (update_market_price); 0 skips them, as in check_order
+    /// - Orders approved earlier in the batch count as working orders for
+    ///   later ones (position, total position and capital limits)
+    /// - The checks are the pipeline's own (RiskPipeline batch passes):
+    ///   stateless ones run branch-free per chunk of BATCH_CHUNK orders into
+    ///   one bit mask each, which the compiler can vectorise
+    /// Returns the number of approved orders. results must be at least as long as orders.
+    static constexpr size_t BATCH_CHUNK = 64;
+    size_t check_orders(std::span<const OrderRequest> orders,
+                        std::span<RiskCheckResult> results) noexcept;
+
+    /// Same, with any RiskPipeline (as check_order_with)
+    template<typename Pipeline>
+    size_t check_orders_with(std::span<const OrderRequest> orders,
+                             std::span<RiskCheckResult> results) noexcept {
+        static_assert(BATCH_CHUNK <= Pipeline::MAX_CHUNK);
+        const size_t n = std::min(orders.size(), results.size());
+        BatchTotals totals{working_.worst_case_quantity(), working_.worst_case_notional()};
+        for (size_t base = 0; base < n; base += BATCH_CHUNK) {
+            size_t count = std::min(BATCH_CHUNK, n - base);
+            check_chunk<Pipeline>(orders.subspan(base, count), results.data() + base, totals);
+        }
+        return finish_batch(orders.first(n), results);
+    }
+
+    /// Reference price for batch fat-finger checks (typically the mid)
+    void update_market_price(InstrumentId instrument, Price price) noexcept {
+        if (instrument < MAX_INSTRUMENTS) market_prices_[instrument] = price;
+    }
+    Price market_price(InstrumentId instrument) const noexcept {
+        return instrument < MAX_INSTRUMENTS ? market_prices_[instrument] : 0;
+    }
+
+    /// Global kill switch
+    void activate_kill_switch() noexcept { halts_.halt(HaltScope::Global); }
+    void deactivate_kill_switch() noexcept { halts_.resume(HaltScope::Global); }
+    bool kill_switch_active() const noexcept { return halts_.global(); }
+
+    /// Scoped halts (strategy, instrument, exchange), settable from any
+    /// thread; hand it to ExecutionEngine::set_kill_switch for cancel-on-halt
+    KillSwitch& kill_switch() noexcept { return halts_; }
+    const KillSwitch& kill_switch() const noexcept { return halts_; }
 
     /// Drawdown monitoring
     void on_pnl_update(double total_pnl) noexcept;
     void set_peak_pnl(double peak) noexcept { peak_pnl_ = peak; }
 
+    /// Working-order tracking: call on_order_sent for each order handed to
+    /// execution and on_execution_report for each report. Position limits
+    /// then assume every working order fills.
+    void on_order_sent(const OrderRequest& request) noexcept { working_.on_order_sent(request); }
+    void on_execution_report(const ExecutionReport& report) noexcept { working_.on_execution_report(report); }
+    WorkingOrders& working_orders() noexcept { return working_; }
+    const WorkingOrders& working_orders() const noexcept { return working_; }
+
     /// Position tracker access
     PositionTracker& position_tracker() noexcept { return positions_; }
     const PositionTracker& position_tracker() const noexcept { return positions_; }
 
-    /// Update limits
-    void set_limits(const RiskLimits& limits) noexcept { limits_ = limits; update_precomputed(); }
-    const RiskLimits& limits() const noexcept { return limits_; }
+    /// Limits hot-reload, RCU-style over two limit blocks:
+    /// - The trading thread reads the active block through one acquire load
+    ///   per check (one per batch), no locks
+    /// - publish_limits() validates, fills the inactive block and swaps the
+    ///   pointer with a release store; safe from one operator thread while
+    ///   the trading thread keeps checking
+    /// - The inactive block is rewritten only after the trading thread has
+    ///   picked up the previous publish (its grace period); until then
+    ///   publish_limits() returns Busy and the caller retries later
+    enum class LimitsUpdate : uint8_t { Published, Invalid, Busy };
+    LimitsUpdate publish_limits(const RiskLimits& limits) noexcept;
+
+    /// Same from the trading thread itself: takes effect immediately.
+    /// Returns false (limits unchanged) if validation fails.
+    bool set_limits(const RiskLimits& limits) noexcept;
+
+    /// Active limits. The reference stays valid until the next publish is
+    /// picked up, so read it from the trading thread.
+    const RiskLimits& limits() const noexcept { return active_limits_.load(std::memory_order_acquire)->limits; }
+    uint64_t limits_version() const noexcept { return active_limits_.load(std::memory_order_acquire)->version; }
 
-    /// Reset rate counter (called periodically)
-    void reset_rate_counter() noexcept { order_count_in_window_ = 0; rate_window_start_ = now_ns(); }
+    /// Refill all rate buckets
+    void reset_rate_counter() noexcept { rate_limiter_.reset(); }
 
     uint64_t checks_performed() const noexcept { return checks_performed_; }
     uint64_t checks_rejected() const noexcept { return checks_rejected_; }
 
 private:
-    void update_precomputed() noexcept;
+    /// One published limits block with its derived thresholds
+    struct LimitsBlock {
+        RiskLimits limits;
+        double price_deviation_threshold;   // max_price_deviation_pct / 100.0
+        double max_drawdown_threshold;      // max_drawdown_pct / 100.0
+        double price_collar_threshold;      // price_collar_bps / 10000.0
+        uint64_t version;
+    };
+
+    /// Active block for this check; picks up a new publish when the version moved
+    __attribute__((always_inline))
+    const LimitsBlock& current_limits() noexcept {
+        const LimitsBlock* block = active_limits_.load(std::memory_order_acquire);
+        if (block->version != adopted_version_) [[unlikely]] adopt_limits(*block);
+        return *block;
+    }
+    void adopt_limits(const LimitsBlock& block) noexcept;
+    static void fill_block(LimitsBlock& block, const RiskLimits& limits, uint64_t version) noexcept;
+
+    struct BatchTotals {
+        int64_t worst_quantity;     // Working orders incl. earlier approvals in the batch
+        int64_t worst_notional;
+    };
+    template<typename Pipeline>
+    void check_chunk(std::span<const OrderRequest> orders, RiskCheckResult* results,
+                     BatchTotals& totals) noexcept;
+    /// Clear the batch's working entries; returns the approved count
+    size_t finish_batch(std::span<const OrderRequest> orders, std::span<const RiskCheckResult> results) noexcept;
+
+    std::array<LimitsBlock, 2> limit_blocks_;
+    alignas(64) std::atomic<const LimitsBlock*> active_limits_;
+    uint64_t adopted_version_ = 0;                  // Trading thread only
+    alignas(64) std::atomic<uint64_t> released_version_{0};   // Grace period: older blocks are free
 
-    RiskLimits limits_;
     PositionTracker positions_;
+    WorkingOrders working_;
 
-    alignas(64) std::atomic<bool> kill_switch_{false};
+    KillSwitch halts_;
 
-    // Precomputed reciprocals for avoiding division on hot path
-    // price_deviation_reciprocal_ = 1.0 / (max_price_deviation_pct / 100.0)
-    // We check: abs(order_price - market_price) * reciprocal > market_price
-    // Which is equivalent to: abs(order_price - market_price) / market_price > pct/100
-    double price_deviation_threshold_; // max_price_deviation_pct / 100.0
+    std::array<Price, MAX_INSTRUMENTS> market_prices_{};
 
-    // Rate limiting
-    uint32_t order_count_in_window_ = 0;
-    Timestamp rate_window_start_ = 0;
+    // Orders approved so far in the current batch; only entries touched by
+    // the batch are non-zero, and they are cleared after it
+    std::array<WorkingOrders::Pending, MAX_INSTRUMENTS> batch_pending_{};
+
+    RateLimiter rate_limiter_;
 
     // Drawdown
     double peak_pnl_ = 0.0;
-    double max_drawdown_threshold_ = 0.0;
 
     // Stats
     uint64_t checks_performed_ = 0;
     uint64_t checks_rejected_ = 0;
 };
 
+template<typename Pipeline>
+void RiskManager::check_chunk(std::span<const OrderRequest> orders, RiskCheckResult* results,
+                              BatchTotals& totals) noexcept {
+    const size_t count = orders.size();
+    checks_performed_ += count;
+    const LimitsBlock& active = current_limits();
+    auto context = [&](const OrderRequest& request, const WorkingExposure& working) {
+        return RiskContext{request, market_price(request.instrument), active.limits,
+                           active.price_deviation_threshold, active.price_collar_threshold,
+                           halts_, positions_, working, rate_limiter_};
+    };
+
+    // Pass 1: stateless checks, branch-free. Each yields a 64-bit mask word
+    // so pass 2 tests bits instead of re-evaluating per order.
+    const typename Pipeline::Masks masks = Pipeline::reject_masks(count, [&](size_t i) {
+        return context(orders[i], WorkingExposure{});
+    });
+
+    // Pass 2: every check in submission order, same precedence as check_order.
+    // Results are byte stores that may alias anything, so keep the running
+    // totals in locals rather than re-reading members each order
+    int64_t worst_quantity = totals.worst_quantity;
+    int64_t worst_notional = totals.worst_notional;
+    uint64_t rejected = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const OrderRequest& request = orders[i];
+        if (request.action == OrderAction::Cancel) {
+            results[i] = RiskCheckResult::Approved;
+            continue;
+        }
+
+        // Working exposure: the working-order book plus orders approved
+        // earlier in this batch
+        const InstrumentId instrument = request.instrument;
+        WorkingOrders::Pending pending = working_.pending(instrument);
+        if (instrument < MAX_INSTRUMENTS) {
+            const WorkingOrders::Pending& batch = batch_pending_[instrument];
+            pending.buy += batch.buy;
+            pending.sell += batch.sell;
+            pending.buy_notional += batch.buy_notional;
+            pending.sell_notional += batch.sell_notional;
+        }
+
+        const RiskCheckResult result =
+            Pipeline::check(context(request, WorkingExposure{pending, worst_quantity, worst_notional}), masks, i);
+        if (result == RiskCheckResult::Approved) {
+            const int64_t quantity = static_cast<int64_t>(request.quantity);
+            const int64_t notional = quantity * request.price;
+            const int64_t worst_before = std::max(pending.buy, pending.sell);
+            const int64_t worst_notional_before = std::max(pending.buy_notional, pending.sell_notional);
+            if (request.side == Side::Buy) {
+                pending.buy += quantity;
+                pending.buy_notional += notional;
+            } else {
+                pending.sell += quantity;
+                pending.sell_notional += notional;
+            }
+            worst_quantity += std::max(pending.buy, pending.sell) - worst_before;
+            worst_notional += std::max(pending.buy_notional, pending.sell_notional) - worst_notional_before;
+
+            if (instrument < MAX_INSTRUMENTS) {
+                WorkingOrders::Pending& batch = batch_pending_[instrument];
+                if (request.side == Side::Buy) {
+                    batch.buy += quantity;
+                    batch.buy_notional += notional;
+                } else {
+                    batch.sell += quantity;
+                    batch.sell_notional += notional;
+                }
+            }
+        } else {
+            ++rejected;
+        }
+        results[i] = result;
+    }
+
+    totals.worst_quantity = worst_quantity;
+    totals.worst_notional = worst_notional;
+    checks_rejected_ += rejected;
+}
+
 } // namespace trading
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "common/clock.hpp"
+#include "common/config.hpp"
+#include "risk/kill_switch.hpp"
+#include "risk/position_tracker.hpp"
+#include "risk/rate_limiter.hpp"
+#include "risk/working_orders.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdlib>
+
+namespace trading {
+
+enum class RiskCheckResult : uint8_t {
+    Approved = 0,
+    KillSwitchActive = 1,
+    PositionLimitBreached = 2,
+    CapitalLimitBreached = 3,
+    OrderSizeTooLarge = 4,
+    OrderRateExceeded = 5,
+    FatFingerPrice = 6,
+    TradingHalted = 7,      // Strategy, instrument or exchange halt
+    NotionalTooLarge = 8,
+    OutsidePriceCollar = 9
+};
+
+/// Working orders as a check sees them. A batch check adds the orders
+/// approved earlier in the batch, so checks need no batch-specific code.
+struct WorkingExposure {
+    WorkingOrders::Pending instrument;  // The order's instrument
+    int64_t worst_quantity;             // Larger side summed over instruments
+    int64_t worst_notional;
+};
+
+/// Everything a pre-trade check may look at for one order. Built once per
+/// check_order call; checks read what they need.
+struct RiskContext {
+    const OrderRequest& request;
+    Price market_price;                 // 0 = unknown, price checks skip
+    const RiskLimits& limits;
+    double price_deviation_threshold;   // max_price_deviation_pct / 100
+    double price_collar_threshold;      // price_collar_bps / 10000
+    const KillSwitch& halts;
+    const PositionTracker& positions;
+    WorkingExposure working;
+    RateLimiter& rate_limiter;          // Charged by the Rate check
+};
+
+/// A check that depends only on the order, its market price and the limits
+/// (no positions, working orders, halts or rate buckets) may be written as
+///     static constexpr RiskCheckResult REJECTS = ...;
+///     static bool rejects(const RiskContext&) noexcept;
+/// Batches then evaluate it branch-free for a whole chunk up front.
+template<typename Check>
+concept StatelessRiskCheck = requires(const RiskContext& ctx) {
+    { Check::rejects(ctx) } -> std::convertible_to<bool>;
+    { Check::REJECTS } -> std::convertible_to<RiskCheckResult>;
+};
+
+/// Pre-trade checks as policy types. A check is any type with
+///     static RiskCheckResult check(const RiskContext&) noexcept;
+/// returning Approved to pass the order on, or a StatelessRiskCheck. New
+/// checks are new types; existing ones never change.
+namespace risk_checks {
+
+/// Global kill switch and scoped halts
+struct KillSwitch {
+    static RiskCheckResult check(const RiskContext& ctx) noexcept {
+        if (ctx.halts.blocks(ctx.request)) [[unlikely]] {
+            return ctx.halts.global() ? RiskCheckResult::KillSwitchActive : RiskCheckResult::TradingHalted;
+        }
+        return RiskCheckResult::Approved;
+    }
+};
+
+struct OrderSize {
+    static constexpr RiskCheckResult REJECTS = RiskCheckResult::OrderSizeTooLarge;
+    static bool rejects(const RiskContext& ctx) noexcept {
+        return ctx.request.quantity > ctx.limits.max_order_size;
+    }
+};
+
+/// Per-instrument and total position, worst case: every working order on the
+/// instrument fills, plus this one; other instruments count their larger side
+struct Position {
+    static RiskCheckResult check(const RiskContext& ctx) noexcept {
+        const OrderRequest& request = ctx.request;
+        const WorkingOrders::Pending& working = ctx.working.instrument;
+        const int64_t quantity = static_cast<int64_t>(request.quantity);
+        const int64_t buy = working.buy + (request.side == Side::Buy ? quantity : 0);
+        const int64_t sell = working.sell + (request.side == Side::Buy ? 0 : quantity);
+
+        const int64_t pos = ctx.positions.position(request.instrument);
+        const int64_t worst = std::max(std::abs(pos + buy), std::abs(pos - sell));
+        if (worst > ctx.limits.max_position_per_instrument) [[unlikely]] {
+            return RiskCheckResult::PositionLimitBreached;
+        }
+
+        const int64_t others = ctx.working.worst_quantity - std::max(working.buy, working.sell);
+        const int64_t total = ctx.positions.total_absolute_position() - std::abs(pos) + worst + others;
+        if (total > ctx.limits.max_total_position) [[unlikely]] {
+            return RiskCheckResult::PositionLimitBreached;
+        }
+        return RiskCheckResult::Approved;
+    }
+};
+
+/// Capital used plus the larger side of working notional, incl. this order
+struct Capital {
+    static RiskCheckResult check(const RiskContext& ctx) noexcept {
+        const OrderRequest& request = ctx.request;
+        const WorkingOrders::Pending& working = ctx.working.instrument;
+        const int64_t notional = static_cast<int64_t>(request.quantity) * request.price;
+        const int64_t buy_notional = working.buy_notional + (request.side == Side::Buy ? notional : 0);
+        const int64_t sell_notional = working.sell_notional + (request.side == Side::Buy ? 0 : notional);
+
+        const int64_t pending = ctx.working.worst_notional -
+                                std::max(working.buy_notional, working.sell_notional) +
+                                std::max(buy_notional, sell_notional);
+        const double capital = ctx.positions.capital_used() + static_cast<double>(pending) / PRICE_SCALE;
+        if (capital > ctx.limits.max_capital) [[unlikely]] {
+            return RiskCheckResult::CapitalLimitBreached;
+        }
+        return RiskCheckResult::Approved;
+    }
+};
+
+/// Global, per-instrument and per-exchange order rate (charges on pass).
+/// Risk runs before routing, so the exchange bucket is a request-tag bucket
+/// keyed on request.exchange, not on the venue the order is sent to.
+struct Rate {
+    static RiskCheckResult check(const RiskContext& ctx) noexcept {
+        if (!ctx.rate_limiter.try_acquire(ctx.request.instrument, ctx.request.exchange,
+                                          ThreadClock::now())) [[unlikely]] {
+            return RiskCheckResult::OrderRateExceeded;
+        }
+        return RiskCheckResult::Approved;
+    }
+};
+
+/// Price deviation from market in either direction, by multiplication:
+/// |order_price - market_price| > market_price * threshold
+struct FatFinger {
+    static constexpr RiskCheckResult REJECTS = RiskCheckResult::FatFingerPrice;
+    static bool rejects(const RiskContext& ctx) noexcept {
+        const double diff = static_cast<double>(std::abs(ctx.request.price - ctx.market_price));
+        return (ctx.market_price > 0) &
+               (diff > static_cast<double>(ctx.market_price) * ctx.price_deviation_threshold);
+    }
+};
+
+/// Notional of a single order (limits.max_order_notional dollars; 0 = off)
+struct MaxNotional {
+    static constexpr RiskCheckResult REJECTS = RiskCheckResult::NotionalTooLarge;
+    static bool rejects(const RiskContext& ctx) noexcept {
+        const double notional = static_cast<double>(ctx.request.quantity) *
+                                static_cast<double>(ctx.request.price) / PRICE_SCALE;
+        return (ctx.limits.max_order_notional > 0.0) & (notional > ctx.limits.max_order_notional);
+    }
+};
+
+/// One-sided collar (limits.price_collar_bps; 0 = off): buys may not pay more
+/// than market * (1 + collar), sells may not sell below market * (1 - collar)
+struct PriceCollar {
+    static constexpr RiskCheckResult REJECTS = RiskCheckResult::OutsidePriceCollar;
+    static bool rejects(const RiskContext& ctx) noexcept {
+        const double through = ctx.request.side == Side::Buy
+            ? static_cast<double>(ctx.request.price - ctx.market_price)
+            : static_cast<double>(ctx.market_price - ctx.request.price);
+        return (ctx.market_price > 0) & (ctx.price_collar_threshold > 0.0) &
+               (through > static_cast<double>(ctx.market_price) * ctx.price_collar_threshold);
+    }
+};
+
+} // namespace risk_checks
+
+/// Compile-time composition of checks, evaluated left to right, stopping at
+/// the first rejection. Expands to one straight-line function: no virtual
+/// calls, no loop, each check inlined in place.
+///
+/// Batches (RiskManager::check_orders_with) run the same checks in two passes
+/// over a chunk of up to MAX_CHUNK orders: reject_masks() evaluates every
+/// stateless check for the whole chunk (one branch-free loop each, into one
+/// bit per order), then check(ctx, masks, i) walks order i through the
+/// pipeline in precedence order, reading the stateless checks' bits.
+template<typename... Checks>
+struct RiskPipeline {
+    static_assert(sizeof...(Checks) > 0, "RiskPipeline needs at least one check");
+
+    static constexpr size_t MAX_CHUNK = 64;     // One bit per order in a uint64_t mask
+    using Masks = std::array<uint64_t, sizeof...(Checks)>;
+
+    __attribute__((always_inline))
+    static RiskCheckResult check(const RiskContext& ctx) noexcept {
+        RiskCheckResult result = RiskCheckResult::Approved;
+        (void)(((result = step<Checks>(ctx)) == RiskCheckResult::Approved) && ...);
+        return result;
+    }
+
+    /// Pass 1: masks[k] bit i set if the k-th check is stateless and rejects
+    /// order i, whose context is context_of(i). Stateful checks get 0.
+    template<typename ContextOf>
+    static Masks reject_masks(size_t count, ContextOf&& context_of) noexcept {
+        Masks masks{};
+        size_t k = 0;
+        ((masks[k++] = mask<Checks>(count, context_of)), ...);
+        return masks;
+    }
+
+    /// Pass 2: order i of the chunk
+    __attribute__((always_inline))
+    static RiskCheckResult check(const RiskContext& ctx, const Masks& masks, size_t i) noexcept {
+        RiskCheckResult result = RiskCheckResult::Approved;
+        size_t k = 0;
+        (void)(((result = step<Checks>(ctx, masks[k++], i)) == RiskCheckResult::Approved) && ...);
+        return result;
+    }
+
+private:
+    template<typename Check>
+    __attribute__((always_inline))
+    static RiskCheckResult step(const RiskContext& ctx) noexcept {
+        if constexpr (StatelessRiskCheck<Check>) {
+            if (Check::rejects(ctx)) [[unlikely]] return Check::REJECTS;
+            return RiskCheckResult::Approved;
+        } else {
+            return Check::check(ctx);
+        }
+    }
+
+    template<typename Check>
+    __attribute__((always_inline))
+    static RiskCheckResult step(const RiskContext& ctx, uint64_t mask, size_t i) noexcept {
+        if constexpr (StatelessRiskCheck<Check>) {
+            if ((mask >> i) & 1) [[unlikely]] return Check::REJECTS;
+            return RiskCheckResult::Approved;
+        } else {
+            return Check::check(ctx);
+        }
+    }
+
+    template<typename Check, typename ContextOf>
+    static uint64_t mask(size_t count, ContextOf& context_of) noexcept {
+        uint64_t bits = 0;
+        if constexpr (StatelessRiskCheck<Check>) {
+            for (size_t i = 0; i < count; ++i) {
+                bits |= static_cast<uint64_t>(Check::rejects(context_of(i))) << i;
+            }
+        }
+        return bits;
+    }
+};
+
+/// The checks RiskManager::check_order runs, in precedence order
+using DefaultRiskPipeline = RiskPipeline<risk_checks::KillSwitch, risk_checks::OrderSize,
+                                         risk_checks::Position, risk_checks::Capital,
+                                         risk_checks::Rate, risk_checks::FatFinger>;
+
+} // namespace trading
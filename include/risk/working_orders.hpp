@@ -0,0 +1,86 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "containers/flat_hash_map.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace trading {
+
+/// Working (sent, not yet terminal) orders as seen by the risk layer.
+/// - Per-instrument pending buy/sell quantity and notional (PRICE_SCALE units)
+///   in flat arrays, updated on send and on every ExecutionReport
+/// - Order id -> remaining quantity in a FlatHashMap, so each event is O(1)
+/// - worst_case_quantity()/worst_case_notional() sum each instrument's larger
+///   side, maintained incrementally: a two-sided quote counts once
+/// Replace requests are tracked under the new id; the original is dropped on
+/// the first report for the replacement (the venue pulls it silently).
+class WorkingOrders {
+public:
+    static constexpr size_t CAPACITY = 1 << 16;
+
+    struct Order {
+        InstrumentId instrument;
+        Side side;
+        OrderType type;
+        Price price;
+        Quantity leaves;
+        OrderId replaces;       // Original of a Replace, 0 otherwise
+    };
+
+    /// Working totals for one instrument; notionals in PRICE_SCALE units
+    struct Pending {
+        int64_t buy;
+        int64_t sell;
+        int64_t buy_notional;
+        int64_t sell_notional;
+    };
+
+    WorkingOrders() noexcept;
+
+    /// Record an order handed to execution. Cancels are ignored until their
+    /// report arrives. Returns false if the order cannot be tracked.
+    bool on_order_sent(const OrderRequest& request) noexcept;
+
+    /// Shrink or drop the order: New/PartiallyFilled leave report.leaves_quantity
+    /// working (limit orders only), Filled/Cancelled/Rejected end it.
+    void on_execution_report(const ExecutionReport& report) noexcept;
+
+    const Pending& pending(InstrumentId instrument) const noexcept {
+        static constexpr Pending NONE{};
+        return instrument < MAX_INSTRUMENTS ? pending_[instrument] : NONE;
+    }
+    int64_t pending_buy(InstrumentId instrument) const noexcept { return pending(instrument).buy; }
+    int64_t pending_sell(InstrumentId instrument) const noexcept { return pending(instrument).sell; }
+    int64_t pending_buy_notional(InstrumentId instrument) const noexcept { return pending(instrument).buy_notional; }
+    int64_t pending_sell_notional(InstrumentId instrument) const noexcept { return pending(instrument).sell_notional; }
+
+    /// Larger side of one instrument, and the sum over all instruments
+    int64_t worst_case_quantity(InstrumentId instrument) const noexcept {
+        return std::max(pending(instrument).buy, pending(instrument).sell);
+    }
+    int64_t worst_case_notional(InstrumentId instrument) const noexcept {
+        return std::max(pending(instrument).buy_notional, pending(instrument).sell_notional);
+    }
+    int64_t worst_case_quantity() const noexcept { return worst_quantity_; }
+    int64_t worst_case_notional() const noexcept { return worst_notional_; }
+
+    const Order* find(OrderId id) const noexcept { return orders_.find(id); }
+    size_t count() const noexcept { return orders_.size(); }
+
+    void reset() noexcept;
+
+private:
+    /// Add (or, negative, remove) working quantity at a price
+    void adjust(InstrumentId instrument, Side side, int64_t quantity, Price price) noexcept;
+    void drop(OrderId id) noexcept;
+
+    FlatHashMap<OrderId, Order, CAPACITY> orders_;
+
+    std::array<Pending, MAX_INSTRUMENTS> pending_;
+    int64_t worst_quantity_ = 0;
+    int64_t worst_notional_ = 0;
+};
+
+} // namespace trading
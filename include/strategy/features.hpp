@@ -0,0 +1,277 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading {
+
+/// Incremental signal features shared by strategies. Header-only, O(1) per
+/// update, no heap allocation.
+/// - Decayed features (Ema, EwmaVariance) take the window as a template
+///   argument; Window = 0 selects a runtime decay passed to the constructor
+/// - Rolling features (RollingMean, RollingVolatility, RollingVwap,
+///   RateOfChange) keep running sums over a fixed ring of Window samples
+/// - ema_update_batch / ewma_variance_update_batch update many instruments
+///   laid out as structure-of-arrays in one vectorizable loop
+
+/// Decay for an N-period EMA.
+constexpr double ema_alpha(size_t window) noexcept {
+    return 2.0 / (static_cast<double>(window) + 1.0);
+}
+
+/// Exponential moving average. The first sample seeds the average.
+template<size_t Window = 0>
+class Ema {
+public:
+    constexpr Ema() noexcept requires (Window > 0) : alpha_(ema_alpha(Window)) {}
+    explicit constexpr Ema(double alpha) noexcept requires (Window == 0) : alpha_(alpha) {}
+
+    void update(double x) noexcept {
+        value_ = (samples_ == 0) ? x : value_ + alpha_ * (x - value_);
+        ++samples_;
+    }
+
+    double value() const noexcept { return value_; }
+    double alpha() const noexcept { return alpha_; }
+    uint64_t samples() const noexcept { return samples_; }
+
+    void reset() noexcept { value_ = 0.0; samples_ = 0; }
+
+private:
+    double alpha_;
+    double value_ = 0.0;
+    uint64_t samples_ = 0;
+};
+
+/// Exponentially weighted mean and variance (West's incremental form).
+template<size_t Window = 0>
+class EwmaVariance {
+public:
+    constexpr EwmaVariance() noexcept requires (Window > 0) : alpha_(ema_alpha(Window)) {}
+    explicit constexpr EwmaVariance(double alpha) noexcept requires (Window == 0) : alpha_(alpha) {}
+
+    void update(double x) noexcept {
+        if (samples_++ == 0) {
+            mean_ = x;
+            return;
+        }
+        double diff = x - mean_;
+        mean_ += alpha_ * diff;
+        var_ = (1.0 - alpha_) * (var_ + alpha_ * diff * diff);
+    }
+
+    double mean() const noexcept { return mean_; }
+    double variance() const noexcept { return var_; }
+    double stddev() const noexcept { return std::sqrt(var_); }
+    uint64_t samples() const noexcept { return samples_; }
+
+    void reset() noexcept { mean_ = 0.0; var_ = 0.0; samples_ = 0; }
+
+private:
+    double alpha_;
+    double mean_ = 0.0;
+    double var_ = 0.0;
+    uint64_t samples_ = 0;
+};
+
+/// Ring of the last Window samples plus running sums of x and x^2.
+/// Sums are rebuilt from the ring once per wrap so rounding cannot drift.
+template<size_t Window>
+class RollingMoments {
+    static_assert(Window > 0, "Window must be > 0");
+
+public:
+    /// Push a sample; returns the evicted one (0.0 while filling).
+    double push(double x) noexcept {
+        double evicted = ring_[pos_];
+        ring_[pos_] = x;
+        if (++pos_ == Window) pos_ = 0;
+
+        if (count_ < Window) {
+            ++count_;
+            evicted = 0.0;
+            sum_ += x;
+            sum_sq_ += x * x;
+        } else if (pos_ == 0) {
+            rebuild();
+        } else {
+            sum_ += x - evicted;
+            sum_sq_ += x * x - evicted * evicted;
+        }
+        return evicted;
+    }
+
+    double mean() const noexcept {
+        return count_ > 0 ? sum_ / static_cast<double>(count_) : 0.0;
+    }
+
+    /// Population variance.
+    double variance() const noexcept {
+        if (count_ == 0) return 0.0;
+        double m = mean();
+        double v = sum_sq_ / static_cast<double>(count_) - m * m;
+        return v > 0.0 ? v : 0.0;
+    }
+
+    double sum() const noexcept { return sum_; }
+    size_t size() const noexcept { return count_; }
+    bool full() const noexcept { return count_ == Window; }
+    static constexpr size_t window() noexcept { return Window; }
+
+    void reset() noexcept { pos_ = 0; count_ = 0; sum_ = 0.0; sum_sq_ = 0.0; }
+
+private:
+    void rebuild() noexcept {
+        sum_ = 0.0;
+        sum_sq_ = 0.0;
+        for (double v : ring_) {
+            sum_ += v;
+            sum_sq_ += v * v;
+        }
+    }
+
+    std::array<double, Window> ring_{};
+    size_t pos_ = 0;
+    size_t count_ = 0;
+    double sum_ = 0.0;
+    double sum_sq_ = 0.0;
+};
+
+/// Simple moving average over the last Window samples.
+template<size_t Window>
+class RollingMean {
+public:
+    void update(double x) noexcept { moments_.push(x); }
+    double value() const noexcept { return moments_.mean(); }
+    size_t size() const noexcept { return moments_.size(); }
+    void reset() noexcept { moments_.reset(); }
+
+private:
+    RollingMoments<Window> moments_;
+};
+
+/// Realized volatility: stddev of simple returns over the last Window returns.
+template<size_t Window>
+class RollingVolatility {
+public:
+    void update(double price) noexcept {
+        if (last_price_ > 0.0) {
+            returns_.push((price - last_price_) / last_price_);
+        }
+        last_price_ = price;
+    }
+
+    double value() const noexcept { return std::sqrt(returns_.variance()); }
+    double mean_return() const noexcept { return returns_.mean(); }
+    /// Number of returns in the window.
+    size_t size() const noexcept { return returns_.size(); }
+    void reset() noexcept { returns_.reset(); last_price_ = 0.0; }
+
+private:
+    RollingMoments<Window> returns_;
+    double last_price_ = 0.0;
+};
+
+/// Volume-weighted average price over the last Window trades.
+template<size_t Window>
+class RollingVwap {
+    static_assert(Window > 0, "Window must be > 0");
+
+public:
+    void update(double price, double quantity) noexcept {
+        Entry& slot = ring_[pos_];
+        if (count_ == Window) {
+            notional_ -= slot.notional;
+            volume_ -= slot.quantity;
+        } else {
+            ++count_;
+        }
+        slot = {price * quantity, quantity};
+        notional_ += slot.notional;
+        volume_ += slot.quantity;
+        if (++pos_ == Window) {
+            pos_ = 0;
+            if (count_ == Window) rebuild();
+        }
+    }
+
+    double value() const noexcept { return volume_ > 0.0 ? notional_ / volume_ : 0.0; }
+    double volume() const noexcept { return volume_; }
+    size_t size() const noexcept { return count_; }
+    void reset() noexcept { pos_ = 0; count_ = 0; notional_ = 0.0; volume_ = 0.0; }
+
+private:
+    struct Entry {
+        double notional = 0.0;
+        double quantity = 0.0;
+    };
+
+    void rebuild() noexcept {
+        notional_ = 0.0;
+        volume_ = 0.0;
+        for (const Entry& e : ring_) {
+            notional_ += e.notional;
+            volume_ += e.quantity;
+        }
+    }
+
+    std::array<Entry, Window> ring_{};
+    size_t pos_ = 0;
+    size_t count_ = 0;
+    double notional_ = 0.0;
+    double volume_ = 0.0;
+};
+
+/// Rate of change over Window samples: (x_t - x_{t-Window}) / x_{t-Window}.
+/// Returns 0.0 until Window + 1 samples have been seen.
+template<size_t Window>
+class RateOfChange {
+    static_assert(Window > 0, "Window must be > 0");
+
+public:
+    void update(double x) noexcept {
+        double old = ring_[pos_];
+        ring_[pos_] = x;
+        if (++pos_ == Window) pos_ = 0;
+
+        if (count_ < Window) {
+            ++count_;
+            value_ = 0.0;
+        } else {
+            value_ = (old != 0.0) ? (x - old) / old : 0.0;
+        }
+    }
+
+    double value() const noexcept { return value_; }
+    void reset() noexcept { pos_ = 0; count_ = 0; value_ = 0.0; }
+
+private:
+    std::array<double, Window> ring_{};
+    size_t pos_ = 0;
+    size_t count_ = 0;
+    double value_ = 0.0;
+};
+
+/// Batch EMA update over n instruments: ema[i] += alpha * (x[i] - ema[i]).
+/// Callers seed ema[] (e.g. with the first observation) before the first call.
+inline void ema_update_batch(double* __restrict ema, const double* __restrict x,
+                             size_t n, double alpha) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        ema[i] += alpha * (x[i] - ema[i]);
+    }
+}
+
+/// Batch EWMA mean/variance update over n instruments.
+inline void ewma_variance_update_batch(double* __restrict mean, double* __restrict var,
+                                       const double* __restrict x, size_t n,
+                                       double alpha) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        double diff = x[i] - mean[i];
+        mean[i] += alpha * diff;
+        var[i] = (1.0 - alpha) * (var[i] + alpha * diff * diff);
+    }
+}
+
+} // namespace trading
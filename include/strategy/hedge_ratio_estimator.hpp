@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace trading {
+
+/// Online hedge ratio estimator for y = beta * x + alpha.
+/// Recursive least squares with exponential forgetting on EWMA-centred prices:
+/// the intercept is absorbed by the running means, so beta = cov(x, y) / var(x).
+/// O(1) per update, no buffers. Until enough samples have been seen (or while
+/// x has no variance) the initial beta is kept.
+class HedgeRatioEstimator {
+public:
+    HedgeRatioEstimator(double initial_beta, size_t window, size_t min_samples) noexcept
+        : beta_(initial_beta)
+        , lambda_(2.0 / (static_cast<double>(window) + 1.0))
+        , min_samples_(min_samples)
+    {}
+
+    void update(double x, double y) noexcept {
+        ++samples_;
+        if (samples_ == 1) {
+            mean_x_ = x;
+            mean_y_ = y;
+            return;
+        }
+
+        double dx = x - mean_x_;
+        double dy = y - mean_y_;
+        mean_x_ += lambda_ * dx;
+        mean_y_ += lambda_ * dy;
+        var_x_ = (1.0 - lambda_) * (var_x_ + lambda_ * dx * dx);
+        cov_xy_ = (1.0 - lambda_) * (cov_xy_ + lambda_ * dx * dy);
+
+        if (samples_ >= min_samples_ && var_x_ > MIN_VARIANCE) {
+            beta_ = cov_xy_ / var_x_;
+        }
+    }
+
+    double beta() const noexcept { return beta_; }
+    double alpha() const noexcept { return mean_y_ - beta_ * mean_x_; }
+    uint64_t samples() const noexcept { return samples_; }
+
+private:
+    static constexpr double MIN_VARIANCE = 1e-6;
+
+    double beta_;
+    double lambda_;
+    size_t min_samples_;
+    uint64_t samples_ = 0;
+    double mean_x_ = 0.0;
+    double mean_y_ = 0.0;
+    double var_x_ = 0.0;
+    double cov_xy_ = 0.0;
+};
+
+} // namespace trading
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "strategy/strategy_interface.hpp"
-#include "containers/circular_buffer.hpp"
+#include "strategy/quote_manager.hpp"
+#include "order_book/book_features.hpp"
+#include "strategy/features.hpp"
 
 namespace trading {
 
@@ -9,7 +11,12 @@ namespace trading {
 /// - Posts symmetric bid/ask around mid with dynamic spread
 /// - Adjusts spread based on rolling volatility
 /// - Skews quotes based on inventory
-/// - Flattens aggressively at inventory limits
+/// - Flattens aggressively at inventory limits: one working flatten order at
+///   the touch, held in the quote slot of its side (replaced as the touch
+///   or inventory moves, cancelled once back under the limit)
+/// - Keeps one live quote per side; amends via cancel/replace only when the
+///   target moves beyond tolerance (see QuoteManager)
+/// - Optionally centres quotes on the book microprice (see BookFeatures)
 class MarketMakerStrategy : public StrategyInterface {
 public:
     struct Params {
@@ -20,6 +27,9 @@ public:
         size_t volatility_window = 100;   // Rolling window for vol estimate
         InstrumentId instrument = 0;
         OrderId base_order_id = 100000;
+        Price requote_tolerance_ticks = 1;          // Price drift tolerated before replacing a quote
+        Quantity requote_size_tolerance = 0;        // Size drift tolerated before replacing a quote
+        Timestamp min_requote_interval_ns = 100'000; // Per-side rate shaping of amendments
     };
 
     explicit MarketMakerStrategy(const Params& params);
@@ -36,10 +46,17 @@ public:
 
     int inventory() const noexcept { return inventory_; }
     double current_spread_bps() const noexcept { return current_spread_bps_; }
+    const QuoteManager& quotes() const noexcept { return quotes_; }
+
+    /// Use the microprice of an incrementally maintained book as fair value
+    /// (nullptr reverts to mid). Not owned.
+    void set_book_features(const BookFeatures* features) noexcept { features_ = features; }
 
 private:
     void compute_fair_value();
     void compute_dynamic_spread();
+    void update_quote(Side side, Price price, Quantity quantity, Timestamp now);
+    void cancel_quote(Side side, Timestamp now);
 
     Params params_;
     int inventory_ = 0;
@@ -48,8 +65,12 @@ private:
     Price fair_value_ = 0;
     double current_spread_bps_ = 0.0;
     bool has_bbo_ = false;
+    bool flattening_ = false;      // A quote slot holds the flatten order
 
-    CircularBuffer<double, 256> mid_prices_;
+    QuoteManager quotes_;
+    const BookFeatures* features_ = nullptr;
+    // Realized vol of mid returns (255 returns = the previous 256-mid window)
+    RollingVolatility<255> volatility_;
 };
 
 } // namespace trading
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "strategy/strategy_interface.hpp"
-#include "containers/circular_buffer.hpp"
+#include "strategy/features.hpp"
 
 namespace trading {
 
@@ -32,19 +32,18 @@ public:
     void on_timer(Timestamp now) override;
     std::string_view name() const override { return "Momentum"; }
 
-    double fast_ema() const noexcept { return fast_ema_; }
-    double slow_ema() const noexcept { return slow_ema_; }
+    double fast_ema() const noexcept { return fast_ema_.value(); }
+    double slow_ema() const noexcept { return slow_ema_.value(); }
     double momentum_signal() const noexcept { return momentum_signal_; }
     int position() const noexcept { return position_; }
+    double avg_volume() const noexcept { return volumes_.value(); }
 
 private:
     void update_emas(double price);
 
     Params params_;
-    double fast_ema_ = 0.0;
-    double slow_ema_ = 0.0;
-    double fast_alpha_ = 0.0;
-    double slow_alpha_ = 0.0;
+    Ema<> fast_ema_;
+    Ema<> slow_ema_;
     double momentum_signal_ = 0.0;
     int position_ = 0;
     uint64_t tick_count_ = 0;
@@ -54,8 +53,7 @@ private:
     State state_ = State::Flat;
 
     // Volume tracking
-    CircularBuffer<Quantity, 256> volumes_;
-    double avg_volume_ = 0.0;
+    RollingMean<256> volumes_;
 };
 
 } // namespace trading
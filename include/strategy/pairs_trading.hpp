@@ -1,13 +1,17 @@
 #pragma once
 
 #include "strategy/strategy_interface.hpp"
-#include "containers/circular_buffer.hpp"
+#include "strategy/hedge_ratio_estimator.hpp"
 
 namespace trading {
 
 /// Pairs trading (statistical arbitrage) strategy:
 /// - Tracks spread between two instruments (A - hedge_ratio * B)
-/// - Computes rolling z-score
+/// - Hedge ratio estimated online (RLS with forgetting), or fixed. The ratio
+///   in use only moves while flat, once the estimate has drifted past
+///   hedge_retune_threshold; the spread statistics restart when it does, so a
+///   step in the ratio is never read as a move in the spread
+/// - Z-score from exponentially decayed spread mean/variance, O(1) per tick
 /// - Entry: |z| > entry_threshold → sell rich / buy cheap
 /// - Exit: |z| < exit_threshold → flatten both legs
 class PairsTradingStrategy : public StrategyInterface {
@@ -15,8 +19,12 @@ public:
     struct Params {
         InstrumentId instrument_a = 0;
         InstrumentId instrument_b = 1;
-        double hedge_ratio = 1.0;
-        size_t lookback_window = 100;
+        double hedge_ratio = 1.0;             // Fixed ratio, or initial estimate when dynamic
+        bool dynamic_hedge_ratio = true;
+        size_t hedge_window = 1000;           // Forgetting horizon of the hedge estimator
+        size_t min_hedge_samples = 50;        // Keep hedge_ratio until this many samples
+        double hedge_retune_threshold = 0.02; // Relative drift of the estimate that retunes the ratio
+        size_t lookback_window = 100;         // Decay horizon of spread mean/variance
         double entry_z_threshold = 2.0;
         double exit_z_threshold = 0.5;
         Quantity order_size = 10;
@@ -36,23 +44,38 @@ public:
     std::string_view name() const override { return "PairsTrading"; }
 
     double z_score() const noexcept { return z_score_; }
+    double hedge_ratio() const noexcept { return hedge_ratio_; }
+    double spread_mean() const noexcept { return spread_mean_; }
     int position_a() const noexcept { return position_a_; }
     int position_b() const noexcept { return position_b_; }
 
 private:
     void update_spread();
+    /// Take up the estimator's ratio if it has drifted far enough (flat only)
+    void retune_hedge_ratio() noexcept;
+    Quantity hedge_quantity() const noexcept;
+    /// Side of the B leg when A is traded on side_a (follows the sign of beta)
+    Side hedge_side(Side side_a) const noexcept;
+
+    static constexpr uint64_t MIN_SPREAD_SAMPLES = 20;
 
     Params params_;
     Price price_a_ = 0;
     Price price_b_ = 0;
     double z_score_ = 0.0;
+    double hedge_ratio_;
+    HedgeRatioEstimator hedge_estimator_;
     int position_a_ = 0;
     int position_b_ = 0;
 
     enum class State { Flat, LongSpread, ShortSpread };
     State state_ = State::Flat;
 
-    CircularBuffer<double, 512> spreads_;
+    // Exponentially decayed spread statistics
+    double spread_alpha_;
+    double spread_mean_ = 0.0;
+    double spread_var_ = 0.0;
+    uint64_t spread_samples_ = 0;
 };
 
 } // namespace trading
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "common/types.hpp"
+#include <array>
+
+namespace trading {
+
+/// Quote lifecycle manager: tracks the live bid and ask per instrument and
+/// decides whether a new target quote warrants touching the exchange.
+/// - New when the side has no live quote
+/// - Replace only when price or size drifted beyond tolerance
+/// - Per-side minimum interval between amendments (rate shaping)
+/// Flat arrays indexed by InstrumentId, no heap allocation.
+class QuoteManager {
+public:
+    struct Params {
+        Price price_tolerance = 1;              // Ticks the target may drift before requoting
+        Quantity size_tolerance = 0;            // Size drift allowed before requoting
+        Timestamp min_update_interval_ns = 0;   // Per-side throttle between amendments
+    };
+
+    enum class Action : uint8_t {
+        None = 0,
+        New = 1,
+        Replace = 2
+    };
+
+    struct Quote {
+        OrderId order_id = 0;
+        Price price = 0;
+        Quantity quantity = 0;
+        Timestamp last_update = 0;
+        bool live = false;
+        bool acked = false;
+    };
+
+    QuoteManager() noexcept = default;
+    explicit QuoteManager(const Params& params) noexcept : params_(params) {}
+
+    /// Decide what to do with a side given the desired price/size. Does not mutate state.
+    Action evaluate(InstrumentId instrument, Side side, Price price, Quantity quantity,
+                    Timestamp now) const noexcept;
+
+    /// Record that a New/Replace for this side was sent.
+    void on_quote_sent(InstrumentId instrument, Side side, OrderId order_id,
+                       Price price, Quantity quantity, Timestamp now) noexcept;
+
+    /// Record that a cancel for this side was sent; the side is no longer quoted.
+    void on_cancel_sent(InstrumentId instrument, Side side) noexcept;
+
+    /// Reconcile live quotes with exchange feedback.
+    void on_execution_report(const ExecutionReport& report) noexcept;
+
+    const Quote& quote(InstrumentId instrument, Side side) const noexcept {
+        return quotes_[instrument][static_cast<size_t>(side)];
+    }
+
+    uint64_t updates_sent() const noexcept { return updates_sent_; }
+    uint64_t cancels_sent() const noexcept { return cancels_sent_; }
+
+    void reset() noexcept;
+
+private:
+    Quote& slot(InstrumentId instrument, Side side) noexcept {
+        return quotes_[instrument][static_cast<size_t>(side)];
+    }
+
+    Params params_;
+    std::array<std::array<Quote, 2>, MAX_INSTRUMENTS> quotes_{};
+    uint64_t updates_sent_ = 0;
+    uint64_t cancels_sent_ = 0;
+};
+
+} // namespace trading
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "strategy/strategy_interface.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace trading {
+
+/// Multi-pair statistical arbitrage engine:
+/// - Shared per-instrument mid cache, written once per market data tick
+/// - Inverted index instrument -> pairs (CSR layout), so a tick only touches
+///   the pairs with a leg on the updated instrument
+/// - Pair state kept as structure-of-arrays; the z-score update is a
+///   branch-free loop over the affected pairs so it vectorizes
+/// - Spread mean/variance exponentially decayed, O(1) per pair per tick
+/// Pair positions are tracked at signal time (what was sent to enter),
+/// and flattened by sending the opposite quantities.
+class StatArbEngine : public StrategyInterface {
+public:
+    static constexpr size_t MAX_PAIRS = 4096;
+    static constexpr size_t MAX_ORDERS_PER_TICK = 64;
+    static constexpr uint32_t MIN_SPREAD_SAMPLES = 20;
+
+    struct PairConfig {
+        InstrumentId leg_a = 0;
+        InstrumentId leg_b = 1;
+        double hedge_ratio = 1.0;
+    };
+
+    struct Params {
+        size_t lookback_window = 100;       // Decay horizon of spread mean/variance
+        double entry_z_threshold = 2.0;
+        double exit_z_threshold = 0.5;
+        Quantity order_size = 10;
+        OrderId base_order_id = 400000;
+    };
+
+    explicit StatArbEngine(const Params& params);
+
+    /// Register a pair (setup only). Returns the pair index, or -1 if full/invalid.
+    int add_pair(const PairConfig& pair);
+
+    /// Build the instrument -> pairs index. Call once after all pairs are added.
+    void finalize();
+
+    void on_market_data(const MarketDataMessage& md) override;
+    void on_order_book_update(InstrumentId instrument,
+                               Price best_bid, Quantity bid_qty,
+                               Price best_ask, Quantity ask_qty) override;
+    void on_trade(const Trade& trade) override;
+    void on_execution_report(const ExecutionReport& report) override;
+    std::span<const OrderRequest> generate_orders() override;
+    void on_timer(Timestamp now) override;
+    std::string_view name() const override { return "StatArb"; }
+
+    size_t pair_count() const noexcept { return leg_a_.size(); }
+    double z_score(size_t pair) const noexcept { return z_[pair]; }
+    double spread_mean(size_t pair) const noexcept { return mean_[pair]; }
+    int pair_state(size_t pair) const noexcept { return state_[pair]; }
+    Price mid(InstrumentId instrument) const noexcept { return mids_[instrument]; }
+
+    /// Pairs touched by the most recent tick (cost of that tick)
+    size_t pairs_touched_last_tick() const noexcept { return last_touched_; }
+    size_t pending_pairs() const noexcept { return dirty_.size(); }
+
+private:
+    void on_mid(InstrumentId instrument, Price mid);
+    void update_pairs(const uint32_t* pairs, size_t count) noexcept;
+    void emit(InstrumentId instrument, Side side, Quantity quantity, Timestamp now);
+
+    Params params_;
+    double alpha_;
+    bool finalized_ = false;
+
+    // Shared mid cache
+    std::array<Price, MAX_INSTRUMENTS> mids_{};
+
+    // Inverted index (CSR): pairs of instrument i are
+    // index_pairs_[index_offsets_[i] .. index_offsets_[i + 1])
+    std::array<uint32_t, MAX_INSTRUMENTS + 1> index_offsets_{};
+    std::vector<uint32_t> index_pairs_;
+
+    // Pair state (structure-of-arrays)
+    std::vector<InstrumentId> leg_a_;
+    std::vector<InstrumentId> leg_b_;
+    std::vector<double> hedge_;
+    std::vector<double> mean_;
+    std::vector<double> var_;
+    std::vector<double> z_;
+    std::vector<uint32_t> samples_;
+    std::vector<int8_t> state_;         // 0 flat, +1 long spread, -1 short spread
+    std::vector<int64_t> entered_a_;    // Signed quantity sent on entry
+    std::vector<int64_t> entered_b_;
+    std::vector<uint8_t> dirty_flag_;
+
+    // Pairs updated since the last generate_orders()
+    std::vector<uint32_t> dirty_;
+    size_t last_touched_ = 0;
+
+    std::array<OrderRequest, MAX_ORDERS_PER_TICK> signal_buffer_{};
+};
+
+} // namespace trading
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/types.hpp"
+#include "common/clock.hpp"
 #include <span>
 #include <array>
 #include <string_view>
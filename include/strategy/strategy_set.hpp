@@ -0,0 +1,41 @@
+#pragma once
+
+#include "common/config.hpp"
+#include "strategy/market_maker.hpp"
+#include "strategy/pairs_trading.hpp"
+#include "strategy/momentum.hpp"
+#include <array>
+
+namespace trading {
+
+/// Strategy parameters as configured by SystemConfig. The live system and
+/// backtests both build their strategies from these, so a parameter is
+/// wired in one place only.
+MarketMakerStrategy::Params market_maker_params(const SystemConfig& config) noexcept;
+PairsTradingStrategy::Params pairs_params(const SystemConfig& config) noexcept;
+MomentumStrategy::Params momentum_params(const SystemConfig& config) noexcept;
+
+/// The standard strategy set: market maker and momentum on instrument 0,
+/// pairs on instruments 0/1. Ids are the strategies' halt scopes
+/// (KillSwitch, HaltScope::Strategy).
+struct StrategySet {
+    enum : StrategyId { MARKET_MAKER = 0, PAIRS = 1, MOMENTUM = 2 };
+    static constexpr size_t COUNT = 3;
+
+    explicit StrategySet(const SystemConfig& config)
+        : market_maker(market_maker_params(config))
+        , pairs(pairs_params(config))
+        , momentum(momentum_params(config)) {}
+
+    StrategySet(const StrategySet&) = delete;
+    StrategySet& operator=(const StrategySet&) = delete;
+
+    /// Indexed by strategy id
+    std::array<StrategyInterface*, COUNT> all() noexcept { return {&market_maker, &pairs, &momentum}; }
+
+    MarketMakerStrategy market_maker;
+    PairsTradingStrategy pairs;
+    MomentumStrategy momentum;
+};
+
+} // namespace trading
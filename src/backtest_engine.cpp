@@ -0,0 +1,393 @@
+#include "backtest/backtest_engine.hpp"
+#include "market_data/market_data_handler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+
+namespace trading {
+
+BacktestEngine::BacktestEngine(const BacktestConfig& config)
+    : config_(config)
+    , risk_(config.risk_limits)
+{
+    open_orders_.reserve(4096);
+    order_queue_.reserve(4096);
+    report_queue_.reserve(4096);
+}
+
+bool BacktestEngine::add_strategy(StrategyInterface* strategy) {
+    if (!strategy || num_strategies_ >= MAX_STRATEGIES) return false;
+    strategies_[num_strategies_++] = strategy;
+    return true;
+}
+
+void BacktestEngine::reset() {
+    market_.fill(MarketState{});
+    for (auto& b : books_) b.reset();
+    open_orders_.clear();
+    order_queue_.clear();
+    report_queue_.clear();
+    fills_.clear();
+    result_ = BacktestResult{};
+    next_exec_id_ = 1;
+    next_synthetic_id_ = SYNTHETIC_ID_BASE;
+
+    risk_.position_tracker().reset();
+    risk_.working_orders().reset();
+    risk_.kill_switch().clear();
+    risk_.set_peak_pnl(0.0);
+    risk_.reset_rate_counter();
+}
+
+BacktestResult BacktestEngine::run(std::span<const MarketDataMessage> events) {
+    Timestamp start = events.empty() ? 0 : events.front().timestamp;
+    SimulatedClockScope clock(start);
+    reset();
+
+    auto wall_start = std::chrono::steady_clock::now();
+
+    for (const MarketDataMessage& md : events) {
+        drain(md.timestamp);
+        on_event(md);
+    }
+    drain(std::numeric_limits<Timestamp>::max());
+
+    auto wall_end = std::chrono::steady_clock::now();
+
+    const PositionTracker& positions = risk_.position_tracker();
+    result_.events = events.size();
+    result_.realized_pnl = positions.realized_pnl();
+    result_.total_pnl = positions.total_pnl();
+    if (!events.empty()) {
+        result_.first_event_time = events.front().timestamp;
+        result_.last_event_time = events.back().timestamp;
+    }
+    result_.wall_seconds = std::chrono::duration<double>(wall_end - wall_start).count();
+    return result_;
+}
+
+void BacktestEngine::drain(Timestamp until) {
+    for (;;) {
+        bool order_due = !order_queue_.empty() && order_queue_.front().due <= until;
+        bool report_due = !report_queue_.empty() && report_queue_.front().due <= until;
+        if (!order_due && !report_due) return;
+
+        // Earliest first; an arrival and a report at the same instant: arrival first
+        if (order_due && (!report_due || order_queue_.front().due <= report_queue_.front().due)) {
+            auto item = order_queue_.front();
+            order_queue_.pop();
+            ThreadClock::set(item.due);
+            on_order_arrival(item.value, item.strategy, item.due);
+        } else {
+            auto item = report_queue_.front();
+            report_queue_.pop();
+            ThreadClock::set(item.due);
+            on_report_delivery(item.value, item.strategy);
+        }
+    }
+}
+
+void BacktestEngine::on_event(const MarketDataMessage& md) {
+    const Timestamp now = md.timestamp;
+    ThreadClock::set(now);
+
+    if (md.instrument < MAX_INSTRUMENTS) [[likely]] {
+        MarketState& m = market_[md.instrument];
+        m.bid = md.bid_price;
+        m.ask = md.ask_price;
+        m.bid_qty = md.bid_quantity;
+        m.ask_qty = md.ask_quantity;
+
+        if (md.bid_price > 0 && md.ask_price > 0) {
+            risk_.position_tracker().update_mark_price(md.instrument, (md.bid_price + md.ask_price) / 2);
+        }
+
+        const auto& b = books_[md.instrument];
+        if (b && b->order_count() > 0) {
+            match_passive(md.instrument, md);
+        }
+    }
+
+    for (size_t s = 0; s < num_strategies_; ++s) {
+        strategies_[s]->on_market_data(md);
+    }
+
+    Price market_price = (md.bid_price + md.ask_price) / 2;
+    for (size_t s = 0; s < num_strategies_; ++s) {
+        auto orders = strategies_[s]->generate_orders();
+        for (const OrderRequest& req : orders) {
+            if (config_.enable_risk_checks &&
+                risk_.check_order(req, market_price) != RiskCheckResult::Approved) [[unlikely]] {
+                ++result_.orders_rejected;
+                continue;
+            }
+            order_queue_.push(now + config_.order_latency_ns, static_cast<uint8_t>(s), req);
+            risk_.on_order_sent(req);
+            ++result_.orders_sent;
+        }
+    }
+}
+
+void BacktestEngine::on_order_arrival(const OrderRequest& request, uint8_t strategy, Timestamp now) {
+    if (request.instrument >= MAX_INSTRUMENTS) [[unlikely]] {
+        OpenOrder order{strategy, request.instrument, request.side, request.quantity, 0};
+        send_report(make_report(request.id, order, OrderStatus::Rejected, now), strategy, now);
+        return;
+    }
+
+    if (request.action != OrderAction::Cancel && open_orders_.contains(request.id)) [[unlikely]] {
+        // Same as OrderManager::open: a live id is never reused, the resting
+        // order keeps its queue position and leaves
+        ++result_.duplicate_ids;
+        OpenOrder order{strategy, request.instrument, request.side, request.quantity, 0};
+        send_report(make_report(request.id, order, OrderStatus::Rejected, now), strategy, now);
+        return;
+    }
+
+    switch (request.action) {
+        case OrderAction::New:
+            execute_new(request, strategy, now);
+            break;
+
+        case OrderAction::Cancel: {
+            auto it = open_orders_.find(request.orig_id);
+            if (it != open_orders_.end() && book(request.instrument).cancel_order(request.orig_id)) {
+                OpenOrder order = it->second;
+                open_orders_.erase(it);
+                send_report(make_report(request.orig_id, order, OrderStatus::Cancelled, now), strategy, now);
+            } else {
+                OpenOrder order{strategy, request.instrument, request.side, request.quantity, 0};
+                send_report(make_report(request.orig_id, order, OrderStatus::Rejected, now), strategy, now);
+            }
+            break;
+        }
+
+        case OrderAction::Replace: {
+            // Same as ExchangeSimulator: the original is pulled silently,
+            // the replacement is reported under its own id
+            auto it = open_orders_.find(request.orig_id);
+            if (it == open_orders_.end() || !book(request.instrument).cancel_order(request.orig_id)) {
+                OpenOrder order{strategy, request.instrument, request.side, request.quantity, 0};
+                send_report(make_report(request.id, order, OrderStatus::Rejected, now), strategy, now);
+                break;
+            }
+            open_orders_.erase(it);
+            execute_new(request, strategy, now);
+            break;
+        }
+    }
+}
+
+void BacktestEngine::execute_new(const OrderRequest& request, uint8_t strategy, Timestamp now) {
+    OpenOrder& order = open_orders_[request.id];
+    order = OpenOrder{strategy, request.instrument, request.side, request.quantity, request.quantity,
+                      request.price};
+
+    // Take displayed liquidity when marketable
+    MarketState& m = market_[request.instrument];
+    const bool is_market = request.type == OrderType::Market;
+    Price touch = (request.side == Side::Buy) ? m.ask : m.bid;
+    Quantity& available = (request.side == Side::Buy) ? m.ask_qty : m.bid_qty;
+    bool marketable = touch > 0 && available > 0 &&
+        (is_market || (request.side == Side::Buy ? request.price >= touch : request.price <= touch));
+
+    if (request.type == OrderType::FOK && (!marketable || available < request.quantity)) {
+        send_report(make_report(request.id, order, OrderStatus::Cancelled, now), strategy, now);
+        open_orders_.erase(request.id);
+        return;
+    }
+
+    if (marketable) {
+        Quantity qty = std::min(request.quantity, available);
+        available -= qty;
+        fill(request.id, touch, qty, true, now); // May erase the open order
+    }
+
+    auto it = open_orders_.find(request.id);
+    if (it == open_orders_.end()) return; // Fully filled
+
+    if (request.type != OrderType::Limit) {
+        // IOC / Market remainder is cancelled
+        send_report(make_report(request.id, it->second, OrderStatus::Cancelled, now), strategy, now);
+        open_orders_.erase(it);
+        return;
+    }
+
+    // Rest the remainder; acknowledge unless already partially filled
+    prevent_self_trade(request, strategy, now);
+    Quantity leaves = it->second.leaves;
+    if (leaves == request.quantity) {
+        send_report(make_report(request.id, it->second, OrderStatus::New, now), strategy, now);
+    }
+    auto trades = book(request.instrument).add_order(request.id, request.side, OrderType::Limit,
+                                                     request.price, leaves, now);
+    apply_trades(trades, now);
+}
+
+void BacktestEngine::prevent_self_trade(const OrderRequest& request, uint8_t strategy, Timestamp now) {
+    OrderBook& b = book(request.instrument);
+    const bool buy = request.side == Side::Buy;
+    if ((buy ? b.best_ask_quantity() : b.best_bid_quantity()) == 0) return;
+    const Price opposite = buy ? b.best_ask() : b.best_bid();
+    if (buy ? request.price < opposite : request.price > opposite) return; // Does not cross our book
+
+    // Rare (an internal cross), so a scan of the open orders is fine
+    for (auto it = open_orders_.begin(); it != open_orders_.end();) {
+        const OpenOrder& order = it->second;
+        const bool crossed = order.strategy == strategy && order.instrument == request.instrument &&
+            order.side != request.side && (buy ? order.price <= request.price : order.price >= request.price);
+        if (crossed && b.cancel_order(it->first)) {
+            send_report(make_report(it->first, order, OrderStatus::Cancelled, now), strategy, now);
+            ++result_.self_trades_prevented;
+            it = open_orders_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void BacktestEngine::match_passive(InstrumentId instrument, const MarketDataMessage& md) {
+    OrderBook& b = *books_[instrument];
+    MarketState& m = market_[instrument];
+    const Timestamp now = md.timestamp;
+
+    // Market ask at or through our bid: the displayed sellers trade with us
+    if (m.ask > 0 && m.ask_qty > 0 && b.best_bid_quantity() > 0 && b.best_bid() >= m.ask) {
+        auto trades = b.add_order(next_synthetic_id_++, Side::Sell, OrderType::IOC, m.ask, m.ask_qty, now);
+        for (const Trade& t : trades) m.ask_qty -= t.quantity;
+        apply_trades(trades, now);
+    }
+    if (m.bid > 0 && m.bid_qty > 0 && b.best_ask_quantity() > 0 && b.best_ask() <= m.bid) {
+        auto trades = b.add_order(next_synthetic_id_++, Side::Buy, OrderType::IOC, m.bid, m.bid_qty, now);
+        for (const Trade& t : trades) m.bid_qty -= t.quantity;
+        apply_trades(trades, now);
+    }
+
+    // Trade printed through our price
+    if (md.last_price > 0 && md.last_quantity > 0) {
+        if (b.best_bid_quantity() > 0 && md.last_price < b.best_bid()) {
+            apply_trades(b.add_order(next_synthetic_id_++, Side::Sell, OrderType::IOC,
+                                     md.last_price, md.last_quantity, now), now);
+        } else if (b.best_ask_quantity() > 0 && md.last_price > b.best_ask()) {
+            apply_trades(b.add_order(next_synthetic_id_++, Side::Buy, OrderType::IOC,
+                                     md.last_price, md.last_quantity, now), now);
+        }
+    }
+}
+
+void BacktestEngine::apply_trades(std::span<Trade> trades, Timestamp now) {
+    for (const Trade& t : trades) {
+        // Synthetic ids are not in open_orders_, so only our side(s) report
+        fill(t.buyer_order_id, t.price, t.quantity, false, now);
+        fill(t.seller_order_id, t.price, t.quantity, false, now);
+    }
+}
+
+void BacktestEngine::fill(OrderId order_id, Price price, Quantity quantity, bool aggressive, Timestamp now) {
+    auto it = open_orders_.find(order_id);
+    if (it == open_orders_.end()) return;
+
+    OpenOrder& order = it->second;
+    order.leaves -= quantity;
+
+    ExecutionReport report = make_report(order_id, order,
+        order.leaves == 0 ? OrderStatus::Filled : OrderStatus::PartiallyFilled, now);
+    report.price = price;
+    report.filled_quantity = quantity;
+    send_report(report, order.strategy, now);
+
+    ++result_.fills;
+    result_.filled_quantity += quantity;
+    if (config_.record_fills) {
+        fills_.push_back({now, order_id, order.instrument, order.side, aggressive, price, quantity});
+    }
+
+    if (order.leaves == 0) {
+        open_orders_.erase(it);
+    }
+}
+
+void BacktestEngine::send_report(const ExecutionReport& report, uint8_t strategy, Timestamp now) {
+    report_queue_.push(now + config_.report_latency_ns, strategy, report);
+}
+
+ExecutionReport BacktestEngine::make_report(OrderId order_id, const OpenOrder& order,
+                                            OrderStatus status, Timestamp now) noexcept {
+    ExecutionReport report{};
+    report.order_id = order_id;
+    report.exec_id = next_exec_id_++;
+    report.instrument = order.instrument;
+    report.side = order.side;
+    report.status = status;
+    report.quantity = order.quantity;
+    report.leaves_quantity = order.leaves;
+    report.timestamp = now;
+    report.exchange = 0;
+    return report;
+}
+
+void BacktestEngine::on_report_delivery(const ExecutionReport& report, uint8_t strategy) {
+    strategies_[strategy]->on_execution_report(report);
+    risk_.on_execution_report(report);
+
+    if (report.status == OrderStatus::Filled || report.status == OrderStatus::PartiallyFilled) {
+        PositionTracker& positions = risk_.position_tracker();
+        positions.on_fill(report.instrument, report.side, report.filled_quantity, report.price);
+        risk_.on_pnl_update(positions.total_pnl());
+    }
+}
+
+OrderBook& BacktestEngine::book(InstrumentId instrument) {
+    auto& b = books_[instrument];
+    if (!b) [[unlikely]] {
+        b = std::make_unique<OrderBook>(instrument);
+    }
+    return *b;
+}
+
+bool load_market_data_csv(const std::string& path, std::vector<MarketDataMessage>& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    if (!std::getline(file, line)) return false; // Header
+
+    size_t loaded = 0;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        // timestamp,instrument,bid,ask,bid_qty,ask_qty,last,last_qty
+        std::array<std::string_view, 8> fields;
+        std::string_view rest(line);
+        size_t n = 0;
+        for (; n < fields.size(); ++n) {
+            size_t comma = rest.find(',');
+            fields[n] = rest.substr(0, comma);
+            if (comma == std::string_view::npos) { ++n; break; }
+            rest.remove_prefix(comma + 1);
+        }
+        if (n < fields.size()) continue;
+
+        auto to_u64 = [](std::string_view s) { return std::strtoull(std::string(s).c_str(), nullptr, 10); };
+        auto to_price = [](std::string_view s) { return to_fixed_price(std::strtod(std::string(s).c_str(), nullptr)); };
+
+        MarketDataMessage md{};
+        md.timestamp = to_u64(fields[0]);
+        md.instrument = MarketDataHandler::symbol_to_id(fields[1]);
+        md.bid_price = to_price(fields[2]);
+        md.ask_price = to_price(fields[3]);
+        md.bid_quantity = to_u64(fields[4]);
+        md.ask_quantity = to_u64(fields[5]);
+        md.last_price = to_price(fields[6]);
+        md.last_quantity = to_u64(fields[7]);
+        md.msg_type = 'W';
+        out.push_back(md);
+        ++loaded;
+    }
+
+    return loaded > 0;
+}
+
+} // namespace trading
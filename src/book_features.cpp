@@ -0,0 +1,103 @@
+#include "order_book/book_features.hpp"
+#include <algorithm>
+
+namespace trading {
+
+BookFeatures::BookFeatures(const OrderBook& book, size_t levels) noexcept
+    : book_(book)
+    , levels_(std::clamp<size_t>(levels, 1, MAX_LEVELS))
+{}
+
+void BookFeatures::on_level_update(InstrumentId instrument, Side side,
+                                   Price price, Quantity total_quantity) {
+    if (instrument != book_.instrument()) return;
+    ++updates_;
+
+    SideCache& c = (side == Side::Buy) ? bids_ : asks_;
+
+    // Position of the level in priority order (bids descending, asks ascending)
+    size_t pos = 0;
+    if (side == Side::Buy) {
+        while (pos < c.count && c.price[pos] > price) ++pos;
+    } else {
+        while (pos < c.count && c.price[pos] < price) ++pos;
+    }
+
+    if (pos < c.count && c.price[pos] == price) {
+        if (total_quantity == 0) {
+            if (c.count == levels_) {
+                // A deeper level may move into the window
+                refresh(side);
+                return;
+            }
+            for (size_t i = pos; i + 1 < c.count; ++i) {
+                c.price[i] = c.price[i + 1];
+                c.quantity_at[i] = c.quantity_at[i + 1];
+            }
+            --c.count;
+            recompute(c);
+            return;
+        }
+
+        // Quantity change on a cached level: apply the delta
+        double delta = static_cast<double>(total_quantity) - static_cast<double>(c.quantity_at[pos]);
+        c.quantity = c.quantity - c.quantity_at[pos] + total_quantity;
+        c.weighted += delta * weight(pos);
+        c.quantity_at[pos] = total_quantity;
+        return;
+    }
+
+    // New level: ignore if it sorts behind a full window
+    if (total_quantity == 0 || pos >= levels_) return;
+
+    size_t last = std::min(c.count, levels_ - 1);
+    for (size_t i = last; i > pos; --i) {
+        c.price[i] = c.price[i - 1];
+        c.quantity_at[i] = c.quantity_at[i - 1];
+    }
+    c.price[pos] = price;
+    c.quantity_at[pos] = total_quantity;
+    c.count = std::min(c.count + 1, levels_);
+    recompute(c);
+}
+
+void BookFeatures::sync() noexcept {
+    refresh(Side::Buy);
+    refresh(Side::Sell);
+}
+
+double BookFeatures::microprice() const noexcept {
+    if (bids_.count == 0 || asks_.count == 0) return 0.0;
+
+    double bid_qty = static_cast<double>(bids_.quantity_at[0]);
+    double ask_qty = static_cast<double>(asks_.quantity_at[0]);
+    double total = bid_qty + ask_qty;
+    if (total <= 0.0) return 0.0;
+
+    return (static_cast<double>(bids_.price[0]) * ask_qty +
+            static_cast<double>(asks_.price[0]) * bid_qty) / total;
+}
+
+void BookFeatures::refresh(Side side) noexcept {
+    SideCache& c = (side == Side::Buy) ? bids_ : asks_;
+
+    std::array<OrderBook::DepthEntry, MAX_LEVELS> depth;
+    c.count = book_.get_side_depth(side, depth.data(), levels_);
+    for (size_t i = 0; i < c.count; ++i) {
+        c.price[i] = depth[i].price;
+        c.quantity_at[i] = depth[i].quantity;
+    }
+    recompute(c);
+    ++refreshes_;
+}
+
+void BookFeatures::recompute(SideCache& c) noexcept {
+    c.quantity = 0;
+    c.weighted = 0.0;
+    for (size_t i = 0; i < c.count; ++i) {
+        c.quantity += c.quantity_at[i];
+        c.weighted += static_cast<double>(c.quantity_at[i]) * weight(i);
+    }
+}
+
+} // namespace trading
@@ -1,6 +1,9 @@
 #include "common/config.hpp"
 #include <fstream>
 #include <sstream>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 
 namespace trading {
@@ -16,12 +19,22 @@ std::string trim(const std::string& s) {
     return s.substr(start, end - start + 1);
 }
 
-double parse_number(const std::string& s) {
-    return std::stod(s);
+// Non-throwing (release builds use -fno-exceptions): false unless the whole
+// string is a number
+bool parse_number(const std::string& s, double& out) {
+    char* end = nullptr;
+    double value = std::strtod(s.c_str(), &end);
+    if (end == s.c_str() || *end != '\0') return false;
+    out = value;
+    return true;
 }
 
-int parse_int(const std::string& s) {
-    return std::stoi(s);
+bool parse_int(const std::string& s, int& out) {
+    char* end = nullptr;
+    long value = std::strtol(s.c_str(), &end, 10);
+    if (end == s.c_str() || *end != '\0' || value < INT_MIN || value > INT_MAX) return false;
+    out = static_cast<int>(value);
+    return true;
 }
 
 } // anonymous namespace
@@ -30,10 +43,10 @@ SystemConfig default_config() {
     SystemConfig config;
 
     // Default exchange configs
-    config.exchanges[0] = {0, "SIM_NYSE", 500, 0.95, true};
-    config.exchanges[1] = {1, "SIM_NASDAQ", 300, 0.98, true};
-    config.exchanges[2] = {2, "SIM_BATS", 200, 0.92, true};
-    config.exchanges[3] = {3, "SIM_ARCA", 400, 0.90, true};
+    config.exchanges[0] = {0, "SIM_NYSE", 500, 0.95, true, 0.20};
+    config.exchanges[1] = {1, "SIM_NASDAQ", 300, 0.98, true, 0.20};
+    config.exchanges[2] = {2, "SIM_BATS", 200, 0.92, true, 0.15};
+    config.exchanges[3] = {3, "SIM_ARCA", 400, 0.90, true, 0.20};
     config.num_exchanges = 2;
 
     return config;
@@ -41,11 +54,16 @@ SystemConfig default_config() {
 
 SystemConfig load_config(const std::string& path) {
     SystemConfig config = default_config();
+    try_load_config(path, config); // Defaults for a missing file or bad values
+    return config;
+}
 
+bool try_load_config(const std::string& path, SystemConfig& config) {
     std::ifstream file(path);
     if (!file.is_open()) {
-        return config; // Return defaults if file not found
+        return false;
     }
+    bool ok = true;
 
     std::string content((std::istreambuf_iterator<char>(file)),
                         std::istreambuf_iterator<char>());
@@ -74,37 +92,58 @@ SystemConfig load_config(const std::string& path) {
 
     auto try_int = [&](const std::string& key, int& target) {
         std::string val = extract_value(key);
-        if (!val.empty()) target = parse_int(val);
+        if (val.empty()) return;
+        int parsed = 0;
+        if (!parse_int(val, parsed)) { ok = false; return; }
+        target = parsed;
     };
 
     auto try_size = [&](const std::string& key, size_t& target) {
         std::string val = extract_value(key);
-        if (!val.empty()) target = static_cast<size_t>(parse_int(val));
+        if (val.empty()) return;
+        int parsed = 0;
+        if (!parse_int(val, parsed)) { ok = false; return; }
+        target = static_cast<size_t>(parsed);
     };
 
     auto try_uint32 = [&](const std::string& key, uint32_t& target) {
         std::string val = extract_value(key);
-        if (!val.empty()) target = static_cast<uint32_t>(parse_int(val));
+        if (val.empty()) return;
+        int parsed = 0;
+        if (!parse_int(val, parsed)) { ok = false; return; }
+        target = static_cast<uint32_t>(parsed);
     };
 
     auto try_double = [&](const std::string& key, double& target) {
         std::string val = extract_value(key);
-        if (!val.empty()) target = parse_number(val);
+        if (val.empty()) return;
+        double parsed = 0;
+        if (!parse_number(val, parsed)) { ok = false; return; }
+        target = parsed;
     };
 
     auto try_int64 = [&](const std::string& key, int64_t& target) {
         std::string val = extract_value(key);
-        if (!val.empty()) target = static_cast<int64_t>(parse_number(val));
+        if (val.empty()) return;
+        double parsed = 0;
+        if (!parse_number(val, parsed)) { ok = false; return; }
+        target = static_cast<int64_t>(parsed);
     };
 
     auto try_quantity = [&](const std::string& key, Quantity& target) {
         std::string val = extract_value(key);
-        if (!val.empty()) target = static_cast<Quantity>(parse_number(val));
+        if (val.empty()) return;
+        double parsed = 0;
+        if (!parse_number(val, parsed)) { ok = false; return; }
+        target = static_cast<Quantity>(parsed);
     };
 
     auto try_uint64 = [&](const std::string& key, uint64_t& target) {
         std::string val = extract_value(key);
-        if (!val.empty()) target = static_cast<uint64_t>(parse_number(val));
+        if (val.empty()) return;
+        double parsed = 0;
+        if (!parse_number(val, parsed)) { ok = false; return; }
+        target = static_cast<uint64_t>(parsed);
     };
 
     // Core assignments
@@ -125,8 +164,12 @@ SystemConfig load_config(const std::string& path) {
     try_double("max_capital", config.risk_limits.max_capital);
     try_quantity("max_order_size", config.risk_limits.max_order_size);
     try_uint32("max_orders_per_second", config.risk_limits.max_orders_per_second);
+    try_uint32("max_orders_per_second_per_instrument", config.risk_limits.max_orders_per_second_per_instrument);
+    try_uint32("max_orders_per_second_per_exchange", config.risk_limits.max_orders_per_second_per_exchange);
     try_double("max_price_deviation_pct", config.risk_limits.max_price_deviation_pct);
     try_double("max_drawdown_pct", config.risk_limits.max_drawdown_pct);
+    try_double("max_order_notional", config.risk_limits.max_order_notional);
+    try_double("price_collar_bps", config.risk_limits.price_collar_bps);
 
     // Feed simulator
     try_double("feed_rate_msgs_per_sec", config.feed_rate_msgs_per_sec);
@@ -146,9 +189,22 @@ SystemConfig load_config(const std::string& path) {
 
     // Runtime
     try_uint64("simulation_duration_ms", config.simulation_duration_ms);
+    try_uint64("pnl_monitor_interval_us", config.pnl_monitor_interval_us);
 
     config.config_path = path;
-    return config;
+    return ok;
+}
+
+bool validate_risk_limits(const RiskLimits& limits) noexcept {
+    auto in_pct_range = [](double pct) { return pct > 0.0 && pct <= 100.0; };   // false for NaN
+    return limits.max_position_per_instrument > 0 &&
+           limits.max_total_position > 0 &&
+           limits.max_capital > 0.0 && std::isfinite(limits.max_capital) &&
+           limits.max_order_size > 0 &&
+           in_pct_range(limits.max_price_deviation_pct) &&
+           in_pct_range(limits.max_drawdown_pct) &&
+           limits.max_order_notional >= 0.0 && std::isfinite(limits.max_order_notional) &&
+           limits.price_collar_bps >= 0.0 && std::isfinite(limits.price_collar_bps);
 }
 
 } // namespace trading
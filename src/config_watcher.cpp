@@ -0,0 +1,73 @@
+#include "common/config_watcher.hpp"
+#include <system_error>
+
+namespace trading {
+
+ConfigWatcher::ConfigWatcher(std::string path, Callback on_change)
+    : path_(std::move(path))
+    , on_change_(std::move(on_change))
+    , seen_(stat())
+{
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+ConfigWatcher::Stamp ConfigWatcher::stat() const {
+    std::error_code ec;
+    Stamp stamp;
+    stamp.mtime = std::filesystem::last_write_time(path_, ec);
+    if (ec) return Stamp{};
+    stamp.size = std::filesystem::file_size(path_, ec);
+    if (ec) return Stamp{};
+    stamp.exists = true;
+    return stamp;
+}
+
+bool ConfigWatcher::poll() {
+    Stamp now = stat();
+    if (now == seen_) return false;
+    if (!now.exists) {
+        seen_ = now;    // Deleted or mid-rename: wait for it to reappear
+        return false;
+    }
+
+    SystemConfig config = default_config();
+    if (!try_load_config(path_, config)) {
+        // Half-written or malformed file: skip this version
+        seen_ = now;
+        parse_failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (!on_change_(config)) return false;  // Offer it again next poll
+    seen_ = now;
+    reloads_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ConfigWatcher::start(std::chrono::milliseconds interval) {
+    if (running_.exchange(true)) return;
+    thread_ = std::thread(&ConfigWatcher::run_loop, this, interval);
+}
+
+void ConfigWatcher::stop() {
+    running_.store(false, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ConfigWatcher::run_loop(std::chrono::milliseconds interval) {
+    constexpr auto SLICE = std::chrono::milliseconds(10);  // Bounds stop() latency
+    while (running_.load(std::memory_order_relaxed)) {
+        poll();
+        for (auto slept = std::chrono::milliseconds(0);
+             slept < interval && running_.load(std::memory_order_relaxed); slept += SLICE) {
+            std::this_thread::sleep_for(SLICE);
+        }
+    }
+}
+
+} // namespace trading
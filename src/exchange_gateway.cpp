@@ -0,0 +1,152 @@
+#include "execution/exchange_gateway.hpp"
+#include "common/utils.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace trading {
+
+namespace {
+
+/// OrdType (40) plus TimeInForce (59): IOC and FOK are limit orders with a TIF
+OrderType parse_order_type(const FixParser& message) noexcept {
+    if (message.get_field(40) == "1") return OrderType::Market;
+    std::string_view tif = message.get_field(59);
+    if (tif == "3") return OrderType::IOC;
+    if (tif == "4") return OrderType::FOK;
+    return OrderType::Limit;
+}
+
+} // anonymous namespace
+
+ExchangeGateway::ExchangeGateway(const ExchangeConfig& config)
+    : exchange_(config)
+    , session_(config.name, "CLIENT")
+{
+}
+
+ExchangeGateway::~ExchangeGateway() {
+    stop();
+    if (listen_fd_ >= 0) ::close(listen_fd_);
+}
+
+bool ExchangeGateway::listen(uint16_t port) {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) return false;
+    int one = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    socklen_t len = sizeof(addr);
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listen_fd_, 1) != 0 ||
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    port_ = ntohs(addr.sin_port);
+    return true;
+}
+
+void ExchangeGateway::start(int core_id) {
+    if (listen_fd_ < 0 || running_.exchange(true)) return;
+    thread_ = std::thread(&ExchangeGateway::run_loop, this, core_id);
+}
+
+void ExchangeGateway::stop() {
+    running_.store(false, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ExchangeGateway::run_loop(int core_id) {
+    pin_thread_to_core(core_id);
+
+    while (running_.load(std::memory_order_relaxed)) {
+        if (session_.fd() < 0) {
+            // Wait for a client; the timeout keeps stop() responsive
+            pollfd pending{listen_fd_, POLLIN, 0};
+            if (::poll(&pending, 1, 1) > 0) {
+                int fd = ::accept(listen_fd_, nullptr, nullptr);
+                if (fd >= 0) {
+                    session_.attach(fd);
+                    sessions_accepted_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            continue;
+        }
+
+        size_t handled = session_.poll([this](const FixParser& message) { on_message(message); });
+        session_.flush();   // All reports for this read in one write (the rest, if the client lags, next loop)
+        session_.service(ThreadClock::now());
+
+        if (handled == 0 && session_.fd() >= 0) {
+            // Idle: sleep in the kernel until the client sends something
+            // (or, with reports still queued, until it reads)
+            short events = session_.write_pending() ? POLLIN | POLLOUT : POLLIN;
+            pollfd readable{session_.fd(), events, 0};
+            ::poll(&readable, 1, 1);
+        }
+    }
+    session_.close();
+}
+
+void ExchangeGateway::on_message(const FixParser& message) {
+    std::string_view msg_type = message.msg_type();
+    if (msg_type != "D" && msg_type != "F" && msg_type != "G") return;
+    orders_received_.fetch_add(1, std::memory_order_relaxed);
+
+    OrderRequest request{};
+    request.id = message.get_uint(11);
+    request.instrument = static_cast<InstrumentId>(message.get_uint(55));
+    request.side = message.get_side();
+    request.exchange = exchange_.id();
+    request.timestamp = ThreadClock::now();
+
+    ExecutionReport report;
+    if (msg_type == "F") {
+        request.action = OrderAction::Cancel;
+        request.orig_id = message.get_uint(41);
+        report = exchange_.cancel_order(request.orig_id);
+        report.instrument = request.instrument;
+        report.side = request.side;
+    } else {
+        request.type = parse_order_type(message);
+        request.price = message.get_price();
+        request.quantity = message.get_quantity();
+        if (msg_type == "G") {
+            request.action = OrderAction::Replace;
+            request.orig_id = message.get_uint(41);
+            report = exchange_.replace_order(request);
+        } else {
+            report = exchange_.submit_order(request);
+        }
+    }
+    send_report(report, request.id);
+}
+
+void ExchangeGateway::send_report(const ExecutionReport& report, OrderId cl_ord_id) {
+    char status = to_fix_status(report.status);
+    FixSession::Writer writer = session_.begin("8");
+    writer.field(37, report.order_id)
+          .field(11, cl_ord_id)
+          .field(17, report.exec_id)
+          .field(150, status)
+          .field(39, status)
+          .field(55, static_cast<uint64_t>(report.instrument))
+          .field(54, report.side == Side::Buy ? '1' : '2')
+          .price(44, report.price)
+          .field(38, report.quantity)
+          .field(14, report.filled_quantity)
+          .field(151, report.leaves_quantity);
+    session_.send(writer);
+}
+
+} // namespace trading
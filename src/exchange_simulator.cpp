@@ -11,6 +11,7 @@ ExchangeSimulator::ExchangeSimulator(const ExchangeConfig& config)
 
 ExecutionReport ExchangeSimulator::submit_order(const OrderRequest& request) {
     ++orders_processed_;
+    last_fill_notional_ = 0;
 
     ExecutionReport report{};
     report.order_id = request.id;
@@ -18,7 +19,7 @@ ExecutionReport ExchangeSimulator::submit_order(const OrderRequest& request) {
     report.instrument = request.instrument;
     report.side = request.side;
     report.exchange = config_.id;
-    report.timestamp = now_ns() + config_.latency_ns; // Simulated latency
+    report.timestamp = ThreadClock::now() + config_.latency_ns; // Simulated latency
 
     // Check fill probability
     std::uniform_real_distribution<double> dist(0.0, 1.0);
@@ -43,6 +44,7 @@ ExecutionReport ExchangeSimulator::submit_order(const OrderRequest& request) {
         for (const auto& trade : trades) {
             total_filled += trade.quantity;
             last_fill_price = trade.price;
+            last_fill_notional_ += trade.price * static_cast<Price>(trade.quantity);
         }
 
         report.filled_quantity = total_filled;
@@ -78,7 +80,7 @@ ExecutionReport ExchangeSimulator::cancel_order(OrderId order_id) {
     report.order_id = order_id;
     report.exec_id = next_exec_id_++;
     report.exchange = config_.id;
-    report.timestamp = now_ns() + config_.latency_ns;
+    report.timestamp = ThreadClock::now() + config_.latency_ns;
 
     if (book_.cancel_order(order_id)) {
         report.status = OrderStatus::Cancelled;
@@ -89,15 +91,36 @@ ExecutionReport ExchangeSimulator::cancel_order(OrderId order_id) {
     return report;
 }
 
+ExecutionReport ExchangeSimulator::replace_order(const OrderRequest& request) {
+    if (!book_.cancel_order(request.orig_id)) {
+        last_fill_notional_ = 0;
+        ExecutionReport report{};
+        report.order_id = request.id;
+        report.exec_id = next_exec_id_++;
+        report.instrument = request.instrument;
+        report.side = request.side;
+        report.exchange = config_.id;
+        report.timestamp = ThreadClock::now() + config_.latency_ns;
+        report.status = OrderStatus::Rejected;
+        report.price = request.price;
+        report.quantity = request.quantity;
+        report.leaves_quantity = 0;
+        ++rejects_;
+        return report;
+    }
+    return submit_order(request);
+}
+
 void ExchangeSimulator::seed_book(Price mid_price, int levels, Quantity qty_per_level) {
     OrderId oid = 900000000;
+    Timestamp now = ThreadClock::now();
     for (int i = 1; i <= levels; ++i) {
         // Bids below mid
         book_.add_order(oid++, Side::Buy, OrderType::Limit,
-                        mid_price - i, qty_per_level, now_ns());
+                        mid_price - i, qty_per_level, now);
         // Asks above mid
         book_.add_order(oid++, Side::Sell, OrderType::Limit,
-                        mid_price + i, qty_per_level, now_ns());
+                        mid_price + i, qty_per_level, now);
     }
 }
 
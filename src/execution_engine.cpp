@@ -1,11 +1,16 @@
 #include "execution/execution_engine.hpp"
 #include "common/utils.hpp"
+#include <limits>
+#include <thread>
 
 namespace trading {
 
 ExecutionEngine::ExecutionEngine(InputQueue& input, OutputQueue& output)
     : input_(input), output_(output)
-{}
+{
+    set_rate_limit(10000);
+    router_.set_rate_limiter(&rate_limiter_);   // Exchange buckets: charged per venue routed to
+}
 
 void ExecutionEngine::add_exchange(const ExchangeConfig& config) {
     auto exchange = std::make_unique<ExchangeSimulator>(config);
@@ -17,20 +22,216 @@ void ExecutionEngine::set_routing_strategy(OrderRouter::RoutingStrategy strategy
     router_.set_routing_strategy(strategy);
 }
 
-ExecutionReport ExecutionEngine::process_order(const OrderRequest& request) {
-    if (!check_rate_limit()) {
+ExecutionReport ExecutionEngine::reject(const OrderRequest& request) const noexcept {
+    ExecutionReport report{};
+    report.order_id = request.id;
+    report.status = OrderStatus::Rejected;
+    report.timestamp = ThreadClock::now();
+    report.instrument = request.instrument;
+    report.side = request.side;
+    return report;
+}
+
+bool ExecutionEngine::admit(const OrderRequest& request) noexcept {
+    // A halt may land after the risk check; cancels always go through
+    if (halts_ && request.action != OrderAction::Cancel && halts_->blocks(request)) [[unlikely]] {
+        ++orders_halted_;
+        return false;
+    }
+
+    // Venue not picked yet: the exchange bucket is charged once it is
+    if (!rate_limiter_.try_acquire(request.instrument, ThreadClock::now())) [[unlikely]] {
         ++orders_throttled_;
-        ExecutionReport report{};
-        report.order_id = request.id;
-        report.status = OrderStatus::Rejected;
-        report.timestamp = now_ns();
-        report.instrument = request.instrument;
-        report.side = request.side;
-        return report;
+        return false;
     }
 
     ++orders_processed_;
-    return router_.route_order(request);
+    return true;
+}
+
+ExecutionReport ExecutionEngine::process_order(const OrderRequest& request) {
+    return route(request, nullptr);
+}
+
+ExecutionReport ExecutionEngine::route(const OrderRequest& request, OrderRouter::ChildReports* children) {
+    // Cancel-on-halt must see every resting order: refuse one it could not track
+    const bool untrackable = halts_ && request.action != OrderAction::Cancel &&
+                             working_.size() >= MAX_WORKING_ORDERS;
+    if (untrackable) [[unlikely]] ++working_overflows_;
+    if (untrackable || !admit(request)) [[unlikely]] {
+        if (children) children->count = 0;
+        return reject(request);
+    }
+
+    ExecutionReport report = router_.route_order(request, children);
+    if (halts_) track(request, report);     // Only needed for cancel-on-halt
+    return report;
+}
+
+bool ExecutionEngine::send_order(const OrderRequest& request) {
+    if (!can_send()) [[unlikely]] return false;
+
+    const Timestamp now = ThreadClock::now();
+    if (in_flight_.contains(request.id) ||
+        (request.action != OrderAction::Cancel && !orders_.open(request))) [[unlikely]] {
+        // Id already in flight or live, or no room to track it: never reaches
+        // a venue, and the live entry's round trip is left alone
+        schedule(reject(request), request.id, request.action, now, false);
+        return true;
+    }
+
+    in_flight_.insert(request.id, InFlight{now, request.action, 1});
+    if (transport_) {
+        // The report comes back off the wire; only local rejects are scheduled here.
+        // The session's venue is the exchange bucket to charge (cancels are free)
+        bool sent = admit(request);
+        if (sent && request.action != OrderAction::Cancel &&
+            !rate_limiter_.try_acquire_exchange(transport_->exchange(), now)) [[unlikely]] {
+            ++orders_throttled_;
+            sent = false;
+        }
+        if (!sent || !transport_->send_order(request)) [[unlikely]] {
+            schedule(reject(request), request.id, request.action, now);
+        }
+    } else {
+        ExecutionReport report = route(request, &child_reports_);
+        if (child_reports_.count == 0) {
+            schedule(report, request.id, request.action, now);
+        } else {
+            // Each child's report is due on its own venue's latency, priced at
+            // its fills' average so the parent rolls up the sweep's VWAP
+            for (size_t i = 0; i < child_reports_.count; ++i) {
+                ExecutionReport child = child_reports_.reports[i];
+                if (child.filled_quantity > 0) {
+                    child.price = child_reports_.notionals[i] / static_cast<Price>(child.filled_quantity);
+                }
+                orders_.open_child(request.id, child.order_id, child.exchange, child_reports_.quantities[i]);
+                schedule(child, request.id, request.action, now);
+            }
+            in_flight_.find(request.id)->outstanding = static_cast<uint16_t>(child_reports_.count);
+        }
+    }
+    if (in_flight_.size() > peak_in_flight_) peak_in_flight_ = in_flight_.size();
+    return true;
+}
+
+void ExecutionEngine::poll_transport(Timestamp now) {
+    transport_->flush();    // A full send buffer leaves the rest queued for the next loop
+    // Backpressure: leave replies in the socket until a full poll's worth fits
+    if (pending_room() >= REPORTS_PER_POLL) {
+        transport_->poll_reports([&](const ExecutionReport& report, OrderId cl_ord_id) {
+            const InFlight* sent = in_flight_.find(cl_ord_id);
+            schedule(report, cl_ord_id, sent ? sent->action : OrderAction::New, now);
+        });
+    }
+    transport_->service(now);
+}
+
+bool ExecutionEngine::schedule(const ExecutionReport& report, OrderId request_id, OrderAction action,
+                               Timestamp now, bool managed) {
+    // Venue reports carry now + latency; the engine's own rejects are due at once
+    Timestamp due = report.timestamp > now ? report.timestamp : now;
+    if (!pending_reports_.push(due, PendingReport{report, request_id, action, managed})) [[unlikely]] {
+        ++reports_overflowed_;
+        return false;
+    }
+    return true;
+}
+
+size_t ExecutionEngine::deliver_reports(Timestamp now) {
+    size_t delivered = 0;
+    ExecutionReport publish;
+    while (const PendingReport* pending = pending_reports_.peek_due(now)) {
+        if (output_.full()) break;      // Retry on the next call
+
+        OrderManager::ReportResult result = OrderManager::ReportResult::Untracked;
+        if (pending->managed) {
+            result = orders_.on_report(pending->report, pending->action, publish);
+        } else {
+            publish = pending->report;
+        }
+        if (result == OrderManager::ReportResult::Applied || result == OrderManager::ReportResult::Untracked) {
+            output_.try_push(publish);
+            ++delivered;
+        } else {
+            ++reports_dropped_;
+        }
+
+        InFlight* sent = pending->managed ? in_flight_.find(pending->request_id) : nullptr;
+        if (sent) {
+            Timestamp due = pending->report.timestamp > sent->sent ? pending->report.timestamp : sent->sent;
+            uint64_t round_trip = due - sent->sent;
+            round_trip_.record(round_trip);
+            round_trip_total_ns_ += round_trip;
+            ++round_trip_count_;
+            if (pending->report.exec_id != 0) {     // Venue reports only: local rejects carry none
+                router_.record_latency(pending->report.exchange, round_trip);
+                if (sent->action == OrderAction::New) {
+                    router_.record_fill_outcome(pending->report.exchange,
+                                                pending->report.status != OrderStatus::Rejected);
+                }
+            }
+            if (--sent->outstanding == 0) in_flight_.erase(pending->request_id);
+        }
+        pending_reports_.pop();
+    }
+    return delivered;
+}
+
+void ExecutionEngine::track(const OrderRequest& request, const ExecutionReport& report) noexcept {
+    if (request.action == OrderAction::Cancel) {
+        if (report.status == OrderStatus::Cancelled) working_.erase(request.orig_id);
+        return;
+    }
+    if (request.action == OrderAction::Replace && report.status != OrderStatus::Rejected) {
+        working_.erase(request.orig_id);
+    }
+
+    bool resting = (report.status == OrderStatus::New || report.status == OrderStatus::PartiallyFilled) &&
+                   report.leaves_quantity > 0;
+    if (resting) {
+        // route() refuses orders while the table is full, so this only fails if that bound breaks
+        if (!working_.insert(request.id, WorkingOrder{request.instrument, request.side,
+                                                      report.exchange, request.strategy})) [[unlikely]] {
+            ++working_overflows_;
+        }
+    } else {
+        working_.erase(request.id);
+    }
+}
+
+size_t ExecutionEngine::cancel_halted_orders() {
+    if (!halts_) return 0;
+    const KillSwitch::Snapshot halts = halts_->snapshot();
+
+    // Collect first: cancelling erases from the table being walked
+    cancel_scratch_.clear();
+    working_.for_each([&](OrderId id, const WorkingOrder& order) {
+        OrderRequest probe{};
+        probe.instrument = order.instrument;
+        probe.exchange = order.exchange;
+        probe.strategy = order.strategy;
+        if (halts.blocks(probe)) cancel_scratch_.push_back(id);
+    });
+
+    // Only cancel what the report queue can carry; the rest go on a later loop
+    const size_t room = pending_room();
+    halt_cancel_backlog_ = cancel_scratch_.size() > room;
+    if (halt_cancel_backlog_) cancel_scratch_.resize(room);
+
+    size_t cancelled = 0;
+    for (OrderId id : cancel_scratch_) {
+        const WorkingOrder order = *working_.find(id);
+        ExecutionReport report = router_.cancel_order(id);
+        report.instrument = order.instrument;
+        report.side = order.side;
+        // Rejected: no longer on the book (filled passively), forget it too
+        working_.erase(id);
+        cancelled += report.status == OrderStatus::Cancelled;
+        schedule(report, id, OrderAction::Cancel, ThreadClock::now());
+    }
+    halt_cancels_ += cancelled;
+    return cancelled;
 }
 
 void ExecutionEngine::start(int core_id) {
@@ -47,38 +248,59 @@ void ExecutionEngine::stop() {
 
 void ExecutionEngine::run_loop(int core_id) {
     pin_thread_to_core(core_id);
+    // One clock read per loop; routing and exchange stamps reuse it
+    ThreadClock::use_cached();
+
+    // Orders sent per loop before reports get another chance to go out
+    constexpr size_t SEND_BATCH = 64;
 
     while (running_.load(std::memory_order_relaxed)) {
+        poll_halts();
+        Timestamp now = ThreadClock::refresh();
+        if (transport_) poll_transport(now);    // One write for the last batch, then replies
+        deliver_reports(now);
+
         OrderRequest request;
-        if (input_.try_pop(request)) {
-            ExecutionReport report = process_order(request);
-            output_.try_push(report);
+        for (size_t i = 0; i < SEND_BATCH && can_send() && input_.try_pop(request); ++i) {
+            send_order(request);
         }
     }
 
-    // Drain remaining
+    // Drain remaining orders, then flush every report without waiting out latency
     OrderRequest request;
     while (input_.try_pop(request)) {
-        ExecutionReport report = process_order(request);
-        output_.try_push(report);
+        ThreadClock::refresh();
+        if (!send_order(request)) {
+            flush_reports();
+            send_order(request);
+        }
+    }
+    if (transport_) {
+        // Give the gateway a moment to answer what is still on the wire
+        const Timestamp deadline = ThreadClock::refresh() + SHUTDOWN_GRACE_NS;
+        while (in_flight_.size() > pending_reports_.size() && transport_->connected() &&
+               ThreadClock::refresh() < deadline) {
+            if (pending_room() < REPORTS_PER_POLL) deliver_reports(std::numeric_limits<Timestamp>::max());
+            poll_transport(ThreadClock::now());
+        }
     }
+    flush_reports();
 }
 
-bool ExecutionEngine::check_rate_limit() {
-    Timestamp now = now_ns();
-    constexpr Timestamp ONE_SECOND_NS = 1'000'000'000ULL;
-
-    if (now - rate_window_start_ >= ONE_SECOND_NS) {
-        rate_window_start_ = now;
-        orders_in_window_ = 0;
+void ExecutionEngine::flush_reports() {
+    constexpr Timestamp ALL = std::numeric_limits<Timestamp>::max();
+    const Timestamp deadline = ThreadClock::refresh() + SHUTDOWN_GRACE_NS;
+    while (pending_reports_.peek_due(ALL) && ThreadClock::refresh() < deadline) {
+        if (deliver_reports(ALL) == 0) std::this_thread::yield();  // Output full: wait for the consumer
     }
 
-    if (orders_in_window_ >= max_orders_per_sec_) {
-        return false;
+    // The consumer stopped reading: count what it will never see
+    while (const PendingReport* pending = pending_reports_.peek_due(ALL)) {
+        InFlight* sent = pending->managed ? in_flight_.find(pending->request_id) : nullptr;
+        if (sent && --sent->outstanding == 0) in_flight_.erase(pending->request_id);
+        ++reports_dropped_;
+        pending_reports_.pop();
     }
-
-    ++orders_in_window_;
-    return true;
 }
 
 void ExecutionEngine::seed_books(Price mid_price, int levels, Quantity qty_per_level) {
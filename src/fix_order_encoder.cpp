@@ -0,0 +1,188 @@
+#include "execution/fix_order_encoder.hpp"
+#include "common/clock.hpp"
+#include <cstring>
+#include <string>
+
+namespace trading {
+
+namespace {
+
+constexpr size_t SEQ_NUM_WIDTH = 20;         // Any uint64_t: never wraps
+constexpr size_t CL_ORD_ID_WIDTH = 20;       // Any uint64_t
+constexpr size_t SYMBOL_WIDTH = 10;          // Any uint32_t
+constexpr size_t QUANTITY_WIDTH = 12;
+constexpr size_t PRICE_INT_WIDTH = 10;
+constexpr size_t PRICE_WIDTH = PRICE_INT_WIDTH + 3;    // "NNNNNNNNNN.NN"
+static_assert(PRICE_SCALE == 100, "Price field renders two decimals");
+
+constexpr uint64_t MAX_QUANTITY = 999'999'999'999ULL;                   // QUANTITY_WIDTH nines
+constexpr Price MAX_PRICE = 9'999'999'999LL * PRICE_SCALE + (PRICE_SCALE - 1);
+
+/// "00".."99" and their digit sums, for rendering two digits per division
+struct DigitPairs {
+    char text[200];
+    uint8_t sum[100];
+
+    constexpr DigitPairs() : text{}, sum{} {
+        for (int i = 0; i < 100; ++i) {
+            text[2 * i] = static_cast<char>('0' + i / 10);
+            text[2 * i + 1] = static_cast<char>('0' + i % 10);
+            sum[i] = static_cast<uint8_t>(i / 10 + i % 10);
+        }
+    }
+};
+constexpr DigitPairs DIGIT_PAIRS{};
+
+/// Overwrite the low digits of a zero-padded field ending just before `end`.
+/// Returns what the written digits add to the byte sum (the template already
+/// counted a '0' in every position). The caller checks that value fits.
+inline uint32_t put_digits(char* end, uint64_t value, size_t width) noexcept {
+    uint32_t added = 0;
+    size_t n = 0;
+    for (; value >= 10 && n + 2 <= width; n += 2) {
+        auto pair = static_cast<uint32_t>(value % 100);
+        end -= 2;
+        std::memcpy(end, DIGIT_PAIRS.text + 2 * pair, 2);
+        added += DIGIT_PAIRS.sum[pair];
+        value /= 100;
+    }
+    if (value != 0 && n < width) {
+        auto digit = static_cast<uint32_t>(value % 10);
+        *--end = static_cast<char>('0' + digit);
+        added += digit;
+    }
+    return added;
+}
+
+inline uint32_t put_char(char* out, char c) noexcept {
+    *out = c;
+    return static_cast<unsigned char>(c);
+}
+
+} // anonymous namespace
+
+FixOrderEncoder::FixOrderEncoder(std::string_view sender_comp_id, std::string_view target_comp_id)
+    : templates_{build(OrderAction::New, sender_comp_id, target_comp_id),
+                 build(OrderAction::Cancel, sender_comp_id, target_comp_id),
+                 build(OrderAction::Replace, sender_comp_id, target_comp_id)}
+{
+}
+
+FixOrderEncoder::Template FixOrderEncoder::build(OrderAction action, std::string_view sender,
+                                                 std::string_view target) {
+    // Body first (offsets relative to it), then the header in front of it
+    enum Field { SeqNum, SendingTime, TransactTime, ClOrdId, OrigClOrdId, Symbol, SideField,
+                 Quantity, OrdType, PriceField, TimeInForce, FieldCount };
+    std::string body;
+    std::array<size_t, FieldCount> offsets{};
+    std::array<bool, FieldCount> present{};
+
+    auto fixed = [&](int tag, std::string_view value) {
+        body += std::to_string(tag);
+        body += '=';
+        body += value;
+        body += FixParser::DELIMITER;
+    };
+    auto variable = [&](int tag, Field field, size_t width) {
+        body += std::to_string(tag);
+        body += '=';
+        offsets[field] = body.size();
+        present[field] = true;
+        body.append(width, '0');
+        body += FixParser::DELIMITER;
+    };
+
+    const char* msg_type = action == OrderAction::Cancel ? "F" : action == OrderAction::Replace ? "G" : "D";
+    fixed(35, msg_type);
+    fixed(49, sender);
+    fixed(56, target);
+    variable(34, SeqNum, SEQ_NUM_WIDTH);
+    variable(52, SendingTime, UtcTimestamp::SIZE);
+    variable(11, ClOrdId, CL_ORD_ID_WIDTH);
+    if (action != OrderAction::New) variable(41, OrigClOrdId, CL_ORD_ID_WIDTH);
+    variable(55, Symbol, SYMBOL_WIDTH);
+    variable(54, SideField, 1);
+    if (action != OrderAction::Cancel) {
+        variable(38, Quantity, QUANTITY_WIDTH);
+        variable(40, OrdType, 1);
+        variable(44, PriceField, PRICE_WIDTH);
+        body[offsets[PriceField] + PRICE_INT_WIDTH] = '.';
+        variable(59, TimeInForce, 1);
+    }
+    variable(60, TransactTime, UtcTimestamp::SIZE);
+
+    std::string message = "8=FIX.4.4|9=" + std::to_string(body.size()) + "|";
+    const size_t header = message.size();
+    message += body;
+
+    Template t;
+    auto offset = [&](Field field) -> uint16_t {
+        return present[field] ? static_cast<uint16_t>(header + offsets[field]) : ABSENT;
+    };
+    t.seq_num = offset(SeqNum);
+    t.sending_time = offset(SendingTime);
+    t.transact_time = offset(TransactTime);
+    t.cl_ord_id = offset(ClOrdId);
+    t.orig_cl_ord_id = offset(OrigClOrdId);
+    t.symbol = offset(Symbol);
+    t.side = offset(SideField);
+    t.quantity = offset(Quantity);
+    t.ord_type = offset(OrdType);
+    t.price = offset(PriceField);
+    t.time_in_force = offset(TimeInForce);
+
+    // Checksum base: every byte but the ones encode() replaces wholesale
+    for (char c : message) t.fixed_sum += static_cast<unsigned char>(c);
+    t.fixed_sum -= 2 * UtcTimestamp::SIZE * '0';
+    t.fixed_sum -= (action == OrderAction::Cancel ? 1 : 3) * '0';   // Side (+ OrdType, TimeInForce)
+
+    message += "10=";
+    t.checksum = static_cast<uint16_t>(message.size());
+    message += "000";
+    message += FixParser::DELIMITER;
+
+    std::memcpy(t.bytes.data(), message.data(), message.size());
+    t.length = static_cast<uint16_t>(message.size());
+    return t;
+}
+
+size_t FixOrderEncoder::encode(const OrderRequest& request, uint64_t seq_num, char* out) noexcept {
+    const Template& t = templates_[static_cast<size_t>(request.action)];
+    if (t.quantity != ABSENT &&
+        (request.quantity > MAX_QUANTITY || request.price < 0 || request.price > MAX_PRICE)) [[unlikely]] {
+        return 0;   // Would not render as sent: refuse rather than put a different order on the wire
+    }
+    std::memcpy(out, t.bytes.data(), t.length);
+
+    uint32_t sum = t.fixed_sum;
+    sum += put_digits(out + t.seq_num + SEQ_NUM_WIDTH, seq_num, SEQ_NUM_WIDTH);
+    std::string_view now = clock_.update(ThreadClock::now());
+    std::memcpy(out + t.sending_time, now.data(), UtcTimestamp::SIZE);
+    std::memcpy(out + t.transact_time, now.data(), UtcTimestamp::SIZE);
+    sum += 2 * clock_.byte_sum();
+    sum += put_digits(out + t.cl_ord_id + CL_ORD_ID_WIDTH, request.id, CL_ORD_ID_WIDTH);
+    if (t.orig_cl_ord_id != ABSENT) {
+        sum += put_digits(out + t.orig_cl_ord_id + CL_ORD_ID_WIDTH, request.orig_id, CL_ORD_ID_WIDTH);
+    }
+    sum += put_digits(out + t.symbol + SYMBOL_WIDTH, request.instrument, SYMBOL_WIDTH);
+    sum += put_char(out + t.side, request.side == Side::Buy ? '1' : '2');
+
+    if (t.quantity != ABSENT) {
+        sum += put_digits(out + t.quantity + QUANTITY_WIDTH, request.quantity, QUANTITY_WIDTH);
+        sum += put_char(out + t.ord_type, request.type == OrderType::Market ? '1' : '2');
+        auto price = static_cast<uint64_t>(request.price);
+        sum += put_digits(out + t.price + PRICE_INT_WIDTH, price / PRICE_SCALE, PRICE_INT_WIDTH);
+        sum += put_digits(out + t.price + PRICE_WIDTH, price % PRICE_SCALE, 2);
+        char tif = request.type == OrderType::IOC ? '3' : request.type == OrderType::FOK ? '4' : '0';
+        sum += put_char(out + t.time_in_force, tif);
+    }
+
+    sum &= 0xFF;
+    char* checksum = out + t.checksum;
+    checksum[0] = static_cast<char>('0' + sum / 100);
+    checksum[1] = static_cast<char>('0' + sum / 10 % 10);
+    checksum[2] = static_cast<char>('0' + sum % 10);
+    return t.length;
+}
+
+} // namespace trading
@@ -0,0 +1,449 @@
+#include "execution/fix_session.hpp"
+#include "common/clock.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace trading {
+
+namespace {
+
+constexpr std::string_view BEGIN_STRING = "8=FIX.4.4|9=";
+
+uint64_t parse_uint(std::string_view sv) noexcept {
+    uint64_t value = 0;
+    for (char c : sv) {
+        if (c < '0' || c > '9') break;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return value;
+}
+
+size_t copy_comp_id(std::string_view id, std::array<char, 16>& out) noexcept {
+    size_t n = std::min(id.size(), out.size());
+    std::memcpy(out.data(), id.data(), n);
+    return n;
+}
+
+void put_2digits(char* out, int value) noexcept {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+} // anonymous namespace
+
+// --- UtcTimestamp ---
+
+std::string_view UtcTimestamp::update(Timestamp now) noexcept {
+    if (now >= next_sample_) [[unlikely]] {
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        int64_t wall = static_cast<int64_t>(ts.tv_sec) * 1'000'000'000LL + ts.tv_nsec;
+        wall_offset_ = wall - static_cast<int64_t>(now);
+        next_sample_ = now + 1'000'000'000ULL;
+    }
+    uint64_t wall_ms = static_cast<uint64_t>(static_cast<int64_t>(now) + wall_offset_) / 1'000'000;
+    if (wall_ms == millisecond_) return text();
+    millisecond_ = wall_ms;
+
+    char* out = text_.data();
+    uint64_t second = wall_ms / 1000;
+    if (second != second_) {
+        second_ = second;
+        std::time_t seconds = static_cast<std::time_t>(second);
+        std::tm utc;
+        gmtime_r(&seconds, &utc);
+        int year = utc.tm_year + 1900;
+        put_2digits(out, year / 100);
+        put_2digits(out + 2, year % 100);
+        put_2digits(out + 4, utc.tm_mon + 1);
+        put_2digits(out + 6, utc.tm_mday);
+        out[8] = '-';
+        put_2digits(out + 9, utc.tm_hour);
+        out[11] = ':';
+        put_2digits(out + 12, utc.tm_min);
+        out[14] = ':';
+        put_2digits(out + 15, utc.tm_sec);
+        out[17] = '.';
+        second_sum_ = 0;
+        for (size_t i = 0; i < 18; ++i) second_sum_ += static_cast<unsigned char>(out[i]);
+    }
+    int ms = static_cast<int>(wall_ms % 1000);
+    out[18] = static_cast<char>('0' + ms / 100);
+    put_2digits(out + 19, ms % 100);
+    byte_sum_ = second_sum_ + static_cast<unsigned char>(out[18]) +
+                static_cast<unsigned char>(out[19]) + static_cast<unsigned char>(out[20]);
+    return text();
+}
+
+// --- Writer ---
+
+void FixSession::Writer::put(std::string_view s) noexcept {
+    if (static_cast<size_t>(end_ - pos_) < s.size()) [[unlikely]] {
+        ok_ = false;
+        return;
+    }
+    std::memcpy(pos_, s.data(), s.size());
+    pos_ += s.size();
+}
+
+void FixSession::Writer::put(uint64_t value) noexcept {
+    char digits[20];
+    size_t n = 0;
+    do {
+        digits[sizeof(digits) - ++n] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    put(std::string_view(digits + sizeof(digits) - n, n));
+}
+
+void FixSession::Writer::put(char c) noexcept {
+    if (pos_ == end_) [[unlikely]] {
+        ok_ = false;
+        return;
+    }
+    *pos_++ = c;
+}
+
+FixSession::Writer& FixSession::Writer::field(int tag, std::string_view value) noexcept {
+    put(static_cast<uint64_t>(tag));
+    put('=');
+    put(value);
+    put(FixParser::DELIMITER);
+    return *this;
+}
+
+FixSession::Writer& FixSession::Writer::field(int tag, uint64_t value) noexcept {
+    put(static_cast<uint64_t>(tag));
+    put('=');
+    put(value);
+    put(FixParser::DELIMITER);
+    return *this;
+}
+
+FixSession::Writer& FixSession::Writer::field(int tag, char value) noexcept {
+    put(static_cast<uint64_t>(tag));
+    put('=');
+    put(value);
+    put(FixParser::DELIMITER);
+    return *this;
+}
+
+FixSession::Writer& FixSession::Writer::price(int tag, Price value) noexcept {
+    put(static_cast<uint64_t>(tag));
+    put('=');
+    if (value < 0) put('-');
+    uint64_t magnitude = value < 0 ? static_cast<uint64_t>(-value) : static_cast<uint64_t>(value);
+    put(magnitude / PRICE_SCALE);
+    put('.');
+    char cents[2];
+    put_2digits(cents, static_cast<int>(magnitude % PRICE_SCALE));
+    put(std::string_view(cents, 2));
+    put(FixParser::DELIMITER);
+    return *this;
+}
+
+// --- Session ---
+
+FixSession::FixSession(std::string_view sender_comp_id, std::string_view target_comp_id)
+    : sender_len_(copy_comp_id(sender_comp_id, sender_))
+    , target_len_(copy_comp_id(target_comp_id, target_))
+    , slots_(std::make_unique<char[]>((MAX_BATCH + 1) * MAX_MESSAGE_SIZE))   // + scratch for refused messages
+    , recv_buffer_(std::make_unique<char[]>(RECV_BUFFER_SIZE))
+{
+}
+
+FixSession::~FixSession() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void FixSession::attach(int fd) noexcept {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = fd;
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // Fails harmlessly on non-TCP
+
+    state_ = State::Connected;
+    next_out_seq_ = 1;
+    next_in_seq_ = 1;
+    last_sent_ = last_received_ = ThreadClock::now();
+    test_request_pending_ = false;
+    logout_sent_ = false;
+    queued_ = unsent_ = 0;
+    recv_begin_ = recv_end_ = 0;
+}
+
+void FixSession::close() noexcept {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    state_ = State::Closed;
+    queued_ = unsent_ = 0;
+    recv_begin_ = recv_end_ = 0;
+}
+
+bool FixSession::logon(uint32_t heartbeat_interval_s) noexcept {
+    if (state_ != State::Connected) return false;
+    heartbeat_ns_ = static_cast<Timestamp>(heartbeat_interval_s) * 1'000'000'000ULL;
+    Writer writer = begin("A");
+    writer.field(98, '0').field(108, static_cast<uint64_t>(heartbeat_interval_s));
+    if (!send(writer)) return false;
+    if (!flush() && fd_ < 0) return false;      // Otherwise the rest goes out on a later flush()
+    state_ = State::LogonSent;
+    return true;
+}
+
+void FixSession::logout() noexcept {
+    if (state_ != State::Active) {
+        close();
+        return;
+    }
+    send_session_message("5");
+    logout_sent_ = true;
+}
+
+FixSession::Writer FixSession::begin(std::string_view msg_type) noexcept {
+    // Still full after the flush (peer not reading): the message is built in
+    // the scratch slot past the batch and send() refuses it
+    if (queued_ == MAX_BATCH) flush();
+
+    char* slot = slots_.get() + queued_ * MAX_MESSAGE_SIZE;
+    Writer writer(slot + HEADER_RESERVE, slot + MAX_MESSAGE_SIZE - TRAILER_SIZE);
+    writer.field(35, msg_type)
+          .field(49, std::string_view(sender_.data(), sender_len_))
+          .field(56, std::string_view(target_.data(), target_len_))
+          .field(34, next_out_seq_)
+          .field(52, sending_time_.update(ThreadClock::now()));
+    return writer;
+}
+
+bool FixSession::send(Writer& writer) noexcept {
+    if (!writer.ok() || fd_ < 0 || queued_ == MAX_BATCH) [[unlikely]] return false;
+
+    char* body = slots_.get() + queued_ * MAX_MESSAGE_SIZE + HEADER_RESERVE;
+    size_t body_len = static_cast<size_t>(writer.pos_ - body);
+
+    // Header right-aligned against the body: "8=FIX.4.4|9=<len>|"
+    char digits[4];
+    size_t n = 0;
+    for (size_t len = body_len; n == 0 || len != 0; len /= 10) {
+        digits[sizeof(digits) - ++n] = static_cast<char>('0' + len % 10);
+    }
+    size_t header_len = BEGIN_STRING.size() + n + 1;
+    char* start = body - header_len;
+    std::memcpy(start, BEGIN_STRING.data(), BEGIN_STRING.size());
+    std::memcpy(start + BEGIN_STRING.size(), digits + sizeof(digits) - n, n);
+    start[header_len - 1] = FixParser::DELIMITER;
+
+    unsigned sum = 0;
+    for (const char* p = start; p != writer.pos_; ++p) sum += static_cast<unsigned char>(*p);
+    sum &= 0xFF;
+    char* trailer = writer.pos_;
+    trailer[0] = '1';
+    trailer[1] = '0';
+    trailer[2] = '=';
+    trailer[3] = static_cast<char>('0' + sum / 100);
+    put_2digits(trailer + 4, static_cast<int>(sum % 100));
+    trailer[6] = FixParser::DELIMITER;
+
+    iov_[queued_] = iovec{start, header_len + body_len + TRAILER_SIZE};
+    ++queued_;
+    ++next_out_seq_;
+    ++messages_sent_;
+    return true;
+}
+
+bool FixSession::flush() noexcept {
+    if (queued_ == 0) return true;
+    if (fd_ < 0) {
+        queued_ = unsent_ = 0;
+        return false;
+    }
+
+    // sendmsg: writev() with MSG_NOSIGNAL, so a vanished peer is an error, not SIGPIPE
+    msghdr msg{};
+    msg.msg_iov = iov_.data() + unsent_;
+    msg.msg_iovlen = queued_ - unsent_;
+    while (msg.msg_iovlen > 0) {
+        ssize_t written = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+        ++writev_calls_;
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // Send buffer full: keep the tail for the next flush() rather than spin
+                unsent_ = static_cast<size_t>(msg.msg_iov - iov_.data());
+                ++send_stalls_;
+                return false;
+            }
+            close();
+            return false;
+        }
+        last_sent_ = ThreadClock::now();
+        // Partial write: skip what went out and retry with the rest
+        size_t left = static_cast<size_t>(written);
+        while (msg.msg_iovlen > 0 && left >= msg.msg_iov->iov_len) {
+            left -= msg.msg_iov->iov_len;
+            ++msg.msg_iov;
+            --msg.msg_iovlen;
+        }
+        if (msg.msg_iovlen > 0) {
+            msg.msg_iov->iov_base = static_cast<char*>(msg.msg_iov->iov_base) + left;
+            msg.msg_iov->iov_len -= left;
+        }
+    }
+    queued_ = unsent_ = 0;
+    return true;
+}
+
+void FixSession::receive() noexcept {
+    if (fd_ < 0) return;
+    ssize_t n = ::recv(fd_, recv_buffer_.get() + recv_end_, RECV_BUFFER_SIZE - recv_end_, MSG_DONTWAIT);
+    if (n > 0) {
+        recv_end_ += static_cast<size_t>(n);
+        last_received_ = ThreadClock::now();
+        test_request_pending_ = false;
+    } else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        // Peer gone: what is already buffered is still handed out
+        ::close(fd_);
+        fd_ = -1;
+        state_ = State::Closed;
+    }
+}
+
+bool FixSession::next_application_message() noexcept {
+    for (;;) {
+        const char* data = recv_buffer_.get() + recv_begin_;
+        size_t available = recv_end_ - recv_begin_;
+        if (available < BEGIN_STRING.size()) return false;
+        if (std::memcmp(data, BEGIN_STRING.data(), BEGIN_STRING.size()) != 0) [[unlikely]] {
+            close();    // Lost framing: nothing after this can be trusted
+            return false;
+        }
+
+        size_t i = BEGIN_STRING.size();
+        size_t body_len = 0;
+        while (i < available && data[i] >= '0' && data[i] <= '9' && i < BEGIN_STRING.size() + 4) {
+            body_len = body_len * 10 + static_cast<size_t>(data[i] - '0');
+            ++i;
+        }
+        if (i == available) return false;   // Length still arriving
+        if (data[i] != FixParser::DELIMITER || i == BEGIN_STRING.size() ||
+            body_len > MAX_MESSAGE_SIZE) [[unlikely]] {
+            close();
+            return false;
+        }
+        size_t checked_len = i + 1 + body_len;
+        size_t total = checked_len + TRAILER_SIZE;
+        if (available < total) return false;  // Wait for the rest
+
+        const char* trailer = data + checked_len;
+        if (std::memcmp(trailer, "10=", 3) != 0 || trailer[6] != FixParser::DELIMITER) [[unlikely]] {
+            close();
+            return false;
+        }
+        unsigned sum = 0;
+        for (size_t j = 0; j < checked_len; ++j) sum += static_cast<unsigned char>(data[j]);
+        recv_begin_ += total;
+        if ((sum & 0xFF) != parse_uint(std::string_view(trailer + 3, 3))) [[unlikely]] {
+            ++checksum_errors_;     // Garbled: drop it, keep the session
+            continue;
+        }
+
+        ++messages_received_;
+        if (!parser_.parse(std::string_view(data, total))) continue;
+
+        uint64_t seq = parser_.get_uint(34);
+        if (seq < next_in_seq_) {
+            ++duplicates_;
+            continue;
+        }
+        if (seq > next_in_seq_) ++sequence_gaps_;
+        next_in_seq_ = seq + 1;
+
+        if (handle_session_message(parser_.msg_type())) {
+            if (fd_ < 0) return false;      // Logout closed the session
+            continue;
+        }
+        if (state_ != State::Active) continue;  // Application data before Logon
+        return true;
+    }
+}
+
+bool FixSession::handle_session_message(std::string_view msg_type) noexcept {
+    if (msg_type.size() != 1) return false;
+    switch (msg_type[0]) {
+        case 'A': {
+            uint64_t interval_s = parser_.get_uint(108);
+            if (state_ == State::Connected) {
+                // Acceptor: adopt the initiator's interval and answer
+                if (interval_s > 0) heartbeat_ns_ = interval_s * 1'000'000'000ULL;
+                Writer writer = begin("A");
+                writer.field(98, '0').field(108, interval_s);
+                send(writer);
+                flush();
+            }
+            state_ = State::Active;
+            return true;
+        }
+        case '0':   // Heartbeat: receive() already noted the traffic
+            return true;
+        case '1':
+            send_session_message("0", 112, parser_.get_field(112));
+            return true;
+        case '2':   // ResendRequest: nothing is stored, so nothing to resend
+            return true;
+        case '4': { // SequenceReset: jump to NewSeqNo
+            uint64_t new_seq = parser_.get_uint(36);
+            if (new_seq > next_in_seq_) next_in_seq_ = new_seq;
+            return true;
+        }
+        case '5':
+            if (!logout_sent_) send_session_message("5");
+            close();
+            return true;
+        default:
+            return false;
+    }
+}
+
+void FixSession::send_session_message(std::string_view msg_type, int tag, std::string_view value) noexcept {
+    Writer writer = begin(msg_type);
+    if (tag != 0) writer.field(tag, value);
+    send(writer);
+    flush();
+}
+
+void FixSession::compact() noexcept {
+    if (recv_begin_ == 0) return;
+    size_t remaining = recv_end_ - recv_begin_;
+    if (remaining > 0) {
+        std::memmove(recv_buffer_.get(), recv_buffer_.get() + recv_begin_, remaining);
+    }
+    recv_begin_ = 0;
+    recv_end_ = remaining;
+}
+
+void FixSession::service(Timestamp now) noexcept {
+    if (state_ != State::Active) return;
+    Timestamp silent = now > last_received_ ? now - last_received_ : 0;
+    if (silent >= 3 * heartbeat_ns_) {
+        close();    // Peer presumed dead
+        return;
+    }
+    if (!test_request_pending_ && silent >= heartbeat_ns_ + heartbeat_ns_ / 2) {
+        send_session_message("1", 112, "TEST");
+        test_request_pending_ = true;
+    }
+    if (now > last_sent_ && now - last_sent_ >= heartbeat_ns_) {
+        send_session_message("0");
+    }
+}
+
+} // namespace trading
@@ -0,0 +1,78 @@
+#include "execution/gateway_transport.hpp"
+#include "common/clock.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace trading {
+
+GatewayTransport::GatewayTransport(ExchangeId exchange, std::string_view sender_comp_id,
+                                   std::string_view target_comp_id)
+    : exchange_(exchange)
+    , session_(sender_comp_id, target_comp_id)
+    , encoder_(sender_comp_id, target_comp_id)
+{
+}
+
+bool GatewayTransport::connect(uint16_t port, std::chrono::milliseconds timeout, uint32_t heartbeat_interval_s) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    session_.attach(fd);
+    if (!session_.logon(heartbeat_interval_s)) return false;
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!session_.active()) {
+        session_.poll([](const FixParser&) {});
+        if (session_.fd() < 0 || std::chrono::steady_clock::now() > deadline) {
+            session_.close();
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void GatewayTransport::disconnect() noexcept {
+    session_.logout();
+    session_.close();
+}
+
+bool GatewayTransport::send_order(const OrderRequest& request) noexcept {
+    if (!session_.active()) [[unlikely]] return false;
+    return session_.send_rendered([&](char* out, uint64_t seq_num) {
+        return encoder_.encode(request, seq_num, out);
+    });
+}
+
+ExecutionReport GatewayTransport::decode_report(const FixParser& message, OrderId& cl_ord_id) const noexcept {
+    cl_ord_id = message.get_uint(11);
+
+    ExecutionReport report{};
+    report.order_id = message.get_uint(37);
+    report.exec_id = message.get_uint(17);
+    report.instrument = static_cast<InstrumentId>(message.get_uint(55));
+    report.side = message.get_side();
+    std::string_view status = message.get_field(39);
+    report.status = from_fix_status(status.empty() ? '8' : status[0]);
+    report.price = message.get_price();
+    report.quantity = message.get_quantity();
+    report.filled_quantity = message.get_uint(14);
+    report.leaves_quantity = message.get_uint(151);
+    report.timestamp = ThreadClock::now();
+    report.exchange = exchange_;
+    return report;
+}
+
+} // namespace trading
@@ -0,0 +1,111 @@
+#include "monitoring/latency_estimator.hpp"
+#include <algorithm>
+
+namespace trading {
+
+P2Quantile::P2Quantile(double quantile) noexcept
+    : p_(quantile)
+{
+    reset();
+}
+
+void P2Quantile::reset() noexcept {
+    count_ = 0;
+    for (int i = 0; i < 5; ++i) positions_[i] = i;
+    desired_ = {0.0, 2.0 * p_, 4.0 * p_, 2.0 + 2.0 * p_, 4.0};
+    increments_ = {0.0, p_ / 2.0, p_, (1.0 + p_) / 2.0, 1.0};
+}
+
+void P2Quantile::record(double value) noexcept {
+    if (count_ < 5) {
+        // Warm-up: keep the first five samples sorted; they become the markers
+        size_t i = count_++;
+        heights_[i] = value;
+        std::sort(heights_.begin(), heights_.begin() + static_cast<std::ptrdiff_t>(count_));
+        return;
+    }
+    ++count_;
+
+    // Cell the sample falls in; the extreme markers absorb new min/max
+    int k;
+    if (value < heights_[0]) {
+        heights_[0] = value;
+        k = 0;
+    } else if (value >= heights_[4]) {
+        heights_[4] = value;
+        k = 3;
+    } else {
+        k = 0;
+        while (value >= heights_[k + 1]) ++k;
+    }
+
+    for (int i = k + 1; i < 5; ++i) ++positions_[i];
+    for (int i = 0; i < 5; ++i) desired_[i] += increments_[i];
+
+    // Nudge the middle markers toward their desired positions
+    for (int i = 1; i < 4; ++i) {
+        double d = desired_[i] - static_cast<double>(positions_[i]);
+        if ((d >= 1.0 && positions_[i + 1] - positions_[i] > 1) ||
+            (d <= -1.0 && positions_[i - 1] - positions_[i] < -1)) {
+            int step = d > 0 ? 1 : -1;
+            double q = parabolic(i, step);
+            if (heights_[i - 1] < q && q < heights_[i + 1]) {
+                heights_[i] = q;
+            } else {
+                heights_[i] = linear(i, step);
+            }
+            positions_[i] += step;
+        }
+    }
+}
+
+double P2Quantile::parabolic(int i, double d) const noexcept {
+    double n_prev = static_cast<double>(positions_[i - 1]);
+    double n = static_cast<double>(positions_[i]);
+    double n_next = static_cast<double>(positions_[i + 1]);
+    return heights_[i] + d / (n_next - n_prev) *
+           ((n - n_prev + d) * (heights_[i + 1] - heights_[i]) / (n_next - n) +
+            (n_next - n - d) * (heights_[i] - heights_[i - 1]) / (n - n_prev));
+}
+
+double P2Quantile::linear(int i, int d) const noexcept {
+    return heights_[i] + d * (heights_[i + d] - heights_[i]) /
+           static_cast<double>(positions_[i + d] - positions_[i]);
+}
+
+double P2Quantile::value() const noexcept {
+    if (count_ == 0) return 0.0;
+    if (count_ < 5) {
+        // Nearest rank over the sorted warm-up samples
+        size_t rank = static_cast<size_t>(p_ * static_cast<double>(count_ - 1) + 0.5);
+        return heights_[rank];
+    }
+    return heights_[2];
+}
+
+LatencyEstimator::LatencyEstimator(double quantile, double alpha, uint32_t window) noexcept
+    : alpha_(alpha)
+    , window_(std::max(window, MIN_WINDOW_SAMPLES))
+    , current_(quantile)
+    , previous_(quantile)
+{
+}
+
+void LatencyEstimator::record(uint64_t latency_ns) noexcept {
+    double sample = static_cast<double>(latency_ns);
+    mean_ = count_ == 0 ? sample : mean_ + alpha_ * (sample - mean_);
+    ++count_;
+
+    if (current_.count() == window_) {
+        previous_ = current_;
+        current_.reset();
+    }
+    current_.record(sample);
+}
+
+double LatencyEstimator::tail() const noexcept {
+    if (current_.count() < MIN_WINDOW_SAMPLES && previous_.count() > 0) return previous_.value();
+    return current_.value();
+}
+
+} // namespace trading
@@ -1,20 +1,22 @@
 #include "common/types.hpp"
 #include "common/config.hpp"
+#include "common/config_watcher.hpp"
 #include "common/logger.hpp"
 #include "common/utils.hpp"
+#include "common/clock.hpp"
 #include "containers/lock_free_queue.hpp"
 #include "market_data/feed_simulator.hpp"
 #include "market_data/market_data_handler.hpp"
 #include "order_book/order_book.hpp"
-#include "strategy/market_maker.hpp"
-#include "strategy/pairs_trading.hpp"
-#include "strategy/momentum.hpp"
+#include "strategy/strategy_set.hpp"
 #include "execution/execution_engine.hpp"
 #include "risk/risk_manager.hpp"
 #include "monitoring/metrics_collector.hpp"
+#include "monitoring/pnl_monitor.hpp"
 
 #include <csignal>
 #include <cstdio>
+#include <array>
 #include <atomic>
 #include <memory>
 #include <thread>
@@ -49,6 +51,13 @@ int main(int argc, char* argv[]) {
     printf("=== Ultra-Low Latency HFT Trading Simulator ===\n");
     printf("    Starting up...\n\n");
 
+    // --- Clock: calibrate the TSC once, before any worker thread starts ---
+    if (TscClock::calibrate()) {
+        printf("  TSC clock:         %.3f GHz (invariant)\n", TscClock::ghz());
+    } else {
+        printf("  TSC clock:         unavailable, using clock_gettime\n");
+    }
+
     // --- Start logger ---
     Logger::instance().start();
     LOG_INFO("System starting up");
@@ -79,27 +88,10 @@ int main(int argc, char* argv[]) {
     printf("  Order books:       AAPL, GOOG\n");
 
     // Strategies
-    MarketMakerStrategy::Params mm_params;
-    mm_params.base_spread_bps = config.market_maker_spread_bps;
-    mm_params.max_inventory = config.market_maker_max_inventory;
-    mm_params.order_size = 10;
-    mm_params.instrument = 0;
-    MarketMakerStrategy market_maker(mm_params);
-
-    PairsTradingStrategy::Params pairs_params;
-    pairs_params.instrument_a = 0;
-    pairs_params.instrument_b = 1;
-    pairs_params.lookback_window = static_cast<size_t>(config.pairs_lookback_window);
-    pairs_params.entry_z_threshold = config.pairs_entry_z;
-    pairs_params.exit_z_threshold = config.pairs_exit_z;
-    PairsTradingStrategy pairs_strategy(pairs_params);
-
-    MomentumStrategy::Params mom_params;
-    mom_params.instrument = 0;
-    mom_params.fast_window = config.momentum_fast_window;
-    mom_params.slow_window = config.momentum_slow_window;
-    mom_params.breakout_threshold_bps = config.momentum_breakout_bps;
-    MomentumStrategy momentum_strategy(mom_params);
+    StrategySet strategies(config);
+    MarketMakerStrategy& market_maker = strategies.market_maker;
+    PairsTradingStrategy& pairs_strategy = strategies.pairs;
+    MomentumStrategy& momentum_strategy = strategies.momentum;
 
     printf("  Strategies:        MarketMaker, PairsTrading, Momentum\n");
 
@@ -107,12 +99,39 @@ int main(int argc, char* argv[]) {
     RiskManager risk_mgr(config.risk_limits);
     printf("  Risk manager:      ready\n");
 
+    // P&L / drawdown monitor: the trading loop publishes totals, the
+    // monitoring core evaluates drawdown and fires the global halt
+    PnlMonitor pnl_monitor(risk_mgr.kill_switch(), config.risk_limits.max_drawdown_pct);
+
+    // Config watcher: risk limits edited in the config file go live without
+    // pausing the trading loop (write the file atomically: temp + rename)
+    std::unique_ptr<ConfigWatcher> config_watcher;
+    if (argc > 1) {
+        config_watcher = std::make_unique<ConfigWatcher>(argv[1], [&](const SystemConfig& updated) {
+            switch (risk_mgr.publish_limits(updated.risk_limits)) {
+                case RiskManager::LimitsUpdate::Published:
+                    pnl_monitor.set_max_drawdown_pct(updated.risk_limits.max_drawdown_pct);
+                    LOG_INFO("Risk limits reloaded");
+                    return true;
+                case RiskManager::LimitsUpdate::Invalid:
+                    LOG_WARN("Risk limits reload rejected: invalid limits");
+                    return true;    // Wait for the next edit
+                case RiskManager::LimitsUpdate::Busy:
+                    break;
+            }
+            return false;           // Previous reload not picked up yet; retry
+        });
+        config_watcher->start();
+        printf("  Config watcher:    %s\n", argv[1]);
+    }
+
     // Execution engine
     ExecutionEngine exec_engine(order_queue, exec_report_queue);
     for (size_t i = 0; i < config.num_exchanges; ++i) {
         exec_engine.add_exchange(config.exchanges[i]);
     }
     exec_engine.seed_books(15000, 10, 1000);
+    exec_engine.set_kill_switch(&risk_mgr.kill_switch());  // Cancel-on-halt
     printf("  Execution engine:  %zu exchanges\n", config.num_exchanges);
 
     // Metrics
@@ -123,15 +142,23 @@ int main(int argc, char* argv[]) {
 
     // --- Main hot loop ---
     auto start_time = std::chrono::steady_clock::now();
-    Timestamp sim_start_ns = now_ns();
+    Timestamp sim_start_ns = TscClock::now();
     uint64_t sim_duration_ns = config.simulation_duration_ms * 1'000'000ULL;
     uint64_t iteration = 0;
 
-    // Start execution engine thread
+    // Start execution engine and monitor threads
     exec_engine.start(config.execution_core);
+    pnl_monitor.start(config.monitoring_core, std::chrono::microseconds(config.pnl_monitor_interval_us));
+
+    // Strategy/risk "now" is read once per iteration; latency probes below
+    // read the TSC directly
+    ThreadClock::use_cached();
+
+    std::array<OrderRequest, 3 * StrategyInterface::MAX_ORDERS_PER_SIGNAL> order_batch{};
+    std::array<RiskCheckResult, 3 * StrategyInterface::MAX_ORDERS_PER_SIGNAL> risk_results{};
 
     while (g_running.load(std::memory_order_relaxed)) {
-        Timestamp loop_start = now_ns();
+        Timestamp loop_start = ThreadClock::refresh();
 
         // Check simulation duration
         if (loop_start - sim_start_ns > sim_duration_ns) {
@@ -139,19 +166,19 @@ int main(int argc, char* argv[]) {
         }
 
         // 1. Generate market data
-        Timestamp t0 = now_ns();
+        Timestamp t0 = loop_start;
         std::string_view fix_msg = feed.next_message();
         if (!fix_msg.empty()) {
             md_handler.process_message(fix_msg);
         }
-        Timestamp t1 = now_ns();
+        Timestamp t1 = TscClock::now();
         metrics.market_data_latency().record(t1 - t0);
         metrics.record_market_data_msg();
 
         // 2. Consume market data → update order book
         MarketDataMessage md;
         if (md_queue.try_pop(md)) {
-            Timestamp t2 = now_ns();
+            Timestamp t2 = TscClock::now();
 
             if (md.instrument == 0 && md.bid_price > 0 && md.ask_price > 0) {
                 // Update AAPL book BBO tracking
@@ -161,55 +188,56 @@ int main(int argc, char* argv[]) {
             }
             metrics.record_order_book_update();
 
-            Timestamp t3 = now_ns();
+            Timestamp t3 = TscClock::now();
             metrics.order_book_latency().record(t3 - t2);
 
+            // Fat-finger reference tracks every tick, not just ticks that
+            // produce orders (a pairs leg-B order is often triggered by leg A)
+            if (md.bid_price > 0 && md.ask_price > 0) {
+                risk_mgr.update_market_price(md.instrument, (md.bid_price + md.ask_price) / 2);
+            }
+
             // 3. Feed to strategies
-            Timestamp t4 = now_ns();
+            Timestamp t4 = TscClock::now();
             market_maker.on_market_data(md);
             pairs_strategy.on_market_data(md);
             momentum_strategy.on_market_data(md);
 
-            // Generate orders from market maker
-            auto mm_orders = market_maker.generate_orders();
-            for (const auto& order_req : mm_orders) {
-                // 4. Risk check
-                Timestamp t5 = now_ns();
-                Price market_price = (md.bid_price + md.ask_price) / 2;
-                auto risk_result = risk_mgr.check_order(order_req, market_price);
-                Timestamp t6 = now_ns();
-                metrics.risk_check_latency().record(t6 - t5);
-
-                if (risk_result == RiskCheckResult::Approved) {
-                    // 5. Send to execution
-                    order_queue.try_push(order_req);
-                    metrics.record_order_sent();
+            // Collect this tick's orders from all strategies into one batch so
+            // the risk check sees their combined exposure
+            size_t batch_size = 0;
+            auto collect = [&](std::span<const OrderRequest> orders, StrategyId strategy) {
+                for (const auto& order_req : orders) {
+                    if (batch_size < order_batch.size()) {
+                        order_batch[batch_size] = order_req;
+                        order_batch[batch_size++].strategy = strategy;  // Halt scope
+                    }
                 }
-            }
+            };
+            collect(market_maker.generate_orders(), StrategySet::MARKET_MAKER);
+            collect(pairs_strategy.generate_orders(), StrategySet::PAIRS);
+            collect(momentum_strategy.generate_orders(), StrategySet::MOMENTUM);
 
-            // Generate from pairs strategy
-            auto pairs_orders = pairs_strategy.generate_orders();
-            for (const auto& order_req : pairs_orders) {
-                Price market_price = (md.bid_price + md.ask_price) / 2;
-                auto risk_result = risk_mgr.check_order(order_req, market_price);
-                if (risk_result == RiskCheckResult::Approved) {
-                    order_queue.try_push(order_req);
-                    metrics.record_order_sent();
-                }
-            }
+            if (batch_size > 0) {
+                // 4. Risk check
+                Timestamp t5 = TscClock::now();
+                risk_mgr.check_orders(std::span<const OrderRequest>(order_batch.data(), batch_size),
+                                      risk_results);
+                Timestamp t6 = TscClock::now();
+                metrics.risk_check_latency().record(t6 - t5);
 
-            // Generate from momentum strategy
-            auto mom_orders = momentum_strategy.generate_orders();
-            for (const auto& order_req : mom_orders) {
-                Price market_price = (md.bid_price + md.ask_price) / 2;
-                auto risk_result = risk_mgr.check_order(order_req, market_price);
-                if (risk_result == RiskCheckResult::Approved) {
-                    order_queue.try_push(order_req);
-                    metrics.record_order_sent();
+                for (size_t i = 0; i < batch_size; ++i) {
+                    if (risk_results[i] == RiskCheckResult::Approved) {
+                        // 5. Send to execution
+                        if (order_queue.try_push(order_batch[i])) {
+                            risk_mgr.on_order_sent(order_batch[i]);
+                            metrics.record_order_sent();
+                        }
+                    }
                 }
             }
 
-            Timestamp t7 = now_ns();
+            Timestamp t7 = TscClock::now();
             metrics.strategy_latency().record(t7 - t4);
 
             // Tick-to-trade
@@ -220,10 +248,13 @@ int main(int argc, char* argv[]) {
 
         // 6. Process execution reports
         ExecutionReport report;
+        bool pnl_changed = false;
         while (exec_report_queue.try_pop(report)) {
+            pnl_changed = true;
             market_maker.on_execution_report(report);
             pairs_strategy.on_execution_report(report);
             momentum_strategy.on_execution_report(report);
+            risk_mgr.on_execution_report(report);
 
             if (report.status == OrderStatus::Filled || report.status == OrderStatus::PartiallyFilled) {
                 risk_mgr.position_tracker().on_fill(
@@ -235,15 +266,19 @@ int main(int argc, char* argv[]) {
             if (report.price > 0) {
                 risk_mgr.position_tracker().update_mark_price(report.instrument, report.price);
             }
+        }
 
-            // Drawdown check
-            risk_mgr.on_pnl_update(risk_mgr.position_tracker().total_pnl());
+        // Drawdown is evaluated on the monitoring core; publish once per drain
+        if (pnl_changed) {
+            pnl_monitor.publish(risk_mgr.position_tracker(), loop_start);
         }
 
         ++iteration;
     }
 
     // --- Shutdown ---
+    if (config_watcher) config_watcher->stop();
+    pnl_monitor.stop();
     exec_engine.stop();
     Logger::instance().stop();
 
@@ -258,13 +293,22 @@ int main(int argc, char* argv[]) {
     printf("  GOOG position: %ld\n", static_cast<long>(risk_mgr.position_tracker().position(1)));
     printf("  Realized P&L:  $%.2f\n", risk_mgr.position_tracker().realized_pnl());
     printf("  Total P&L:     $%.2f\n", risk_mgr.position_tracker().total_pnl());
+    printf("  Peak P&L:      $%.2f (max drawdown %.2f%%)\n",
+           pnl_monitor.peak_pnl(), pnl_monitor.max_drawdown() * 100.0);
     printf("\n  Iterations: %lu\n", static_cast<unsigned long>(iteration));
     printf("  Risk checks: %lu (rejected: %lu)\n",
            static_cast<unsigned long>(risk_mgr.checks_performed()),
            static_cast<unsigned long>(risk_mgr.checks_rejected()));
+    printf("  Venue round trip: %.0f ns mean, max %lu ns (peak in flight: %lu)\n",
+           exec_engine.mean_round_trip_ns(),
+           static_cast<unsigned long>(exec_engine.round_trip_histogram().max_value()),
+           static_cast<unsigned long>(exec_engine.peak_in_flight()));
 
     if (risk_mgr.kill_switch_active()) {
         printf("  WARNING: Kill switch was activated!\n");
+    } else if (risk_mgr.kill_switch().any()) {
+        printf("  WARNING: Trading halted in some scopes (%lu orders cancelled on halt)\n",
+               static_cast<unsigned long>(exec_engine.halt_cancels()));
     }
 
     printf("\nSimulation complete.\n");
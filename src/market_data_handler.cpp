@@ -15,7 +15,7 @@ bool MarketDataHandler::process_message(std::string_view raw_message) noexcept {
     auto msg_type = parser_.msg_type();
 
     MarketDataMessage md{};
-    md.timestamp = now_ns();
+    md.timestamp = ThreadClock::now();
 
     if (msg_type == "W") {
         // Market data snapshot
@@ -6,6 +6,8 @@ namespace trading {
 
 MarketMakerStrategy::MarketMakerStrategy(const Params& params)
     : params_(params)
+    , quotes_({params.requote_tolerance_ticks, params.requote_size_tolerance,
+               params.min_requote_interval_ns})
 {
     next_order_id_ = params.base_order_id;
 }
@@ -19,7 +21,7 @@ void MarketMakerStrategy::on_market_data(const MarketDataMessage& md) {
         has_bbo_ = true;
 
         double mid = static_cast<double>(md.bid_price + md.ask_price) / 2.0;
-        mid_prices_.push_back(mid);
+        volatility_.update(mid);
 
         compute_fair_value();
         compute_dynamic_spread();
@@ -36,7 +38,7 @@ void MarketMakerStrategy::on_order_book_update(InstrumentId instrument,
 
     if (has_bbo_) {
         double mid = static_cast<double>(best_bid + best_ask) / 2.0;
-        mid_prices_.push_back(mid);
+        volatility_.update(mid);
         compute_fair_value();
         compute_dynamic_spread();
     }
@@ -48,6 +50,7 @@ void MarketMakerStrategy::on_trade(const Trade& trade) {
 
 void MarketMakerStrategy::on_execution_report(const ExecutionReport& report) {
     if (report.instrument != params_.instrument) return;
+    quotes_.on_execution_report(report);
     if (report.status == OrderStatus::Filled || report.status == OrderStatus::PartiallyFilled) {
         if (report.side == Side::Buy) {
             inventory_ += static_cast<int>(report.filled_quantity);
@@ -64,30 +67,34 @@ std::span<const OrderRequest> MarketMakerStrategy::generate_orders() {
         return {};
     }
 
+    Timestamp now = ThreadClock::now();
     int abs_inventory = std::abs(inventory_);
 
     // Aggressive flatten if at inventory limit
     if (abs_inventory >= params_.max_inventory) {
-        OrderRequest& req = order_buffer_[order_count_++];
-        req.id = alloc_order_id();
-        req.instrument = params_.instrument;
-        req.type = OrderType::Limit;
-        req.quantity = static_cast<Quantity>(abs_inventory);
-        req.timestamp = now_ns();
-        req.exchange = 0;
-
-        if (inventory_ > 0) {
-            // Need to sell
-            req.side = Side::Sell;
-            req.price = best_bid_; // Aggressive — hit the bid
-        } else {
-            // Need to buy
-            req.side = Side::Buy;
-            req.price = best_ask_; // Aggressive — lift the ask
-        }
+        // Sell at the bid when long, buy at the ask when short
+        const Side side = inventory_ > 0 ? Side::Sell : Side::Buy;
+        const Side adding = side == Side::Sell ? Side::Buy : Side::Sell;
+
+        // Pull the quote that would add to the position (or a flatten order
+        // left there by an overshoot), and on the first tick the passive one
+        cancel_quote(adding, now);
+        if (!flattening_) cancel_quote(side, now);
+        flattening_ = true;
+
+        // One working flatten order: replaced only when the touch or the
+        // inventory drifts beyond tolerance
+        update_quote(side, side == Side::Sell ? best_bid_ : best_ask_, static_cast<Quantity>(abs_inventory), now);
         return std::span<const OrderRequest>(order_buffer_.data(), order_count_);
     }
 
+    if (flattening_) {
+        // Back under the limit: pull what is left of the flatten order
+        cancel_quote(Side::Buy, now);
+        cancel_quote(Side::Sell, now);
+        flattening_ = false;
+    }
+
     // Compute spread with inventory skew
     double spread_ticks = current_spread_bps_ * static_cast<double>(fair_value_) / 10000.0;
     double half_spread = spread_ticks / 2.0;
@@ -102,33 +109,56 @@ std::span<const OrderRequest> MarketMakerStrategy::generate_orders() {
     if (bid_price <= 0) bid_price = 1;
     if (ask_price <= bid_price) ask_price = bid_price + 1;
 
-    // Post bid
-    {
-        OrderRequest& req = order_buffer_[order_count_++];
-        req.id = alloc_order_id();
-        req.instrument = params_.instrument;
-        req.side = Side::Buy;
-        req.type = OrderType::Limit;
-        req.price = bid_price;
-        req.quantity = params_.order_size;
-        req.timestamp = now_ns();
-        req.exchange = 0;
-    }
+    // Only touch the exchange for sides whose target moved beyond tolerance
+    update_quote(Side::Buy, bid_price, params_.order_size, now);
+    update_quote(Side::Sell, ask_price, params_.order_size, now);
+
+    return std::span<const OrderRequest>(order_buffer_.data(), order_count_);
+}
 
-    // Post ask
-    {
-        OrderRequest& req = order_buffer_[order_count_++];
-        req.id = alloc_order_id();
-        req.instrument = params_.instrument;
-        req.side = Side::Sell;
-        req.type = OrderType::Limit;
-        req.price = ask_price;
-        req.quantity = params_.order_size;
-        req.timestamp = now_ns();
-        req.exchange = 0;
+void MarketMakerStrategy::update_quote(Side side, Price price, Quantity quantity, Timestamp now) {
+    auto action = quotes_.evaluate(params_.instrument, side, price, quantity, now);
+    if (action == QuoteManager::Action::None) return;
+
+    const auto& live = quotes_.quote(params_.instrument, side);
+
+    OrderRequest& req = order_buffer_[order_count_++];
+    req.id = alloc_order_id();
+    req.instrument = params_.instrument;
+    req.side = side;
+    req.type = OrderType::Limit;
+    req.price = price;
+    req.quantity = quantity;
+    req.timestamp = now;
+    req.exchange = 0;
+    if (action == QuoteManager::Action::Replace) {
+        req.action = OrderAction::Replace;
+        req.orig_id = live.order_id;
+    } else {
+        req.action = OrderAction::New;
+        req.orig_id = 0;
     }
 
-    return std::span<const OrderRequest>(order_buffer_.data(), order_count_);
+    quotes_.on_quote_sent(params_.instrument, side, req.id, price, quantity, now);
+}
+
+void MarketMakerStrategy::cancel_quote(Side side, Timestamp now) {
+    const auto& live = quotes_.quote(params_.instrument, side);
+    if (!live.live) return;
+
+    OrderRequest& req = order_buffer_[order_count_++];
+    req.id = alloc_order_id();
+    req.instrument = params_.instrument;
+    req.side = side;
+    req.type = OrderType::Limit;
+    req.price = live.price;
+    req.quantity = live.quantity;
+    req.timestamp = now;
+    req.exchange = 0;
+    req.action = OrderAction::Cancel;
+    req.orig_id = live.order_id;
+
+    quotes_.on_cancel_sent(params_.instrument, side);
 }
 
 void MarketMakerStrategy::on_timer(Timestamp now) {
@@ -138,27 +168,18 @@ void MarketMakerStrategy::on_timer(Timestamp now) {
 void MarketMakerStrategy::compute_fair_value() {
     if (has_bbo_) {
         fair_value_ = (best_bid_ + best_ask_) / 2;
+        if (features_) {
+            double micro = features_->microprice();
+            if (micro > 0.0) fair_value_ = static_cast<Price>(std::llround(micro));
+        }
     }
 }
 
 void MarketMakerStrategy::compute_dynamic_spread() {
     current_spread_bps_ = params_.base_spread_bps;
 
-    if (mid_prices_.size() >= 10) {
-        // Compute rolling volatility (stddev of returns)
-        double sum = 0.0;
-        double sum_sq = 0.0;
-        size_t n = mid_prices_.size() - 1;
-
-        for (size_t i = 1; i < mid_prices_.size(); ++i) {
-            double ret = (mid_prices_[i] - mid_prices_[i - 1]) / mid_prices_[i - 1];
-            sum += ret;
-            sum_sq += ret * ret;
-        }
-
-        double mean = sum / static_cast<double>(n);
-        double variance = (sum_sq / static_cast<double>(n)) - (mean * mean);
-        double vol = std::sqrt(std::max(0.0, variance));
+    if (volatility_.size() >= 9) {
+        double vol = volatility_.value();
 
         // Scale spread by volatility (higher vol → wider spread)
         double vol_multiplier = 1.0 + vol * 10000.0; // bps scaling
@@ -1,16 +1,15 @@
 #include "strategy/momentum.hpp"
 #include <cmath>
 #include <algorithm>
-#include <numeric>
 
 namespace trading {
 
 MomentumStrategy::MomentumStrategy(const Params& params)
     : params_(params)
+    , fast_ema_(ema_alpha(static_cast<size_t>(params.fast_window)))
+    , slow_ema_(ema_alpha(static_cast<size_t>(params.slow_window)))
 {
     next_order_id_ = params.base_order_id;
-    fast_alpha_ = 2.0 / (static_cast<double>(params.fast_window) + 1.0);
-    slow_alpha_ = 2.0 / (static_cast<double>(params.slow_window) + 1.0);
 }
 
 void MomentumStrategy::on_market_data(const MarketDataMessage& md) {
@@ -24,7 +23,7 @@ void MomentumStrategy::on_market_data(const MarketDataMessage& md) {
     update_emas(static_cast<double>(mid));
 
     if (md.last_quantity > 0) {
-        volumes_.push_back(md.last_quantity);
+        volumes_.update(static_cast<double>(md.last_quantity));
     }
 }
 
@@ -41,7 +40,7 @@ void MomentumStrategy::on_order_book_update(InstrumentId instrument,
 
 void MomentumStrategy::on_trade(const Trade& trade) {
     if (trade.instrument != params_.instrument) return;
-    volumes_.push_back(trade.quantity);
+    volumes_.update(static_cast<double>(trade.quantity));
 }
 
 void MomentumStrategy::on_execution_report(const ExecutionReport& report) {
@@ -54,29 +53,15 @@ void MomentumStrategy::on_execution_report(const ExecutionReport& report) {
 
 void MomentumStrategy::update_emas(double price) {
     ++tick_count_;
+    fast_ema_.update(price);
+    slow_ema_.update(price);
 
-    if (tick_count_ == 1) {
-        fast_ema_ = price;
-        slow_ema_ = price;
-    } else {
-        fast_ema_ = fast_alpha_ * price + (1.0 - fast_alpha_) * fast_ema_;
-        slow_ema_ = slow_alpha_ * price + (1.0 - slow_alpha_) * slow_ema_;
-    }
-
-    if (slow_ema_ > 1e-10) {
-        momentum_signal_ = (fast_ema_ - slow_ema_) / slow_ema_ * 10000.0; // in bps
+    double slow = slow_ema_.value();
+    if (slow > 1e-10) {
+        momentum_signal_ = (fast_ema_.value() - slow) / slow * 10000.0; // in bps
     } else {
         momentum_signal_ = 0.0;
     }
-
-    // Update average volume
-    if (volumes_.size() > 0) {
-        double sum = 0.0;
-        for (size_t i = 0; i < volumes_.size(); ++i) {
-            sum += static_cast<double>(volumes_[i]);
-        }
-        avg_volume_ = sum / static_cast<double>(volumes_.size());
-    }
 }
 
 std::span<const OrderRequest> MomentumStrategy::generate_orders() {
@@ -86,7 +71,7 @@ std::span<const OrderRequest> MomentumStrategy::generate_orders() {
     if (tick_count_ < static_cast<uint64_t>(params_.slow_window)) return {};
     if (current_price_ <= 0) return {};
 
-    Timestamp now = now_ns();
+    Timestamp now = ThreadClock::now();
     double threshold = params_.breakout_threshold_bps;
 
     switch (state_) {
@@ -82,6 +82,7 @@ std::span<Trade> OrderBook::match_order(OrderBookEntry* entry) {
 }
 
 void OrderBook::try_match_limit(OrderBookEntry* entry, size_t& trade_count) {
+    const Side resting_side = opposite_side(entry->side);
     auto match_against = [&](auto& levels) {
         auto it = levels.begin();
         while (it != levels.end() && trade_count < MAX_TRADES_PER_MATCH) {
@@ -91,10 +92,11 @@ void OrderBook::try_match_limit(OrderBookEntry* entry, size_t& trade_count) {
             if (entry->side == Side::Buy && level.price > entry->price) break;
             if (entry->side == Side::Sell && level.price < entry->price) break;
 
+            size_t level_trades = trade_count;
             while (level.front() && trade_count < MAX_TRADES_PER_MATCH) {
                 OrderBookEntry* resting = level.front();
                 Quantity entry_remaining = entry->quantity - entry->filled_quantity;
-                if (entry_remaining == 0) return;
+                if (entry_remaining == 0) break;
 
                 Quantity resting_remaining = resting->quantity - resting->filled_quantity;
                 Quantity fill_qty = std::min(entry_remaining, resting_remaining);
@@ -110,6 +112,7 @@ void OrderBook::try_match_limit(OrderBookEntry* entry, size_t& trade_count) {
 
                 entry->filled_quantity += fill_qty;
                 resting->filled_quantity += fill_qty;
+                level.total_quantity -= fill_qty;
 
                 if (resting->filled_quantity >= resting->quantity) {
                     resting->status = OrderStatus::Filled;
@@ -118,16 +121,19 @@ void OrderBook::try_match_limit(OrderBookEntry* entry, size_t& trade_count) {
                     pool_.deallocate(resting);
                 } else {
                     resting->status = OrderStatus::PartiallyFilled;
-                    // Update level quantity
-                    level.total_quantity -= fill_qty;
                 }
             }
 
+            if (trade_count == level_trades) return; // Fully filled before this level
+            Price level_price = level.price;
+            Quantity level_qty = level.total_quantity;
             if (level.empty()) {
                 it = levels.erase(it);
             } else {
                 ++it;
             }
+            notify_level(resting_side, level_price, level_qty);
+            if (entry->filled_quantity == entry->quantity) return;
         }
     };
 
@@ -146,10 +152,11 @@ void OrderBook::try_match_market(OrderBookEntry* entry, size_t& trade_count) {
         auto it = asks_.begin();
         while (it != asks_.end() && trade_count < MAX_TRADES_PER_MATCH) {
             PriceLevel& level = it->second;
+            size_t level_trades = trade_count;
             while (level.front() && trade_count < MAX_TRADES_PER_MATCH) {
                 OrderBookEntry* resting = level.front();
                 Quantity entry_remaining = entry->quantity - entry->filled_quantity;
-                if (entry_remaining == 0) { update_best_ask(); return; }
+                if (entry_remaining == 0) break;
 
                 Quantity resting_remaining = resting->quantity - resting->filled_quantity;
                 Quantity fill_qty = std::min(entry_remaining, resting_remaining);
@@ -164,6 +171,7 @@ void OrderBook::try_match_market(OrderBookEntry* entry, size_t& trade_count) {
 
                 entry->filled_quantity += fill_qty;
                 resting->filled_quantity += fill_qty;
+                level.total_quantity -= fill_qty;
 
                 if (resting->filled_quantity >= resting->quantity) {
                     resting->status = OrderStatus::Filled;
@@ -172,24 +180,29 @@ void OrderBook::try_match_market(OrderBookEntry* entry, size_t& trade_count) {
                     pool_.deallocate(resting);
                 } else {
                     resting->status = OrderStatus::PartiallyFilled;
-                    level.total_quantity -= fill_qty;
                 }
             }
+            if (trade_count == level_trades) break;
+            Price level_price = level.price;
+            Quantity level_qty = level.total_quantity;
             if (level.empty()) {
                 it = asks_.erase(it);
             } else {
                 ++it;
             }
+            notify_level(Side::Sell, level_price, level_qty);
+            if (entry->filled_quantity == entry->quantity) break;
         }
         update_best_ask();
     } else {
         auto it = bids_.begin();
         while (it != bids_.end() && trade_count < MAX_TRADES_PER_MATCH) {
             PriceLevel& level = it->second;
+            size_t level_trades = trade_count;
             while (level.front() && trade_count < MAX_TRADES_PER_MATCH) {
                 OrderBookEntry* resting = level.front();
                 Quantity entry_remaining = entry->quantity - entry->filled_quantity;
-                if (entry_remaining == 0) { update_best_bid(); return; }
+                if (entry_remaining == 0) break;
 
                 Quantity resting_remaining = resting->quantity - resting->filled_quantity;
                 Quantity fill_qty = std::min(entry_remaining, resting_remaining);
@@ -204,6 +217,7 @@ void OrderBook::try_match_market(OrderBookEntry* entry, size_t& trade_count) {
 
                 entry->filled_quantity += fill_qty;
                 resting->filled_quantity += fill_qty;
+                level.total_quantity -= fill_qty;
 
                 if (resting->filled_quantity >= resting->quantity) {
                     resting->status = OrderStatus::Filled;
@@ -212,14 +226,18 @@ void OrderBook::try_match_market(OrderBookEntry* entry, size_t& trade_count) {
                     pool_.deallocate(resting);
                 } else {
                     resting->status = OrderStatus::PartiallyFilled;
-                    level.total_quantity -= fill_qty;
                 }
             }
+            if (trade_count == level_trades) break;
+            Price level_price = level.price;
+            Quantity level_qty = level.total_quantity;
             if (level.empty()) {
                 it = bids_.erase(it);
             } else {
                 ++it;
             }
+            notify_level(Side::Buy, level_price, level_qty);
+            if (entry->filled_quantity == entry->quantity) break;
         }
         update_best_bid();
     }
@@ -227,19 +245,27 @@ void OrderBook::try_match_market(OrderBookEntry* entry, size_t& trade_count) {
 
 void OrderBook::add_to_book(OrderBookEntry* entry) {
     if (entry->side == Side::Buy) {
-        bids_[entry->price].price = entry->price;
-        bids_[entry->price].add_order(entry);
+        PriceLevel& level = bids_[entry->price];
+        level.price = entry->price;
+        level.add_order(entry);
         if (entry->price > best_bid_ || best_bid_qty_ == 0) {
             best_bid_ = entry->price;
-            best_bid_qty_ = bids_[entry->price].total_quantity;
+            best_bid_qty_ = level.total_quantity;
+        } else if (entry->price == best_bid_) {
+            best_bid_qty_ = level.total_quantity;
         }
+        notify_level(Side::Buy, entry->price, level.total_quantity);
     } else {
-        asks_[entry->price].price = entry->price;
-        asks_[entry->price].add_order(entry);
+        PriceLevel& level = asks_[entry->price];
+        level.price = entry->price;
+        level.add_order(entry);
         if (entry->price < best_ask_ || best_ask_qty_ == 0) {
             best_ask_ = entry->price;
-            best_ask_qty_ = asks_[entry->price].total_quantity;
+            best_ask_qty_ = level.total_quantity;
+        } else if (entry->price == best_ask_) {
+            best_ask_qty_ = level.total_quantity;
         }
+        notify_level(Side::Sell, entry->price, level.total_quantity);
     }
 }
 
@@ -248,18 +274,24 @@ void OrderBook::remove_from_book(OrderBookEntry* entry) {
         auto it = bids_.find(entry->price);
         if (it != bids_.end()) {
             it->second.remove_order(entry);
+            Quantity remaining = it->second.total_quantity;
             if (it->second.empty()) {
                 bids_.erase(it);
+                remaining = 0;
             }
+            notify_level(Side::Buy, entry->price, remaining);
         }
         update_best_bid();
     } else {
         auto it = asks_.find(entry->price);
         if (it != asks_.end()) {
             it->second.remove_order(entry);
+            Quantity remaining = it->second.total_quantity;
             if (it->second.empty()) {
                 asks_.erase(it);
+                remaining = 0;
             }
+            notify_level(Side::Sell, entry->price, remaining);
         }
         update_best_ask();
     }
@@ -350,6 +382,24 @@ size_t OrderBook::get_depth(DepthEntry* bid_entries, DepthEntry* ask_entries, si
     return count;
 }
 
+size_t OrderBook::get_side_depth(Side side, DepthEntry* entries, size_t max_levels) const {
+    size_t count = 0;
+    auto fill = [&](const auto& levels) {
+        for (auto it = levels.begin(); count < max_levels && it != levels.end(); ++it, ++count) {
+            entries[count].price = it->first;
+            entries[count].quantity = it->second.total_quantity;
+            entries[count].order_count = it->second.order_count;
+        }
+    };
+
+    if (side == Side::Buy) {
+        fill(bids_);
+    } else {
+        fill(asks_);
+    }
+    return count;
+}
+
 double OrderBook::vwap(Side side, size_t levels) const {
     double total_value = 0.0;
     double total_qty = 0.0;
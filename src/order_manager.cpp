@@ -0,0 +1,231 @@
+#include "execution/order_manager.hpp"
+#include <algorithm>
+
+namespace trading {
+
+namespace {
+
+OrderState to_state(OrderStatus status) noexcept {
+    switch (status) {
+        case OrderStatus::New: return OrderState::New;
+        case OrderStatus::PartiallyFilled: return OrderState::PartiallyFilled;
+        case OrderStatus::Filled: return OrderState::Filled;
+        case OrderStatus::Cancelled: return OrderState::Cancelled;
+        default: return OrderState::Rejected;
+    }
+}
+
+OrderStatus to_status(OrderState state) noexcept {
+    switch (state) {
+        case OrderState::PendingNew:
+        case OrderState::New: return OrderStatus::New;
+        case OrderState::PartiallyFilled: return OrderStatus::PartiallyFilled;
+        case OrderState::Filled: return OrderStatus::Filled;
+        case OrderState::Cancelled: return OrderStatus::Cancelled;
+        default: return OrderStatus::Rejected;
+    }
+}
+
+/// Progress rank: terminal states all rank last
+int rank(OrderState state) noexcept {
+    return is_terminal(state) ? 3 : static_cast<int>(state);
+}
+
+} // anonymous namespace
+
+OrderManager::OrderManager() noexcept {
+    closed_.fill(0);
+}
+
+ManagedOrder* OrderManager::allocate(OrderId id) noexcept {
+    if (orders_.contains(id)) [[unlikely]] return nullptr;
+    ManagedOrder* order = pool_.allocate();
+    if (!order) [[unlikely]] return nullptr;
+    *order = ManagedOrder{};
+    order->id = id;
+    order->state = OrderState::PendingNew;
+    orders_.insert(id, order);      // Twice the pool's size: always has room
+    return order;
+}
+
+ManagedOrder* OrderManager::open(const OrderRequest& request) noexcept {
+    if (request.action == OrderAction::Cancel) return nullptr;
+    ManagedOrder* order = allocate(request.id);
+    if (!order) [[unlikely]] return nullptr;
+    order->replaces = request.action == OrderAction::Replace ? request.orig_id : 0;
+    order->instrument = request.instrument;
+    order->side = request.side;
+    order->type = request.type;
+    order->exchange = request.exchange;
+    order->strategy = request.strategy;
+    order->price = request.price;
+    order->quantity = request.quantity;
+    return order;
+}
+
+ManagedOrder* OrderManager::open_child(OrderId parent_id, OrderId child_id, ExchangeId exchange,
+                                       Quantity quantity) noexcept {
+    ManagedOrder* const* found = orders_.find(parent_id);
+    if (!found || (*found)->parent != 0) [[unlikely]] return nullptr;
+    ManagedOrder* parent = *found;
+    ManagedOrder* child = allocate(child_id);
+    if (!child) [[unlikely]] return nullptr;
+
+    child->parent = parent_id;
+    child->instrument = parent->instrument;
+    child->side = parent->side;
+    child->type = parent->type;
+    child->exchange = exchange;
+    child->strategy = parent->strategy;
+    child->price = parent->price;
+    child->quantity = quantity;
+    child->next_sibling = parent->first_child;
+    parent->first_child = child;
+    ++parent->children;
+    ++parent->open_children;
+    return child;
+}
+
+void OrderManager::close(ManagedOrder* order) noexcept {
+    for (ManagedOrder* child = order->first_child; child;) {
+        ManagedOrder* next = child->next_sibling;
+        close(child);
+        child = next;
+    }
+    orders_.erase(order->id);
+    closed_[closed_slot(order->id)] = order->id;
+    pool_.deallocate(order);
+}
+
+void OrderManager::retire_replaced(ManagedOrder* original) noexcept {
+    // Acknowledged children were pulled with it and will not report again;
+    // PendingNew ones (and an unsplit PendingNew original) still have a report
+    // on the way, possibly with fills that executed before the pull
+    original->replaced = true;
+    for (ManagedOrder* child = original->first_child; child; child = child->next_sibling) {
+        if (child->state != OrderState::PendingNew && !is_terminal(child->state)) {
+            child->state = OrderState::Cancelled;
+            --original->open_children;
+        }
+    }
+    const bool awaiting = original->children > 0 ? original->open_children > 0
+                                                 : original->state == OrderState::PendingNew;
+    if (!awaiting) {
+        original->state = OrderState::Cancelled;
+        close(original);
+    }
+}
+
+OrderManager::ReportResult OrderManager::advance(ManagedOrder& order, const ExecutionReport& report,
+                                                 Quantity& newly_filled) noexcept {
+    if (is_terminal(order.state)) return ReportResult::Duplicate;     // A child held by its parent
+    if (report.exec_id != 0 && report.exec_id == order.last_exec_id) return ReportResult::Duplicate;
+
+    const OrderState target = to_state(report.status);
+    const Quantity filled = std::min(report.filled_quantity, order.quantity);
+    if (filled < order.filled) return ReportResult::Stale;
+    if (filled == order.filled) {
+        if (target == order.state) return ReportResult::Duplicate;
+        if (rank(target) < rank(order.state)) return ReportResult::Stale;
+    }
+
+    newly_filled = filled - order.filled;
+    order.filled = filled;
+    order.fill_notional += report.price * static_cast<int64_t>(newly_filled);
+    order.last_exec_id = report.exec_id;
+    order.exchange = report.exchange;
+
+    if (order.filled == order.quantity && order.quantity > 0) {
+        order.state = OrderState::Filled;
+    } else if (is_terminal(target)) {
+        order.state = target;
+    } else if (target != OrderState::New && order.type != OrderType::Limit) {
+        order.state = OrderState::Cancelled;    // Unfilled IOC/FOK/market remainder is not resting
+    } else {
+        order.state = order.filled > 0 ? OrderState::PartiallyFilled : OrderState::New;
+    }
+    return ReportResult::Applied;
+}
+
+bool OrderManager::roll_up(ManagedOrder& parent, const ManagedOrder& child, Quantity newly_filled,
+                           Price fill_price) noexcept {
+    const OrderState before = parent.state;
+    parent.filled += newly_filled;
+    parent.fill_notional += fill_price * static_cast<int64_t>(newly_filled);
+
+    if (parent.filled >= parent.quantity) {
+        parent.state = OrderState::Filled;
+    } else if (parent.open_children == 0) {
+        parent.state = parent.rejected_children == parent.children ? OrderState::Rejected : OrderState::Cancelled;
+    } else if (parent.filled > 0) {
+        parent.state = OrderState::PartiallyFilled;
+    } else if (child.state != OrderState::Rejected) {
+        parent.state = OrderState::New;     // A child was acknowledged
+    }
+    return parent.state != before || newly_filled > 0;
+}
+
+OrderManager::ReportResult OrderManager::on_report(const ExecutionReport& report, OrderAction action,
+                                                   ExecutionReport& publish) noexcept {
+    publish = report;
+    // The answer to a cancel request only moves its target when confirmed
+    if (action == OrderAction::Cancel && report.status != OrderStatus::Cancelled) return ReportResult::Untracked;
+
+    ManagedOrder* const* found = orders_.find(report.order_id);
+    if (!found) {
+        if (action != OrderAction::Cancel && recently_closed(report.order_id)) {
+            ++duplicates_;
+            return ReportResult::Duplicate;
+        }
+        return ReportResult::Untracked;
+    }
+    ManagedOrder* order = *found;
+
+    if (order->replaces != 0) {
+        // The venue pulls the original when it answers the replace, either way
+        if (ManagedOrder* const* original = orders_.find(order->replaces)) retire_replaced(*original);
+        order->replaces = 0;
+    }
+
+    ExecutionReport effective = report;
+    if (action == OrderAction::Cancel) {
+        effective.filled_quantity = order->filled;  // Cancel confirmations carry no fill totals
+    }
+    Quantity newly_filled = 0;
+    ReportResult result = advance(*order, effective, newly_filled);
+    if (result == ReportResult::Duplicate) ++duplicates_;
+    if (result == ReportResult::Stale) ++stale_;
+    if (result != ReportResult::Applied) return result;
+
+    ManagedOrder* const* parent_found = order->parent != 0 ? orders_.find(order->parent) : nullptr;
+    // Off the book since the replace: this was its last report
+    const bool pulled = parent_found ? (*parent_found)->replaced : order->replaced;
+    if (pulled && !is_terminal(order->state)) order->state = OrderState::Cancelled;
+
+    if (order->parent == 0) {
+        publish.status = to_status(order->state);
+        publish.filled_quantity = newly_filled;
+        publish.leaves_quantity = order->leaves();
+        if (is_terminal(order->state)) close(order);
+        return ReportResult::Applied;
+    }
+
+    // Child: its parent is what the strategy knows about
+    if (!parent_found) return ReportResult::Absorbed;
+    ManagedOrder* parent = *parent_found;
+    if (is_terminal(order->state)) {
+        --parent->open_children;
+        parent->rejected_children += order->state == OrderState::Rejected;
+    }
+    if (!roll_up(*parent, *order, newly_filled, report.price)) return ReportResult::Absorbed;
+
+    publish.order_id = parent->id;
+    publish.status = to_status(parent->state);
+    publish.quantity = parent->quantity;
+    publish.filled_quantity = newly_filled;
+    publish.leaves_quantity = parent->leaves();
+    if (is_terminal(parent->state)) close(parent);
+    return ReportResult::Applied;
+}
+
+} // namespace trading
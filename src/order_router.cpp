@@ -4,83 +4,356 @@
 
 namespace trading {
 
-OrderRouter::OrderRouter() = default;
+OrderRouter::OrderRouter() {
+    venue_slot_.fill(NO_VENUE);
+}
 
 void OrderRouter::add_exchange(ExchangeSimulator* exchange) {
+    if (exchanges_.size() < MAX_EXCHANGES) {
+        venue_slot_[exchange->id()] = static_cast<uint8_t>(exchanges_.size());
+        venue_stats_[exchanges_.size()].fill_rate = exchange->config().fill_probability;
+    }
     exchanges_.push_back(exchange);
 }
 
-ExecutionReport OrderRouter::route_order(const OrderRequest& request) {
-    ExchangeSimulator* exchange = select_exchange(request);
-    if (!exchange) {
-        ExecutionReport report{};
-        report.order_id = request.id;
-        report.status = OrderStatus::Rejected;
-        report.timestamp = now_ns();
+void OrderRouter::record_latency(ExchangeId exchange, uint64_t round_trip_ns) noexcept {
+    uint8_t slot = venue_slot_[exchange];
+    if (slot == NO_VENUE) [[unlikely]] return;
+    venue_stats_[slot].latency.record(round_trip_ns);
+}
+
+void OrderRouter::record_fill_outcome(ExchangeId exchange, bool accepted) noexcept {
+    uint8_t slot = venue_slot_[exchange];
+    if (slot == NO_VENUE) [[unlikely]] return;
+    VenueStats& venue = venue_stats_[slot];
+    double outcome = accepted ? 1.0 : 0.0;
+    venue.fill_rate = venue.outcomes == 0 ? outcome : venue.fill_rate + FILL_RATE_ALPHA * (outcome - venue.fill_rate);
+    ++venue.outcomes;
+}
+
+double OrderRouter::predicted_latency_ns(ExchangeId exchange) const noexcept {
+    const VenueStats* venue = stats(exchange);
+    if (!venue) return 0.0;
+    if (venue->latency.count() == 0) {
+        return static_cast<double>(exchanges_[venue_slot_[exchange]]->config().latency_ns);
+    }
+    return (1.0 - TAIL_WEIGHT) * venue->latency.mean() + TAIL_WEIGHT * venue->latency.tail();
+}
+
+double OrderRouter::fill_rate(ExchangeId exchange) const noexcept {
+    const VenueStats* venue = stats(exchange);
+    return venue ? venue->fill_rate : 0.0;
+}
+
+double OrderRouter::latency_score(size_t slot) const noexcept {
+    // Expected time to an accepted order: each reject costs another round trip
+    constexpr double MIN_FILL_RATE = 0.01;
+    ExchangeId id = exchanges_[slot]->id();
+    return predicted_latency_ns(id) / std::max(venue_stats_[slot].fill_rate, MIN_FILL_RATE);
+}
+
+ExecutionReport OrderRouter::reject(const OrderRequest& request) noexcept {
+    ExecutionReport report{};
+    report.order_id = request.id;
+    report.instrument = request.instrument;
+    report.side = request.side;
+    report.status = OrderStatus::Rejected;
+    report.timestamp = ThreadClock::now();
+    return report;
+}
+
+ExecutionReport OrderRouter::route_order(const OrderRequest& request, ChildReports* children) {
+    if (children) children->count = 0;
+    if (request.action == OrderAction::Cancel) {
+        ExecutionReport report = cancel_order(request.orig_id);
+        report.instrument = request.instrument;
+        report.side = request.side;
         return report;
     }
+    if (request.action == OrderAction::Replace) {
+        return replace_order(request, children);
+    }
 
-    // Track which exchange got this order
-    order_exchange_map_[request.id] = exchange->id();
+    ExchangeSimulator* exchange = nullptr;
+    if (strategy_ == RoutingStrategy::BestPrice) {
+        SweepPlan plan;
+        size_t legs = plan_sweep(request, plan);
+        if (legs > 1) {
+            if (sweep_orders_.size() >= decltype(sweep_orders_)::MAX_SIZE) [[unlikely]] return reject(request);
+            return route_sweep(request, plan, children);
+        }
+        if (legs == 1) exchange = plan.children[0].exchange;
+    } else {
+        exchange = select_exchange(request);
+    }
+    // Refuse up front what could not be tracked if it came to rest
+    if (!exchange || order_exchange_map_.size() >= decltype(order_exchange_map_)::MAX_SIZE) [[unlikely]] {
+        return reject(request);
+    }
+    if (!charge(exchange)) [[unlikely]] {
+        ++venue_throttled_;
+        return reject(request);
+    }
 
-    return exchange->submit_order(request);
+    ExecutionReport report = exchange->submit_order(request);
+    if (rests(request, report)) order_exchange_map_.insert(request.id, exchange->id());
+    return report;
 }
 
 ExecutionReport OrderRouter::cancel_order(OrderId order_id) {
-    auto it = order_exchange_map_.find(order_id);
-    if (it == order_exchange_map_.end()) {
+    const ExchangeId* venue = order_exchange_map_.find(order_id);
+    ExchangeSimulator* exchange = venue ? find_exchange(*venue) : nullptr;
+    if (!exchange) {
+        if (sweep_orders_.contains(order_id)) return cancel_sweep(order_id);
         ExecutionReport report{};
         report.order_id = order_id;
         report.status = OrderStatus::Rejected;
-        report.timestamp = now_ns();
+        report.timestamp = ThreadClock::now();
         return report;
     }
 
-    ExchangeId eid = it->second;
-    for (auto* exchange : exchanges_) {
-        if (exchange->id() == eid) {
-            auto report = exchange->cancel_order(order_id);
-            if (report.status == OrderStatus::Cancelled) {
-                order_exchange_map_.erase(it);
-            }
-            return report;
-        }
+    // Cancelled, or rejected because the venue no longer has it (filled
+    // passively): terminal either way
+    order_exchange_map_.erase(order_id);
+    return exchange->cancel_order(order_id);
+}
+
+ExecutionReport OrderRouter::replace_order(const OrderRequest& request, ChildReports* children) {
+    if (sweep_orders_.contains(request.orig_id)) {
+        // A split parent has no single venue to replace on: pull every
+        // child, then route the replacement afresh
+        cancel_sweep(request.orig_id);
+        OrderRequest fresh = request;
+        fresh.action = OrderAction::New;
+        return route_order(fresh, children);
     }
 
-    ExecutionReport report{};
-    report.order_id = order_id;
-    report.status = OrderStatus::Rejected;
-    report.timestamp = now_ns();
+    const ExchangeId* venue = order_exchange_map_.find(request.orig_id);
+    ExchangeSimulator* exchange = venue ? find_exchange(*venue) : nullptr;
+    if (!exchange) return reject(request);
+    if (!charge(exchange)) [[unlikely]] {
+        ++venue_throttled_;     // Original stays on the book
+        return reject(request);
+    }
+
+    // Original is off the book whether the replace succeeds or not
+    order_exchange_map_.erase(request.orig_id);
+    auto report = exchange->replace_order(request);
+    if (rests(request, report)) order_exchange_map_.insert(request.id, exchange->id());
     return report;
 }
 
+ExchangeSimulator* OrderRouter::find_exchange(ExchangeId id) const noexcept {
+    if (venue_slot_[id] != NO_VENUE) return exchanges_[venue_slot_[id]];
+    for (auto* exchange : exchanges_) {
+        if (exchange->id() == id) return exchange;
+    }
+    return nullptr;
+}
+
 ExchangeSimulator* OrderRouter::select_exchange(const OrderRequest& request) {
     if (exchanges_.empty()) return nullptr;
 
     switch (strategy_) {
         case RoutingStrategy::LowestLatency: {
             ExchangeSimulator* best = nullptr;
-            uint64_t min_latency = std::numeric_limits<uint64_t>::max();
-            for (auto* exchange : exchanges_) {
-                if (exchange->config().enabled && exchange->config().latency_ns < min_latency) {
-                    min_latency = exchange->config().latency_ns;
-                    best = exchange;
+            double best_score = std::numeric_limits<double>::max();
+            const size_t venues = std::min(exchanges_.size(), MAX_EXCHANGES);
+            for (size_t i = 0; i < venues; ++i) {
+                if (!exchanges_[i]->config().enabled || throttled(exchanges_[i])) continue;
+                double score = latency_score(i);
+                if (score < best_score) {
+                    best_score = score;
+                    best = exchanges_[i];
                 }
             }
             return best ? best : exchanges_[0];
         }
 
-        case RoutingStrategy::BestPrice:
-            // For now, fall through to round-robin
-            // Real implementation would check each exchange's book
-            [[fallthrough]];
-
+        case RoutingStrategy::BestPrice:    // Planned by plan_sweep()
         case RoutingStrategy::RoundRobin:
         default:
+            // Next venue in turn with rate to spare; the due one if none has
             ExchangeSimulator* selected = exchanges_[round_robin_idx_ % exchanges_.size()];
+            for (size_t tried = 0; tried < exchanges_.size(); ++tried) {
+                ExchangeSimulator* candidate = exchanges_[(round_robin_idx_ + tried) % exchanges_.size()];
+                if (!throttled(candidate)) {
+                    selected = candidate;
+                    round_robin_idx_ = (round_robin_idx_ + tried) % exchanges_.size();
+                    break;
+                }
+            }
             round_robin_idx_ = (round_robin_idx_ + 1) % exchanges_.size();
             return selected;
     }
 }
 
+size_t OrderRouter::plan_sweep(const OrderRequest& request, SweepPlan& plan) const noexcept {
+    plan.count = 0;
+    plan.displayed = 0;
+
+    const size_t venues = std::min(exchanges_.size(), MAX_EXCHANGES);
+    const bool buy = request.side == Side::Buy;
+    const bool limited = request.type != OrderType::Market;
+    const Side book_side = buy ? Side::Sell : Side::Buy;
+
+    std::array<std::array<OrderBook::DepthEntry, SWEEP_DEPTH>, MAX_EXCHANGES> depth;
+    std::array<size_t, MAX_EXCHANGES> levels{};        // Levels within the limit
+    std::array<size_t, MAX_EXCHANGES> next{};
+    std::array<double, MAX_EXCHANGES> net_factor{};    // Price multiplier net of the taker fee
+    std::array<double, MAX_EXCHANGES> head_cost;       // Net cost of each venue's next level
+    std::array<Quantity, MAX_EXCHANGES> allocated{};
+    std::array<size_t, MAX_EXCHANGES> ranked;          // Venue index per child, best first
+    size_t children = 0;
+
+    constexpr double EXHAUSTED = std::numeric_limits<double>::max();
+    // Sells rank the highest net proceeds first: their cost is negated
+    auto cost = [&](size_t venue, Price price) {
+        double net = static_cast<double>(price) * net_factor[venue];
+        return buy ? net : -net;
+    };
+
+    for (size_t i = 0; i < MAX_EXCHANGES; ++i) {
+        head_cost[i] = EXHAUSTED;
+        if (i >= venues || !exchanges_[i]->config().enabled || throttled(exchanges_[i])) continue;
+        size_t n = exchanges_[i]->depth(book_side, depth[i].data(), SWEEP_DEPTH);
+        if (limited) {
+            while (n > 0 && (buy ? depth[i][n - 1].price > request.price
+                                 : depth[i][n - 1].price < request.price)) --n;
+        }
+        levels[i] = n;
+        double fee = exchanges_[i]->config().taker_fee_bps / 10000.0;
+        net_factor[i] = buy ? 1.0 + fee : 1.0 - fee;
+        if (n > 0) head_cost[i] = cost(i, depth[i][0].price);
+    }
+
+    // Take the best remaining level across venues until filled or out of levels
+    Quantity remaining = request.quantity;
+    while (remaining > 0) {
+        size_t best = 0;
+        for (size_t i = 1; i < MAX_EXCHANGES; ++i) {
+            if (head_cost[i] < head_cost[best]) best = i;
+        }
+        if (head_cost[best] == EXHAUSTED) break;
+
+        if (allocated[best] == 0) ranked[children++] = best;
+        Quantity take = std::min(remaining, depth[best][next[best]].quantity);
+        allocated[best] += take;
+        remaining -= take;
+        head_cost[best] = ++next[best] < levels[best] ? cost(best, depth[best][next[best]].price) : EXHAUSTED;
+    }
+    plan.displayed = request.quantity - remaining;
+
+    if (request.type == OrderType::FOK && children > 1) {
+        // Fill-or-kill cannot be split: the whole order goes to the best venue
+        allocated[ranked[0]] = request.quantity;
+        children = 1;
+        remaining = 0;
+    }
+
+    if (children == 0) {
+        // No displayed liquidity within the limit: cheapest enabled venue
+        double lowest_fee = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < venues; ++i) {
+            const ExchangeConfig& config = exchanges_[i]->config();
+            if (config.enabled && !throttled(exchanges_[i]) && config.taker_fee_bps < lowest_fee) {
+                lowest_fee = config.taker_fee_bps;
+                ranked[0] = i;
+                children = 1;
+            }
+        }
+        if (children == 0) return 0;
+    }
+    allocated[ranked[0]] += remaining;     // Rests (or is cancelled, for IOC) on the best venue
+
+    for (size_t k = 0; k < children; ++k) {
+        plan.children[k] = {exchanges_[ranked[k]], allocated[ranked[k]]};
+    }
+    plan.count = children;
+    return children;
+}
+
+ExecutionReport OrderRouter::route_sweep(const OrderRequest& request, const SweepPlan& plan,
+                                         ChildReports* children) {
+    ExecutionReport report{};
+    report.order_id = request.id;
+    report.instrument = request.instrument;
+    report.side = request.side;
+    report.quantity = request.quantity;
+    report.exchange = plan.children[0].exchange->id();
+
+    SweepOrder resting;
+    Quantity filled = 0;
+    Price notional = 0;
+    size_t rejected = 0;
+    for (size_t k = 0; k < plan.count; ++k) {
+        ExchangeSimulator* exchange = plan.children[k].exchange;
+        OrderRequest child = request;
+        child.id = next_child_id_++;
+        child.quantity = plan.children[k].quantity;
+        charge(exchange);   // Planned venues all conform: one child each
+        ExecutionReport child_report = exchange->submit_order(child);
+        const Price child_notional = exchange->last_fill_notional();   // A child may walk several levels
+        if (children) {
+            children->reports[k] = child_report;
+            children->quantities[k] = child.quantity;
+            children->notionals[k] = child_notional;
+            children->count = k + 1;
+        }
+
+        filled += child_report.filled_quantity;
+        notional += child_notional;
+        report.exec_id = child_report.exec_id;
+        report.timestamp = std::max(report.timestamp, child_report.timestamp);
+        if (child_report.status == OrderStatus::Rejected) ++rejected;
+
+        if (rests(request, child_report)) {
+            resting.child_ids[resting.count] = child.id;
+            resting.exchanges[resting.count] = exchange->id();
+            ++resting.count;
+        }
+    }
+
+    report.filled_quantity = filled;
+    report.leaves_quantity = request.quantity - filled;
+    report.price = filled > 0 ? notional / static_cast<Price>(filled) : request.price;
+    if (filled == request.quantity) {
+        report.status = OrderStatus::Filled;
+    } else if (filled > 0) {
+        report.status = OrderStatus::PartiallyFilled;
+    } else if (resting.count > 0) {
+        report.status = OrderStatus::New;
+    } else if (rejected == plan.count) {
+        report.status = OrderStatus::Rejected;
+    } else {
+        report.status = OrderStatus::Cancelled;
+    }
+
+    if (resting.count > 0) sweep_orders_.insert(request.id, resting);     // Room checked by route_order()
+    return report;
+}
+
+ExecutionReport OrderRouter::cancel_sweep(OrderId order_id) {
+    const SweepOrder sweep = *sweep_orders_.find(order_id);
+    sweep_orders_.erase(order_id);  // Children still resting after this are unknown to the venue anyway
+
+    ExecutionReport report{};
+    report.order_id = order_id;
+    report.status = OrderStatus::Rejected;
+    report.timestamp = ThreadClock::now();
+
+    for (size_t k = 0; k < sweep.count; ++k) {
+        ExchangeSimulator* exchange = find_exchange(sweep.exchanges[k]);
+        if (!exchange) continue;
+        ExecutionReport child_report = exchange->cancel_order(sweep.child_ids[k]);
+        if (child_report.status == OrderStatus::Cancelled) {
+            report.status = OrderStatus::Cancelled;
+            report.exchange = child_report.exchange;
+        }
+        report.exec_id = child_report.exec_id;
+        report.timestamp = std::max(report.timestamp, child_report.timestamp);
+    }
+    return report;
+}
+
 } // namespace trading
@@ -1,12 +1,14 @@
 #include "strategy/pairs_trading.hpp"
 #include <cmath>
-#include <numeric>
 #include <algorithm>
 
 namespace trading {
 
 PairsTradingStrategy::PairsTradingStrategy(const Params& params)
     : params_(params)
+    , hedge_ratio_(params.hedge_ratio)
+    , hedge_estimator_(params.hedge_ratio, params.hedge_window, params.min_hedge_samples)
+    , spread_alpha_(2.0 / (static_cast<double>(params.lookback_window) + 1.0))
 {
     next_order_id_ = params.base_order_id;
 }
@@ -58,48 +60,77 @@ void PairsTradingStrategy::on_execution_report(const ExecutionReport& report) {
 }
 
 void PairsTradingStrategy::update_spread() {
-    double spread = static_cast<double>(price_a_) - params_.hedge_ratio * static_cast<double>(price_b_);
-    spreads_.push_back(spread);
+    double a = static_cast<double>(price_a_);
+    double b = static_cast<double>(price_b_);
 
-    if (spreads_.size() < 20) {
+    if (params_.dynamic_hedge_ratio) {
+        hedge_estimator_.update(b, a);
+        retune_hedge_ratio();
+    }
+
+    double spread = a - hedge_ratio_ * b;
+    ++spread_samples_;
+
+    if (spread_samples_ == 1) {
+        spread_mean_ = spread;
+        spread_var_ = 0.0;
         z_score_ = 0.0;
         return;
     }
 
-    // Compute rolling mean and stddev
-    double sum = 0.0;
-    double sum_sq = 0.0;
-    size_t n = spreads_.size();
+    // Exponentially decayed mean/variance (West's incremental form)
+    double diff = spread - spread_mean_;
+    spread_mean_ += spread_alpha_ * diff;
+    spread_var_ = (1.0 - spread_alpha_) * (spread_var_ + spread_alpha_ * diff * diff);
 
-    for (size_t i = 0; i < n; ++i) {
-        double v = spreads_[i];
-        sum += v;
-        sum_sq += v * v;
+    if (spread_samples_ < MIN_SPREAD_SAMPLES) {
+        z_score_ = 0.0;
+        return;
     }
 
-    double mean = sum / static_cast<double>(n);
-    double variance = (sum_sq / static_cast<double>(n)) - (mean * mean);
-    double stddev = std::sqrt(std::max(0.0, variance));
-
+    double stddev = std::sqrt(spread_var_);
     if (stddev < 1e-10) {
         z_score_ = 0.0;
         return;
     }
 
-    z_score_ = (spread - mean) / stddev;
+    z_score_ = (spread - spread_mean_) / stddev;
+}
+
+void PairsTradingStrategy::retune_hedge_ratio() noexcept {
+    // Exits are judged on the spread the position was entered on
+    if (state_ != State::Flat) return;
+    double beta = hedge_estimator_.beta();
+    if (std::abs(beta - hedge_ratio_) <= params_.hedge_retune_threshold * std::abs(hedge_ratio_)) return;
+
+    // A - beta*B steps by (beta' - beta)*B: restart the statistics on the new spread
+    hedge_ratio_ = beta;
+    spread_samples_ = 0;
+}
+
+Side PairsTradingStrategy::hedge_side(Side side_a) const noexcept {
+    // Spread is A - beta*B: B offsets A only while beta > 0; with beta < 0
+    // the spread is A + |beta|*B and B is traded alongside A
+    if (hedge_ratio_ < 0.0) return side_a;
+    return side_a == Side::Buy ? Side::Sell : Side::Buy;
+}
+
+Quantity PairsTradingStrategy::hedge_quantity() const noexcept {
+    double qty = std::round(static_cast<double>(params_.order_size) * std::abs(hedge_ratio_));
+    return std::max<Quantity>(1, static_cast<Quantity>(qty));
 }
 
 std::span<const OrderRequest> PairsTradingStrategy::generate_orders() {
     order_count_ = 0;
 
-    if (spreads_.size() < 20) return {};
+    if (spread_samples_ < MIN_SPREAD_SAMPLES) return {};
 
-    Timestamp now = now_ns();
+    Timestamp now = ThreadClock::now();
 
     switch (state_) {
         case State::Flat:
             if (z_score_ > params_.entry_z_threshold) {
-                // Spread is rich: sell A, buy B
+                // Spread is rich: sell A, buy beta*B
                 state_ = State::ShortSpread;
                 {
                     OrderRequest& req = order_buffer_[order_count_++];
@@ -116,15 +147,15 @@ std::span<const OrderRequest> PairsTradingStrategy::generate_orders() {
                     OrderRequest& req = order_buffer_[order_count_++];
                     req.id = alloc_order_id();
                     req.instrument = params_.instrument_b;
-                    req.side = Side::Buy;
+                    req.side = hedge_side(Side::Sell);
                     req.type = OrderType::Limit;
                     req.price = price_b_;
-                    req.quantity = static_cast<Quantity>(params_.order_size * params_.hedge_ratio);
+                    req.quantity = hedge_quantity();
                     req.timestamp = now;
                     req.exchange = 0;
                 }
             } else if (z_score_ < -params_.entry_z_threshold) {
-                // Spread is cheap: buy A, sell B
+                // Spread is cheap: buy A, sell beta*B
                 state_ = State::LongSpread;
                 {
                     OrderRequest& req = order_buffer_[order_count_++];
@@ -141,10 +172,10 @@ std::span<const OrderRequest> PairsTradingStrategy::generate_orders() {
                     OrderRequest& req = order_buffer_[order_count_++];
                     req.id = alloc_order_id();
                     req.instrument = params_.instrument_b;
-                    req.side = Side::Sell;
+                    req.side = hedge_side(Side::Buy);
                     req.type = OrderType::Limit;
                     req.price = price_b_;
-                    req.quantity = static_cast<Quantity>(params_.order_size * params_.hedge_ratio);
+                    req.quantity = hedge_quantity();
                     req.timestamp = now;
                     req.exchange = 0;
                 }
@@ -166,14 +197,15 @@ std::span<const OrderRequest> PairsTradingStrategy::generate_orders() {
                     req.timestamp = now;
                     req.exchange = 0;
                 }
-                if (position_b_ > 0) {
+                if (position_b_ != 0) {
+                    // Either side: the hedge leg's side follows the sign of beta at entry
                     OrderRequest& req = order_buffer_[order_count_++];
                     req.id = alloc_order_id();
                     req.instrument = params_.instrument_b;
-                    req.side = Side::Sell;
+                    req.side = position_b_ > 0 ? Side::Sell : Side::Buy;
                     req.type = OrderType::Limit;
                     req.price = price_b_;
-                    req.quantity = static_cast<Quantity>(position_b_);
+                    req.quantity = static_cast<Quantity>(position_b_ > 0 ? position_b_ : -position_b_);
                     req.timestamp = now;
                     req.exchange = 0;
                 }
@@ -195,14 +227,15 @@ std::span<const OrderRequest> PairsTradingStrategy::generate_orders() {
                     req.timestamp = now;
                     req.exchange = 0;
                 }
-                if (position_b_ < 0) {
+                if (position_b_ != 0) {
+                    // Either side: the hedge leg's side follows the sign of beta at entry
                     OrderRequest& req = order_buffer_[order_count_++];
                     req.id = alloc_order_id();
                     req.instrument = params_.instrument_b;
-                    req.side = Side::Buy;
+                    req.side = position_b_ > 0 ? Side::Sell : Side::Buy;
                     req.type = OrderType::Limit;
                     req.price = price_b_;
-                    req.quantity = static_cast<Quantity>(-position_b_);
+                    req.quantity = static_cast<Quantity>(position_b_ > 0 ? position_b_ : -position_b_);
                     req.timestamp = now;
                     req.exchange = 0;
                 }
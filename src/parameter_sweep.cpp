@@ -0,0 +1,129 @@
+#include "backtest/parameter_sweep.hpp"
+#include "strategy/strategy_set.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace trading {
+
+bool set_sweep_parameter(SystemConfig& config, std::string_view key, double value) noexcept {
+    auto as_int = [](double v) { return static_cast<int>(v + (v >= 0 ? 0.5 : -0.5)); };
+
+    if (key == "market_maker_spread_bps") { config.market_maker_spread_bps = value; return true; }
+    if (key == "market_maker_max_inventory") { config.market_maker_max_inventory = as_int(value); return true; }
+    if (key == "pairs_lookback_window") { config.pairs_lookback_window = as_int(value); return true; }
+    if (key == "pairs_entry_z") { config.pairs_entry_z = value; return true; }
+    if (key == "pairs_exit_z") { config.pairs_exit_z = value; return true; }
+    if (key == "momentum_fast_window") { config.momentum_fast_window = as_int(value); return true; }
+    if (key == "momentum_slow_window") { config.momentum_slow_window = as_int(value); return true; }
+    if (key == "momentum_breakout_bps") { config.momentum_breakout_bps = value; return true; }
+    return false;
+}
+
+BacktestResult run_strategy_backtest(const SystemConfig& config, const BacktestConfig& backtest,
+                                     std::span<const MarketDataMessage> events) {
+    StrategySet strategies(config);
+
+    BacktestConfig bt = backtest;
+    bt.risk_limits = config.risk_limits;
+    bt.record_fills = false;
+
+    BacktestEngine engine(bt);
+    for (StrategyInterface* strategy : strategies.all()) engine.add_strategy(strategy);
+    return engine.run(events);
+}
+
+ParameterSweep::ParameterSweep(const SystemConfig& base, const BacktestConfig& backtest)
+    : base_(base)
+    , backtest_(backtest)
+{}
+
+bool ParameterSweep::add_axis(const std::string& key, std::vector<double> values) {
+    SystemConfig probe = base_;
+    if (values.empty() || !set_sweep_parameter(probe, key, values.front())) return false;
+    axes_.push_back({key, std::move(values)});
+    return true;
+}
+
+size_t ParameterSweep::point_count() const noexcept {
+    size_t count = 1;
+    for (const Axis& axis : axes_) count *= axis.values.size();
+    return count;
+}
+
+std::vector<double> ParameterSweep::point_values(size_t point) const {
+    // Mixed-radix decode, last axis least significant
+    std::vector<double> values(axes_.size());
+    for (size_t a = axes_.size(); a-- > 0;) {
+        size_t n = axes_[a].values.size();
+        values[a] = axes_[a].values[point % n];
+        point /= n;
+    }
+    return values;
+}
+
+SystemConfig ParameterSweep::point_config(size_t point) const {
+    SystemConfig config = base_;
+    std::vector<double> values = point_values(point);
+    for (size_t a = 0; a < axes_.size(); ++a) {
+        set_sweep_parameter(config, axes_[a].key, values[a]);
+    }
+    return config;
+}
+
+const std::vector<BacktestResult>& ParameterSweep::run(std::span<const MarketDataMessage> events,
+                                                       size_t threads) {
+    const size_t points = point_count();
+    results_.assign(points, BacktestResult{});
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, points);
+
+    std::atomic<size_t> cursor{0};
+    auto worker = [&] {
+        for (;;) {
+            size_t point = cursor.fetch_add(1, std::memory_order_relaxed);
+            if (point >= points) return;
+            results_[point] = run_strategy_backtest(point_config(point), backtest_, events);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker(); // The calling thread takes a share too
+    for (auto& th : pool) th.join();
+    wall_seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return results_;
+}
+
+bool ParameterSweep::write_csv(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    for (const Axis& axis : axes_) std::fprintf(file, "%s,", axis.key.c_str());
+    std::fprintf(file, "events,orders_sent,orders_rejected,fills,filled_quantity,"
+                       "realized_pnl,total_pnl,wall_seconds\n");
+
+    for (size_t p = 0; p < results_.size(); ++p) {
+        for (double v : point_values(p)) std::fprintf(file, "%g,", v);
+        const BacktestResult& r = results_[p];
+        std::fprintf(file, "%lu,%lu,%lu,%lu,%lu,%.2f,%.2f,%.6f\n",
+                     static_cast<unsigned long>(r.events),
+                     static_cast<unsigned long>(r.orders_sent),
+                     static_cast<unsigned long>(r.orders_rejected),
+                     static_cast<unsigned long>(r.fills),
+                     static_cast<unsigned long>(r.filled_quantity),
+                     r.realized_pnl, r.total_pnl, r.wall_seconds);
+    }
+
+    return std::fclose(file) == 0;
+}
+
+} // namespace trading
@@ -0,0 +1,66 @@
+#include "monitoring/pnl_monitor.hpp"
+#include "common/utils.hpp"
+
+namespace trading {
+
+PnlMonitor::PnlMonitor(KillSwitch& halts, double max_drawdown_pct) noexcept
+    : halts_(halts)
+    , max_drawdown_(max_drawdown_pct / 100.0)
+{
+}
+
+PnlMonitor::~PnlMonitor() {
+    stop();
+}
+
+bool PnlMonitor::evaluate() noexcept {
+    uint64_t version = snapshot_.version();
+    if (version == last_version_) return false;   // Nothing new since last step
+    last_version_ = version;
+    evaluations_.fetch_add(1, std::memory_order_relaxed);
+
+    const Snapshot snap = snapshot_.load();
+    const double pnl = static_cast<double>(snap.total_pnl()) / PRICE_SCALE;
+
+    double peak = peak_pnl_.load(std::memory_order_relaxed);
+    if (pnl > peak) {
+        peak = pnl;
+        peak_pnl_.store(peak, std::memory_order_relaxed);
+    }
+
+    // Same rule as RiskManager::on_pnl_update: drawdown relative to a positive peak
+    if (peak <= 0.0) return false;
+    double drawdown = (peak - pnl) / peak;
+    if (drawdown > max_drawdown_seen_.load(std::memory_order_relaxed)) {
+        max_drawdown_seen_.store(drawdown, std::memory_order_relaxed);
+    }
+    if (drawdown > max_drawdown_.load(std::memory_order_relaxed) && !halts_.global()) {
+        halts_.halt(HaltScope::Global);
+        return true;
+    }
+    return false;
+}
+
+void PnlMonitor::start(int core_id, std::chrono::microseconds interval) {
+    if (running_.exchange(true)) return;
+    thread_ = std::thread(&PnlMonitor::run_loop, this, core_id, interval);
+}
+
+void PnlMonitor::stop() {
+    running_.store(false, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void PnlMonitor::run_loop(int core_id, std::chrono::microseconds interval) {
+    pin_thread_to_core(core_id);
+
+    while (running_.load(std::memory_order_relaxed)) {
+        evaluate();
+        std::this_thread::sleep_for(interval);
+    }
+    evaluate();     // Final snapshot
+}
+
+} // namespace trading
@@ -1,6 +1,6 @@
 #include "risk/position_tracker.hpp"
-#include <cmath>
-#include <cstring>
+#include <algorithm>
+#include <cstdlib>
 
 namespace trading {
 
@@ -10,69 +10,90 @@ PositionTracker::PositionTracker() noexcept {
 
 void PositionTracker::reset() noexcept {
     positions_.fill(0);
-    avg_prices_.fill(0.0);
+    cost_basis_.fill(0);
     mark_prices_.fill(0);
-    instrument_pnl_.fill(0.0);
-    realized_pnl_ = 0.0;
+    instrument_pnl_.fill(0);
+    realized_pnl_ = 0;
+    total_absolute_position_ = 0;
+    gross_notional_ = 0;
+    unrealized_pnl_ = 0;
+    unmarked_cost_ = 0;
+}
+
+void PositionTracker::remove_exposure(InstrumentId instrument) noexcept {
+    int64_t pos = positions_[instrument];
+    if (pos == 0) return;
+    total_absolute_position_ -= std::abs(pos);
+    Price mark = mark_prices_[instrument];
+    if (mark > 0) {
+        gross_notional_ -= std::abs(pos) * mark;
+        unrealized_pnl_ -= pos * mark - cost_basis_[instrument];
+    } else {
+        unmarked_cost_ -= std::abs(cost_basis_[instrument]);
+    }
+}
+
+void PositionTracker::add_exposure(InstrumentId instrument) noexcept {
+    int64_t pos = positions_[instrument];
+    if (pos == 0) return;
+    total_absolute_position_ += std::abs(pos);
+    Price mark = mark_prices_[instrument];
+    if (mark > 0) {
+        gross_notional_ += std::abs(pos) * mark;
+        unrealized_pnl_ += pos * mark - cost_basis_[instrument];
+    } else {
+        unmarked_cost_ += std::abs(cost_basis_[instrument]);
+    }
 }
 
 void PositionTracker::on_fill(InstrumentId instrument, Side side, Quantity quantity, Price price) noexcept {
     if (instrument >= MAX_INSTRUMENTS) return;
 
-    int64_t signed_qty = static_cast<int64_t>(quantity);
-    double fill_price = static_cast<double>(price) / PRICE_SCALE;
+    remove_exposure(instrument);
+
+    int64_t signed_qty = side == Side::Buy ? static_cast<int64_t>(quantity)
+                                           : -static_cast<int64_t>(quantity);
     int64_t& pos = positions_[instrument];
-    double& avg = avg_prices_[instrument];
-
-    if (side == Side::Buy) {
-        if (pos >= 0) {
-            // Adding to long position — update average
-            double total_cost = avg * static_cast<double>(pos) + fill_price * static_cast<double>(signed_qty);
-            pos += signed_qty;
-            if (pos > 0) {
-                avg = total_cost / static_cast<double>(pos);
-            }
-        } else {
-            // Covering short — realize P&L
-            int64_t cover_qty = std::min(signed_qty, -pos);
-            double pnl = static_cast<double>(cover_qty) * (avg - fill_price);
-            realized_pnl_ += pnl;
-            instrument_pnl_[instrument] += pnl;
-            pos += signed_qty;
-            if (pos > 0) {
-                avg = fill_price; // New long from scratch
-            } else if (pos == 0) {
-                avg = 0.0;
-            }
-        }
+    int64_t& cost = cost_basis_[instrument];
+
+    if (pos == 0 || (pos > 0) == (signed_qty > 0)) {
+        // Opening or adding: cost accumulates, no division
+        cost += signed_qty * price;
+        pos += signed_qty;
     } else {
-        // Sell
-        if (pos <= 0) {
-            // Adding to short position
-            double total_cost = avg * static_cast<double>(-pos) + fill_price * static_cast<double>(signed_qty);
-            pos -= signed_qty;
-            if (pos < 0) {
-                avg = total_cost / static_cast<double>(-pos);
-            }
-        } else {
-            // Selling long — realize P&L
-            int64_t sell_qty = std::min(signed_qty, pos);
-            double pnl = static_cast<double>(sell_qty) * (fill_price - avg);
-            realized_pnl_ += pnl;
-            instrument_pnl_[instrument] += pnl;
-            pos -= signed_qty;
-            if (pos < 0) {
-                avg = fill_price; // New short from scratch
-            } else if (pos == 0) {
-                avg = 0.0;
-            }
+        // Reducing, closing or flipping: realize against the basis of the
+        // closed part. Closing out takes the whole basis; a partial reduce
+        // takes its pro-rata share, leaving the rounding in the basis.
+        int64_t open = std::abs(pos);
+        int64_t closed = std::min(std::abs(signed_qty), open);
+        int64_t released = cost;
+        if (closed != open) {
+            int64_t share;
+            released = __builtin_mul_overflow(cost, closed, &share)
+                ? static_cast<int64_t>(static_cast<Int128>(cost) * closed / open)
+                : share / open;
+        }
+        int64_t closed_value = (pos > 0 ? closed : -closed) * price;
+        int64_t pnl = closed_value - released;
+        realized_pnl_ += pnl;
+        instrument_pnl_[instrument] += pnl;
+
+        cost -= released;
+        pos += signed_qty;
+        if (closed < std::abs(signed_qty)) {
+            // Flipped: the remainder opens a new position at the fill price
+            cost = pos * price;
         }
     }
+
+    add_exposure(instrument);
 }
 
 void PositionTracker::update_mark_price(InstrumentId instrument, Price price) noexcept {
     if (instrument < MAX_INSTRUMENTS) {
+        remove_exposure(instrument);
         mark_prices_[instrument] = price;
+        add_exposure(instrument);
     }
 }
 
@@ -81,49 +102,15 @@ int64_t PositionTracker::position(InstrumentId instrument) const noexcept {
     return positions_[instrument];
 }
 
-int64_t PositionTracker::total_absolute_position() const noexcept {
-    int64_t total = 0;
-    for (size_t i = 0; i < MAX_INSTRUMENTS; ++i) {
-        total += std::abs(positions_[i]);
-    }
-    return total;
-}
-
-double PositionTracker::unrealized_pnl() const noexcept {
-    double pnl = 0.0;
-    for (size_t i = 0; i < MAX_INSTRUMENTS; ++i) {
-        if (positions_[i] != 0 && mark_prices_[i] != 0) {
-            double mark = static_cast<double>(mark_prices_[i]) / PRICE_SCALE;
-            if (positions_[i] > 0) {
-                pnl += static_cast<double>(positions_[i]) * (mark - avg_prices_[i]);
-            } else {
-                pnl += static_cast<double>(-positions_[i]) * (avg_prices_[i] - mark);
-            }
-        }
-    }
-    return pnl;
-}
-
-double PositionTracker::total_pnl() const noexcept {
-    return realized_pnl_ + unrealized_pnl();
+int64_t PositionTracker::cost_basis(InstrumentId instrument) const noexcept {
+    if (instrument >= MAX_INSTRUMENTS) return 0;
+    return cost_basis_[instrument];
 }
 
 double PositionTracker::avg_price(InstrumentId instrument) const noexcept {
-    if (instrument >= MAX_INSTRUMENTS) return 0.0;
-    return avg_prices_[instrument];
-}
-
-double PositionTracker::capital_used() const noexcept {
-    double capital = 0.0;
-    for (size_t i = 0; i < MAX_INSTRUMENTS; ++i) {
-        if (positions_[i] != 0) {
-            double price = (mark_prices_[i] > 0)
-                ? static_cast<double>(mark_prices_[i]) / PRICE_SCALE
-                : avg_prices_[i];
-            capital += std::abs(static_cast<double>(positions_[i])) * price;
-        }
-    }
-    return capital;
+    if (instrument >= MAX_INSTRUMENTS || positions_[instrument] == 0) return 0.0;
+    return static_cast<double>(cost_basis_[instrument]) /
+           static_cast<double>(positions_[instrument]) / PRICE_SCALE;
 }
 
 } // namespace trading
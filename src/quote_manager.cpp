@@ -0,0 +1,79 @@
+#include "strategy/quote_manager.hpp"
+
+namespace trading {
+
+QuoteManager::Action QuoteManager::evaluate(InstrumentId instrument, Side side, Price price,
+                                            Quantity quantity, Timestamp now) const noexcept {
+    if (instrument >= MAX_INSTRUMENTS) return Action::None;
+
+    const Quote& q = quote(instrument, side);
+    if (!q.live) return Action::New;
+
+    // Rate shaping: leave a live quote alone until the interval has elapsed
+    if (now - q.last_update < params_.min_update_interval_ns) return Action::None;
+
+    Price price_drift = (price > q.price) ? price - q.price : q.price - price;
+    Quantity size_drift = (quantity > q.quantity) ? quantity - q.quantity : q.quantity - quantity;
+    if (price_drift > params_.price_tolerance || size_drift > params_.size_tolerance) {
+        return Action::Replace;
+    }
+    return Action::None;
+}
+
+void QuoteManager::on_quote_sent(InstrumentId instrument, Side side, OrderId order_id,
+                                 Price price, Quantity quantity, Timestamp now) noexcept {
+    if (instrument >= MAX_INSTRUMENTS) return;
+
+    Quote& q = slot(instrument, side);
+    q.order_id = order_id;
+    q.price = price;
+    q.quantity = quantity;
+    q.last_update = now;
+    q.live = true;
+    q.acked = false;
+    ++updates_sent_;
+}
+
+void QuoteManager::on_cancel_sent(InstrumentId instrument, Side side) noexcept {
+    if (instrument >= MAX_INSTRUMENTS) return;
+
+    Quote& q = slot(instrument, side);
+    if (!q.live) return;
+    q = Quote{};
+    ++cancels_sent_;
+}
+
+void QuoteManager::on_execution_report(const ExecutionReport& report) noexcept {
+    if (report.instrument >= MAX_INSTRUMENTS) return;
+
+    for (Quote& q : quotes_[report.instrument]) {
+        if (!q.live || q.order_id != report.order_id) continue;
+
+        switch (report.status) {
+            case OrderStatus::New:
+                q.acked = true;
+                break;
+            case OrderStatus::PartiallyFilled:
+                // Only the leaves remain resting; a size drift will trigger a top-up
+                q.acked = true;
+                q.quantity = report.leaves_quantity;
+                break;
+            case OrderStatus::Filled:
+            case OrderStatus::Cancelled:
+            case OrderStatus::Rejected:
+                q = Quote{};
+                break;
+        }
+        return;
+    }
+}
+
+void QuoteManager::reset() noexcept {
+    for (auto& sides : quotes_) {
+        sides.fill(Quote{});
+    }
+    updates_sent_ = 0;
+    cancels_sent_ = 0;
+}
+
+} // namespace trading
@@ -0,0 +1,96 @@
+#include "backtest/replay_dataset.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace trading {
+
+static_assert(sizeof(ReplayDataset::Header) % alignof(MarketDataMessage) == 0,
+              "Records must stay aligned after the header");
+
+ReplayDataset::~ReplayDataset() {
+    close();
+}
+
+ReplayDataset::ReplayDataset(ReplayDataset&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr))
+    , mapping_size_(std::exchange(other.mapping_size_, 0))
+    , events_(std::exchange(other.events_, nullptr))
+    , count_(std::exchange(other.count_, 0))
+{}
+
+ReplayDataset& ReplayDataset::operator=(ReplayDataset&& other) noexcept {
+    if (this != &other) {
+        close();
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        events_ = std::exchange(other.events_, nullptr);
+        count_ = std::exchange(other.count_, 0);
+    }
+    return *this;
+}
+
+bool ReplayDataset::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file referenced
+    if (mapping == MAP_FAILED) return false;
+
+    const auto* header = static_cast<const Header*>(mapping);
+    bool valid = header->magic == MAGIC &&
+                 header->version == VERSION &&
+                 header->record_size == sizeof(MarketDataMessage) &&
+                 header->count <= (size - sizeof(Header)) / sizeof(MarketDataMessage);
+    if (!valid) {
+        munmap(mapping, size);
+        return false;
+    }
+
+    // Replay is a single forward pass
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    mapping_ = mapping;
+    mapping_size_ = size;
+    events_ = reinterpret_cast<const MarketDataMessage*>(static_cast<const char*>(mapping) + sizeof(Header));
+    count_ = static_cast<size_t>(header->count);
+    return true;
+}
+
+void ReplayDataset::close() noexcept {
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    events_ = nullptr;
+    count_ = 0;
+}
+
+bool ReplayDataset::write(const std::string& path, std::span<const MarketDataMessage> events) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    Header header{MAGIC, VERSION, static_cast<uint32_t>(sizeof(MarketDataMessage)), events.size()};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && !events.empty()) {
+        ok = std::fwrite(events.data(), sizeof(MarketDataMessage), events.size(), file) == events.size();
+    }
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+} // namespace trading
@@ -1,102 +1,73 @@
 #include "risk/risk_manager.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace trading {
 
-RiskManager::RiskManager(const RiskLimits& limits)
-    : limits_(limits)
-{
-    update_precomputed();
-    rate_window_start_ = now_ns();
+RiskManager::RiskManager(const RiskLimits& limits) {
+    fill_block(limit_blocks_[0], limits, 1);
+    active_limits_.store(&limit_blocks_[0], std::memory_order_release);
+    adopt_limits(limit_blocks_[0]);
 }
 
-void RiskManager::update_precomputed() noexcept {
-    price_deviation_threshold_ = limits_.max_price_deviation_pct / 100.0;
-    max_drawdown_threshold_ = limits_.max_drawdown_pct / 100.0;
+void RiskManager::fill_block(LimitsBlock& block, const RiskLimits& limits, uint64_t version) noexcept {
+    block.limits = limits;
+    block.price_deviation_threshold = limits.max_price_deviation_pct / 100.0;
+    block.max_drawdown_threshold = limits.max_drawdown_pct / 100.0;
+    block.price_collar_threshold = limits.price_collar_bps / 10000.0;
+    block.version = version;
 }
 
-__attribute__((hot))
-RiskCheckResult RiskManager::check_order(const OrderRequest& request, Price current_market_price) noexcept {
-    ++checks_performed_;
+void RiskManager::adopt_limits(const LimitsBlock& block) noexcept {
+    const RiskLimits& limits = block.limits;
+    rate_limiter_.set_limit(RateLimiter::Scope::Global, limits.max_orders_per_second);
+    rate_limiter_.set_limit(RateLimiter::Scope::Instrument, limits.max_orders_per_second_per_instrument);
+    rate_limiter_.set_limit(RateLimiter::Scope::Exchange, limits.max_orders_per_second_per_exchange);
+    adopted_version_ = block.version;
+    // Every earlier check has finished, so the other block is free to reuse
+    released_version_.store(block.version, std::memory_order_release);
+}
 
-    // 1. Kill switch (checked first, most critical)
-    if (kill_switch_.load(std::memory_order_acquire)) [[unlikely]] {
-        ++checks_rejected_;
-        return RiskCheckResult::KillSwitchActive;
-    }
+RiskManager::LimitsUpdate RiskManager::publish_limits(const RiskLimits& limits) noexcept {
+    if (!validate_risk_limits(limits)) return LimitsUpdate::Invalid;
 
-    // 2. Order size check (cheapest: single comparison)
-    if (request.quantity > limits_.max_order_size) [[unlikely]] {
-        ++checks_rejected_;
-        return RiskCheckResult::OrderSizeTooLarge;
+    const LimitsBlock* active = active_limits_.load(std::memory_order_acquire);
+    if (released_version_.load(std::memory_order_acquire) != active->version) {
+        return LimitsUpdate::Busy;  // Trading thread may still be reading the inactive block
     }
 
-    // 3. Position limit check (array lookup + comparison)
-    {
-        int64_t current_pos = positions_.position(request.instrument);
-        int64_t new_pos = current_pos;
-        int64_t signed_qty = static_cast<int64_t>(request.quantity);
-        if (request.side == Side::Buy) {
-            new_pos += signed_qty;
-        } else {
-            new_pos -= signed_qty;
-        }
-
-        if (std::abs(new_pos) > limits_.max_position_per_instrument) [[unlikely]] {
-            ++checks_rejected_;
-            return RiskCheckResult::PositionLimitBreached;
-        }
+    LimitsBlock& next = active == &limit_blocks_[0] ? limit_blocks_[1] : limit_blocks_[0];
+    fill_block(next, limits, active->version + 1);
+    active_limits_.store(&next, std::memory_order_release);
+    return LimitsUpdate::Published;
+}
 
-        // Total position check
-        int64_t total = positions_.total_absolute_position();
-        int64_t delta = std::abs(new_pos) - std::abs(current_pos);
-        if (total + delta > limits_.max_total_position) [[unlikely]] {
-            ++checks_rejected_;
-            return RiskCheckResult::PositionLimitBreached;
-        }
-    }
+bool RiskManager::set_limits(const RiskLimits& limits) noexcept {
+    current_limits();   // Finish any pending publish so ours is never Busy
+    if (publish_limits(limits) != LimitsUpdate::Published) return false;
+    current_limits();
+    return true;
+}
 
-    // 4. Capital limit check
-    {
-        double capital = positions_.capital_used();
-        double order_value = static_cast<double>(request.quantity) *
-                             static_cast<double>(request.price) / PRICE_SCALE;
-        if (capital + order_value > limits_.max_capital) [[unlikely]] {
-            ++checks_rejected_;
-            return RiskCheckResult::CapitalLimitBreached;
-        }
-    }
+__attribute__((hot))
+RiskCheckResult RiskManager::check_order(const OrderRequest& request, Price current_market_price) noexcept {
+    return check_order_with<DefaultRiskPipeline>(request, current_market_price);
+}
 
-    // 5. Order rate check
-    {
-        Timestamp now = now_ns();
-        constexpr Timestamp ONE_SECOND_NS = 1'000'000'000ULL;
-        if (now - rate_window_start_ >= ONE_SECOND_NS) {
-            rate_window_start_ = now;
-            order_count_in_window_ = 0;
-        }
-        ++order_count_in_window_;
-        if (order_count_in_window_ > limits_.max_orders_per_second) [[unlikely]] {
-            ++checks_rejected_;
-            return RiskCheckResult::OrderRateExceeded;
-        }
-    }
+size_t RiskManager::check_orders(std::span<const OrderRequest> orders,
+                                 std::span<RiskCheckResult> results) noexcept {
+    return check_orders_with<DefaultRiskPipeline>(orders, results);
+}
 
-    // 6. Fat finger check (price deviation from market)
-    // Uses multiplication instead of division:
-    // |order_price - market_price| > market_price * threshold
-    if (current_market_price > 0) {
-        int64_t price_diff = std::abs(request.price - current_market_price);
-        // threshold check via multiplication to avoid division
-        double diff_d = static_cast<double>(price_diff);
-        double market_d = static_cast<double>(current_market_price);
-        if (diff_d > market_d * price_deviation_threshold_) [[unlikely]] {
-            ++checks_rejected_;
-            return RiskCheckResult::FatFingerPrice;
-        }
+size_t RiskManager::finish_batch(std::span<const OrderRequest> orders,
+                                 std::span<const RiskCheckResult> results) noexcept {
+    size_t approved = 0;
+    for (size_t i = 0; i < orders.size(); ++i) {
+        const OrderRequest& request = orders[i];
+        if (request.instrument < MAX_INSTRUMENTS) batch_pending_[request.instrument] = {};
+        approved += results[i] == RiskCheckResult::Approved;
     }
-
-    return RiskCheckResult::Approved;
+    return approved;
 }
 
 void RiskManager::on_pnl_update(double total_pnl) noexcept {
@@ -107,7 +78,7 @@ void RiskManager::on_pnl_update(double total_pnl) noexcept {
     // Check drawdown
     if (peak_pnl_ > 0.0) {
         double drawdown = (peak_pnl_ - total_pnl) / peak_pnl_;
-        if (drawdown > max_drawdown_threshold_) {
+        if (drawdown > current_limits().max_drawdown_threshold) {
             activate_kill_switch();
         }
     }
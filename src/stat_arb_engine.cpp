@@ -0,0 +1,229 @@
+#include "strategy/stat_arb_engine.hpp"
+#include <cmath>
+#include <algorithm>
+
+namespace trading {
+
+StatArbEngine::StatArbEngine(const Params& params)
+    : params_(params)
+    , alpha_(2.0 / (static_cast<double>(params.lookback_window) + 1.0))
+{
+    next_order_id_ = params.base_order_id;
+
+    leg_a_.reserve(MAX_PAIRS);
+    leg_b_.reserve(MAX_PAIRS);
+    hedge_.reserve(MAX_PAIRS);
+    mean_.reserve(MAX_PAIRS);
+    var_.reserve(MAX_PAIRS);
+    z_.reserve(MAX_PAIRS);
+    samples_.reserve(MAX_PAIRS);
+    state_.reserve(MAX_PAIRS);
+    entered_a_.reserve(MAX_PAIRS);
+    entered_b_.reserve(MAX_PAIRS);
+    dirty_flag_.reserve(MAX_PAIRS);
+    dirty_.reserve(MAX_PAIRS);
+    index_pairs_.reserve(2 * MAX_PAIRS);
+}
+
+int StatArbEngine::add_pair(const PairConfig& pair) {
+    if (finalized_ || leg_a_.size() >= MAX_PAIRS) return -1;
+    if (pair.leg_a >= MAX_INSTRUMENTS || pair.leg_b >= MAX_INSTRUMENTS) return -1;
+    if (pair.leg_a == pair.leg_b) return -1;
+
+    leg_a_.push_back(pair.leg_a);
+    leg_b_.push_back(pair.leg_b);
+    hedge_.push_back(pair.hedge_ratio);
+    mean_.push_back(0.0);
+    var_.push_back(0.0);
+    z_.push_back(0.0);
+    samples_.push_back(0);
+    state_.push_back(0);
+    entered_a_.push_back(0);
+    entered_b_.push_back(0);
+    dirty_flag_.push_back(0);
+    return static_cast<int>(leg_a_.size() - 1);
+}
+
+void StatArbEngine::finalize() {
+    // Counting sort of (instrument, pair) edges into CSR form
+    std::array<uint32_t, MAX_INSTRUMENTS> counts{};
+    for (size_t p = 0; p < leg_a_.size(); ++p) {
+        ++counts[leg_a_[p]];
+        ++counts[leg_b_[p]];
+    }
+
+    index_offsets_[0] = 0;
+    for (size_t i = 0; i < MAX_INSTRUMENTS; ++i) {
+        index_offsets_[i + 1] = index_offsets_[i] + counts[i];
+    }
+
+    index_pairs_.assign(index_offsets_[MAX_INSTRUMENTS], 0);
+    std::array<uint32_t, MAX_INSTRUMENTS> cursor{};
+    for (size_t i = 0; i < MAX_INSTRUMENTS; ++i) cursor[i] = index_offsets_[i];
+    for (size_t p = 0; p < leg_a_.size(); ++p) {
+        index_pairs_[cursor[leg_a_[p]]++] = static_cast<uint32_t>(p);
+        index_pairs_[cursor[leg_b_[p]]++] = static_cast<uint32_t>(p);
+    }
+
+    finalized_ = true;
+}
+
+void StatArbEngine::on_market_data(const MarketDataMessage& md) {
+    if (md.instrument >= MAX_INSTRUMENTS) return;
+
+    Price mid = (md.bid_price + md.ask_price) / 2;
+    if (mid <= 0 && md.last_price > 0) mid = md.last_price;
+    if (mid <= 0) return;
+
+    on_mid(md.instrument, mid);
+}
+
+void StatArbEngine::on_order_book_update(InstrumentId instrument,
+                                          Price best_bid, Quantity bid_qty,
+                                          Price best_ask, Quantity ask_qty) {
+    if (instrument >= MAX_INSTRUMENTS) return;
+    Price mid = (best_bid + best_ask) / 2;
+    if (mid <= 0) return;
+
+    on_mid(instrument, mid);
+}
+
+void StatArbEngine::on_mid(InstrumentId instrument, Price mid) {
+    mids_[instrument] = mid;
+    if (!finalized_) return;
+
+    uint32_t begin = index_offsets_[instrument];
+    uint32_t end = index_offsets_[instrument + 1];
+    last_touched_ = end - begin;
+    if (begin == end) return;
+
+    const uint32_t* pairs = index_pairs_.data() + begin;
+    update_pairs(pairs, end - begin);
+
+    for (size_t k = 0; k < end - begin; ++k) {
+        uint32_t p = pairs[k];
+        if (!dirty_flag_[p]) {
+            dirty_flag_[p] = 1;
+            dirty_.push_back(p); // Capacity reserved for MAX_PAIRS
+        }
+    }
+}
+
+void StatArbEngine::update_pairs(const uint32_t* pairs, size_t count) noexcept {
+    const Price* mids = mids_.data();
+    const InstrumentId* leg_a = leg_a_.data();
+    const InstrumentId* leg_b = leg_b_.data();
+    const double* hedge = hedge_.data();
+    double* mean = mean_.data();
+    double* var = var_.data();
+    double* z = z_.data();
+    uint32_t* samples = samples_.data();
+    const double alpha = alpha_;
+
+    // Branch-free body: selects instead of early-outs so the loop vectorizes
+    for (size_t k = 0; k < count; ++k) {
+        uint32_t p = pairs[k];
+        Price a = mids[leg_a[p]];
+        Price b = mids[leg_b[p]];
+        bool valid = (a > 0) & (b > 0);
+
+        double spread = static_cast<double>(a) - hedge[p] * static_cast<double>(b);
+        uint32_t n = samples[p];
+
+        // First sample seeds the mean (weight 1); invalid ticks leave state untouched
+        double w = valid ? (n == 0 ? 1.0 : alpha) : 0.0;
+        double diff = spread - mean[p];
+        double m = mean[p] + w * diff;
+        double v = (1.0 - w) * (var[p] + w * diff * diff);
+        n += valid ? 1u : 0u;
+
+        double sd = std::sqrt(v);
+        bool ready = (n >= MIN_SPREAD_SAMPLES) & (sd >= 1e-10);
+        double zz = ready ? (spread - m) / (ready ? sd : 1.0) : 0.0;
+
+        mean[p] = m;
+        var[p] = v;
+        samples[p] = n;
+        z[p] = valid ? zz : z[p];
+    }
+}
+
+void StatArbEngine::on_trade(const Trade& trade) {}
+
+void StatArbEngine::on_execution_report(const ExecutionReport& report) {}
+
+void StatArbEngine::emit(InstrumentId instrument, Side side, Quantity quantity, Timestamp now) {
+    OrderRequest& req = signal_buffer_[order_count_++];
+    req.id = alloc_order_id();
+    req.instrument = instrument;
+    req.side = side;
+    req.type = OrderType::Limit;
+    req.price = mids_[instrument];
+    req.quantity = quantity;
+    req.timestamp = now;
+    req.exchange = 0;
+    req.action = OrderAction::New;
+    req.orig_id = 0;
+}
+
+std::span<const OrderRequest> StatArbEngine::generate_orders() {
+    order_count_ = 0;
+    if (dirty_.empty()) return {};
+
+    Timestamp now = ThreadClock::now();
+    const double entry = params_.entry_z_threshold;
+    const double exit = params_.exit_z_threshold;
+
+    size_t processed = 0;
+    for (; processed < dirty_.size(); ++processed) {
+        // Every transition emits at most two legs
+        if (order_count_ + 2 > MAX_ORDERS_PER_TICK) break;
+
+        uint32_t p = dirty_[processed];
+        dirty_flag_[p] = 0;
+        if (samples_[p] < MIN_SPREAD_SAMPLES) continue;
+
+        double z = z_[p];
+        InstrumentId a = leg_a_[p];
+        InstrumentId b = leg_b_[p];
+
+        if (state_[p] == 0) {
+            if (z > entry || z < -entry) {
+                // z > entry: spread rich → sell A, buy hedge·B. z < -entry: the reverse.
+                // A negative hedge ratio trades B on the same side as A
+                int8_t dir = (z > entry) ? -1 : 1;
+                double hedge_qty = std::round(static_cast<double>(params_.order_size) * std::abs(hedge_[p]));
+                Quantity qty_b = std::max<Quantity>(1, static_cast<Quantity>(hedge_qty));
+                int8_t dir_b = hedge_[p] < 0.0 ? dir : static_cast<int8_t>(-dir);
+
+                emit(a, dir > 0 ? Side::Buy : Side::Sell, params_.order_size, now);
+                emit(b, dir_b > 0 ? Side::Buy : Side::Sell, qty_b, now);
+
+                state_[p] = dir;
+                entered_a_[p] = dir * static_cast<int64_t>(params_.order_size);
+                entered_b_[p] = dir_b * static_cast<int64_t>(qty_b);
+            }
+        } else if ((state_[p] < 0 && z < exit) || (state_[p] > 0 && z > -exit)) {
+            if (entered_a_[p] != 0) {
+                emit(a, entered_a_[p] > 0 ? Side::Sell : Side::Buy,
+                     static_cast<Quantity>(std::abs(entered_a_[p])), now);
+            }
+            if (entered_b_[p] != 0) {
+                emit(b, entered_b_[p] > 0 ? Side::Sell : Side::Buy,
+                     static_cast<Quantity>(std::abs(entered_b_[p])), now);
+            }
+            state_[p] = 0;
+            entered_a_[p] = 0;
+            entered_b_[p] = 0;
+        }
+    }
+
+    // Keep pairs we did not get to for the next call
+    dirty_.erase(dirty_.begin(), dirty_.begin() + static_cast<std::ptrdiff_t>(processed));
+
+    return std::span<const OrderRequest>(signal_buffer_.data(), order_count_);
+}
+
+void StatArbEngine::on_timer(Timestamp now) {}
+
+} // namespace trading
@@ -0,0 +1,33 @@
+#include "strategy/strategy_set.hpp"
+
+namespace trading {
+
+MarketMakerStrategy::Params market_maker_params(const SystemConfig& config) noexcept {
+    MarketMakerStrategy::Params params;
+    params.base_spread_bps = config.market_maker_spread_bps;
+    params.max_inventory = config.market_maker_max_inventory;
+    params.order_size = 10;
+    params.instrument = 0;
+    return params;
+}
+
+PairsTradingStrategy::Params pairs_params(const SystemConfig& config) noexcept {
+    PairsTradingStrategy::Params params;
+    params.instrument_a = 0;
+    params.instrument_b = 1;
+    params.lookback_window = static_cast<size_t>(config.pairs_lookback_window);
+    params.entry_z_threshold = config.pairs_entry_z;
+    params.exit_z_threshold = config.pairs_exit_z;
+    return params;
+}
+
+MomentumStrategy::Params momentum_params(const SystemConfig& config) noexcept {
+    MomentumStrategy::Params params;
+    params.instrument = 0;
+    params.fast_window = config.momentum_fast_window;
+    params.slow_window = config.momentum_slow_window;
+    params.breakout_threshold_bps = config.momentum_breakout_bps;
+    return params;
+}
+
+} // namespace trading
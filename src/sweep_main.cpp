@@ -0,0 +1,159 @@
+#include "backtest/parameter_sweep.hpp"
+#include "backtest/replay_dataset.hpp"
+#include "common/config.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage(const char* prog) {
+    printf("Usage: %s --data FILE [options] [--grid KEY=VALUES]...\n\n", prog);
+    printf("  --data FILE        Replay data: .csv (recorded format) or binary replay file\n");
+    printf("  --convert FILE     Write --data as a binary replay file and exit\n");
+    printf("  --config FILE      Base system config (default: built-in defaults)\n");
+    printf("  --threads N        Worker threads (default: all cores)\n");
+    printf("  --out FILE         Results CSV (default: sweep_results.csv)\n");
+    printf("  --latency NS       Order and report latency in ns (default: 5000)\n");
+    printf("  --grid KEY=VALUES  Sweep a system_config.json strategy key over\n");
+    printf("                     v1,v2,... or start:stop:step\n");
+}
+
+bool ends_with(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+/// "1,2,5" or "1:10:0.5" (inclusive)
+bool parse_values(const std::string& spec, std::vector<double>& out) {
+    size_t c1 = spec.find(':');
+    if (c1 != std::string::npos) {
+        size_t c2 = spec.find(':', c1 + 1);
+        if (c2 == std::string::npos) return false;
+        double start = std::atof(spec.substr(0, c1).c_str());
+        double stop = std::atof(spec.substr(c1 + 1, c2 - c1 - 1).c_str());
+        double step = std::atof(spec.substr(c2 + 1).c_str());
+        if (step <= 0.0 || stop < start) return false;
+        for (size_t i = 0; start + static_cast<double>(i) * step <= stop + step * 1e-9; ++i) {
+            out.push_back(start + static_cast<double>(i) * step);
+        }
+        return !out.empty();
+    }
+
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t comma = spec.find(',', pos);
+        if (comma == std::string::npos) comma = spec.size();
+        if (comma > pos) out.push_back(std::atof(spec.substr(pos, comma - pos).c_str()));
+        pos = comma + 1;
+    }
+    return !out.empty();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    using namespace trading;
+
+    std::string data_path;
+    std::string convert_path;
+    std::string config_path;
+    std::string out_path = "sweep_results.csv";
+    size_t threads = 0;
+    BacktestConfig backtest;
+    std::vector<std::string> grids;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--data" && has_value) data_path = argv[++i];
+        else if (arg == "--convert" && has_value) convert_path = argv[++i];
+        else if (arg == "--config" && has_value) config_path = argv[++i];
+        else if (arg == "--threads" && has_value) threads = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--out" && has_value) out_path = argv[++i];
+        else if (arg == "--latency" && has_value) {
+            backtest.order_latency_ns = std::strtoull(argv[++i], nullptr, 10);
+            backtest.report_latency_ns = backtest.order_latency_ns;
+        }
+        else if (arg == "--grid" && has_value) grids.push_back(argv[++i]);
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (data_path.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // --- Load data: CSV into memory, or map a binary replay file ---
+    std::vector<MarketDataMessage> csv_events;
+    ReplayDataset dataset;
+    std::span<const MarketDataMessage> events;
+
+    if (ends_with(data_path, ".csv")) {
+        if (!load_market_data_csv(data_path, csv_events)) {
+            fprintf(stderr, "Failed to load %s\n", data_path.c_str());
+            return 1;
+        }
+        events = csv_events;
+    } else {
+        if (!dataset.open(data_path)) {
+            fprintf(stderr, "Failed to map replay file %s\n", data_path.c_str());
+            return 1;
+        }
+        events = dataset.events();
+    }
+    printf("Loaded %zu events from %s\n", events.size(), data_path.c_str());
+
+    if (!convert_path.empty()) {
+        if (!ReplayDataset::write(convert_path, events)) {
+            fprintf(stderr, "Failed to write %s\n", convert_path.c_str());
+            return 1;
+        }
+        printf("Wrote replay file %s\n", convert_path.c_str());
+        return 0;
+    }
+
+    // --- Build grid ---
+    SystemConfig base = config_path.empty() ? default_config() : load_config(config_path);
+    ParameterSweep sweep(base, backtest);
+
+    for (const std::string& grid : grids) {
+        size_t eq = grid.find('=');
+        std::vector<double> values;
+        if (eq == std::string::npos || !parse_values(grid.substr(eq + 1), values) ||
+            !sweep.add_axis(grid.substr(0, eq), std::move(values))) {
+            fprintf(stderr, "Invalid grid '%s'\n", grid.c_str());
+            return 1;
+        }
+    }
+
+    printf("Running %zu backtests...\n", sweep.point_count());
+    const auto& results = sweep.run(events, threads);
+
+    if (!sweep.write_csv(out_path)) {
+        fprintf(stderr, "Failed to write %s\n", out_path.c_str());
+        return 1;
+    }
+
+    // --- Summary ---
+    size_t best = 0;
+    for (size_t p = 1; p < results.size(); ++p) {
+        if (results[p].total_pnl > results[best].total_pnl) best = p;
+    }
+    double total_events = static_cast<double>(events.size()) * static_cast<double>(results.size());
+    printf("  Wall time:    %.3f s\n", sweep.wall_seconds());
+    printf("  Throughput:   %.1f M events/s\n", total_events / sweep.wall_seconds() / 1e6);
+    printf("  Best P&L:     $%.2f (point %zu:", results[best].total_pnl, best);
+    auto values = sweep.point_values(best);
+    for (size_t a = 0; a < values.size(); ++a) {
+        printf(" %s=%g", sweep.axes()[a].key.c_str(), values[a]);
+    }
+    printf(")\n  Results:      %s\n", out_path.c_str());
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "common/tsc_clock.hpp"
+
+#if TRADING_HAS_TSC
+#include <cpuid.h>
+#endif
+
+namespace trading {
+
+namespace {
+
+struct ClockPair {
+    uint64_t tsc;
+    Timestamp ns;
+};
+
+/// Pair a TSC reading with CLOCK_MONOTONIC: keep the sample whose
+/// clock_gettime call was bracketed most tightly by two TSC reads.
+ClockPair sample_pair() noexcept {
+    ClockPair best{0, 0};
+    uint64_t best_window = ~0ULL;
+    for (int i = 0; i < 16; ++i) {
+        uint64_t before = TscClock::start();
+        Timestamp ns = now_ns();
+        uint64_t after = TscClock::stop();
+        if (after - before < best_window) {
+            best_window = after - before;
+            best = {before + (after - before) / 2, ns};
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+bool TscClock::invariant_tsc() noexcept {
+#if TRADING_HAS_TSC
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) return false;
+    __cpuid(0x80000007, eax, ebx, ecx, edx);
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool TscClock::calibrate(uint64_t duration_ns) noexcept {
+    if (!invariant_tsc()) return false;
+
+    ClockPair first = sample_pair();
+    while (now_ns() - first.ns < duration_ns) {
+        // Spin: sleeping would let the core drop into a deep C-state
+    }
+    ClockPair second = sample_pair();
+
+    uint64_t cycles = second.tsc - first.tsc;
+    uint64_t ns = second.ns - first.ns;
+    if (cycles == 0 || ns == 0) return false;
+
+    calibration_.mult = static_cast<uint64_t>(
+        (static_cast<UInt128>(ns) << SHIFT) / cycles);
+    calibration_.base_tsc = second.tsc;
+    calibration_.base_ns = second.ns;
+    calibration_.valid = true;
+    return true;
+}
+
+} // namespace trading
@@ -0,0 +1,77 @@
+#include "risk/working_orders.hpp"
+
+namespace trading {
+
+WorkingOrders::WorkingOrders() noexcept {
+    reset();
+}
+
+void WorkingOrders::reset() noexcept {
+    orders_.clear();
+    pending_.fill(Pending{});
+    worst_quantity_ = 0;
+    worst_notional_ = 0;
+}
+
+void WorkingOrders::adjust(InstrumentId instrument, Side side, int64_t quantity, Price price) noexcept {
+    worst_quantity_ -= worst_case_quantity(instrument);
+    worst_notional_ -= worst_case_notional(instrument);
+    Pending& pending = pending_[instrument];
+    if (side == Side::Buy) {
+        pending.buy += quantity;
+        pending.buy_notional += quantity * price;
+    } else {
+        pending.sell += quantity;
+        pending.sell_notional += quantity * price;
+    }
+    worst_quantity_ += worst_case_quantity(instrument);
+    worst_notional_ += worst_case_notional(instrument);
+}
+
+void WorkingOrders::drop(OrderId id) noexcept {
+    const Order* order = orders_.find(id);
+    if (!order) return;
+    adjust(order->instrument, order->side, -static_cast<int64_t>(order->leaves), order->price);
+    orders_.erase(id);
+}
+
+bool WorkingOrders::on_order_sent(const OrderRequest& request) noexcept {
+    if (request.action == OrderAction::Cancel) return true;
+    if (request.instrument >= MAX_INSTRUMENTS || request.quantity == 0) [[unlikely]] return false;
+
+    drop(request.id); // Reused id: the old entry is stale
+    Order order{request.instrument, request.side, request.type, request.price, request.quantity,
+                request.action == OrderAction::Replace ? request.orig_id : 0};
+    if (!orders_.insert(request.id, order)) [[unlikely]] return false;
+    adjust(order.instrument, order.side, static_cast<int64_t>(order.leaves), order.price);
+    return true;
+}
+
+void WorkingOrders::on_execution_report(const ExecutionReport& report) noexcept {
+    Order* order = orders_.find(report.order_id);
+    if (!order) return;
+
+    if (order->replaces != 0) {
+        OrderId original = order->replaces;
+        order->replaces = 0;
+        drop(original);
+        order = orders_.find(report.order_id); // erase may have moved it
+    }
+
+    bool still_working = order->type == OrderType::Limit &&
+        (report.status == OrderStatus::New || report.status == OrderStatus::PartiallyFilled) &&
+        report.leaves_quantity > 0;
+    if (!still_working) {
+        drop(report.order_id);
+        return;
+    }
+
+    if (report.leaves_quantity < order->leaves) {
+        adjust(order->instrument, order->side,
+               static_cast<int64_t>(report.leaves_quantity) - static_cast<int64_t>(order->leaves),
+               order->price);
+        order->leaves = report.leaves_quantity;
+    }
+}
+
+} // namespace trading
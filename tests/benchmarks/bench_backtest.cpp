@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include "backtest/backtest_engine.hpp"
+#include "backtest/parameter_sweep.hpp"
+#include "strategy/market_maker.hpp"
+#include "strategy/momentum.hpp"
+#include <random>
+#include <vector>
+
+using namespace trading;
+
+static const std::vector<MarketDataMessage>& session() {
+    // One synthetic session: random walk over 4 instruments, ~1us apart
+    static const std::vector<MarketDataMessage> events = [] {
+        std::vector<MarketDataMessage> out;
+        out.reserve(1'000'000);
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> step(-2, 2);
+        std::array<Price, 4> mids{15000, 28000, 9000, 12000};
+        Timestamp t = 1'000'000'000;
+        for (size_t i = 0; i < 1'000'000; ++i) {
+            InstrumentId inst = static_cast<InstrumentId>(i % mids.size());
+            mids[inst] += step(rng);
+            t += 500 + rng() % 1000;
+            MarketDataMessage md{};
+            md.instrument = inst;
+            md.bid_price = mids[inst] - 3;
+            md.ask_price = mids[inst] + 3;
+            md.bid_quantity = 100 + rng() % 100;
+            md.ask_quantity = 100 + rng() % 100;
+            md.last_price = mids[inst] + step(rng) * 2;
+            md.last_quantity = rng() % 50;
+            md.timestamp = t;
+            md.msg_type = 'W';
+            out.push_back(md);
+        }
+        return out;
+    }();
+    return events;
+}
+
+// Engine overhead: replay with a strategy that only consumes data
+static void BM_BacktestReplayMomentum(benchmark::State& state) {
+    const auto& events = session();
+    for (auto _ : state) {
+        MomentumStrategy::Params params;
+        params.breakout_threshold_bps = 1e9; // Never trades
+        MomentumStrategy strategy(params);
+        BacktestEngine engine(BacktestConfig{});
+        engine.add_strategy(&strategy);
+        auto result = engine.run(events);
+        benchmark::DoNotOptimize(result.total_pnl);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+}
+BENCHMARK(BM_BacktestReplayMomentum)->Unit(benchmark::kMillisecond);
+
+// Quoting strategy: orders, cancel/replace, passive fills, risk checks
+static void BM_BacktestReplayMarketMaker(benchmark::State& state) {
+    const auto& events = session();
+    uint64_t fills = 0;
+    for (auto _ : state) {
+        MarketMakerStrategy::Params params;
+        params.base_spread_bps = 4.0;
+        MarketMakerStrategy strategy(params);
+        BacktestConfig config;
+        config.record_fills = false;
+        BacktestEngine engine(config);
+        engine.add_strategy(&strategy);
+        auto result = engine.run(events);
+        fills = result.fills;
+        benchmark::DoNotOptimize(result.total_pnl);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+    state.counters["fills"] = static_cast<double>(fills);
+}
+BENCHMARK(BM_BacktestReplayMarketMaker)->Unit(benchmark::kMillisecond);
+
+// Grid of 8 full backtests; compare items/s across thread counts for scaling
+static void BM_ParameterSweep(benchmark::State& state) {
+    const auto& events = session();
+    const size_t threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        ParameterSweep sweep(default_config(), BacktestConfig{});
+        sweep.add_axis("market_maker_spread_bps", {2.0, 4.0, 6.0, 8.0});
+        sweep.add_axis("pairs_entry_z", {1.5, 2.5});
+        const auto& results = sweep.run(events, threads);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 8 * static_cast<int64_t>(events.size()));
+}
+BENCHMARK(BM_ParameterSweep)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
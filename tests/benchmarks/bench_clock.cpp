@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include "common/clock.hpp"
+
+using namespace trading;
+
+static void BM_NowNs(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(now_ns());
+    }
+}
+BENCHMARK(BM_NowNs);
+
+static void BM_Rdtsc(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::rdtsc());
+    }
+}
+BENCHMARK(BM_Rdtsc);
+
+static void BM_TscNow(benchmark::State& state) {
+    TscClock::calibrate();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::now());
+    }
+}
+BENCHMARK(BM_TscNow);
+
+static void BM_CycleTimer(benchmark::State& state) {
+    CycleTimer timer;
+    for (auto _ : state) {
+        timer.start();
+        benchmark::DoNotOptimize(timer.stop());
+    }
+}
+BENCHMARK(BM_CycleTimer);
+
+static void BM_ThreadClockTsc(benchmark::State& state) {
+    TscClock::calibrate();
+    ThreadClock::use_tsc();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ThreadClock::now());
+    }
+    ThreadClock::use_system();
+}
+BENCHMARK(BM_ThreadClockTsc);
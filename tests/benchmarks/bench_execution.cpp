@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
 #include "execution/execution_engine.hpp"
+#include "execution/order_manager.hpp"
+#include "execution/order_router.hpp"
+#include <memory>
+#include <vector>
 
 using namespace trading;
 
@@ -29,4 +33,129 @@ static void BM_ExecutionEngineProcess(benchmark::State& state) {
 }
 BENCHMARK(BM_ExecutionEngineProcess);
 
+// Event-driven send path with range(0) orders outstanding: send, then deliver
+// whatever the venue latency has released. Simulated time advances 1us per
+// order, so in-flight settles at latency / 1us.
+static void BM_ExecutionEngineAsync(benchmark::State& state) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    const uint64_t latency_ns = static_cast<uint64_t>(state.range(0)) * 1000;
+    engine.add_exchange({0, "TEST", latency_ns, 1.0, true});
+    engine.seed_books(15000, 10, 10000);
+    engine.set_rate_limit(0);
+    SimulatedClockScope clock(1);
+
+    OrderId id = 1;
+    ExecutionReport report;
+    for (auto _ : state) {
+        OrderRequest req{};
+        req.id = id++;
+        req.instrument = 0;
+        req.side = Side::Buy;
+        req.type = OrderType::Limit;
+        req.price = 15000;
+        req.quantity = 10;
+
+        engine.send_order(req);
+        ThreadClock::advance(1000);
+        engine.deliver_reports(ThreadClock::now());
+        while (output.try_pop(report)) benchmark::DoNotOptimize(report);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["in_flight"] = static_cast<double>(engine.in_flight());
+}
+BENCHMARK(BM_ExecutionEngineAsync)->Arg(1)->Arg(64)->Arg(1024);
+
+// BestPrice routing decision across all MAX_EXCHANGES venues: read top-of-book
+// depth everywhere and split range(0) shares (100 fits one level, 4000 sweeps
+// most of the displayed depth)
+static void BM_RouterPlanSweep(benchmark::State& state) {
+    std::vector<std::unique_ptr<ExchangeSimulator>> venues;
+    OrderRouter router;
+    for (ExchangeId i = 0; i < MAX_EXCHANGES; ++i) {
+        ExchangeConfig config{i, "VENUE", 100, 1.0, true, 0.1 * (i % 4)};
+        venues.push_back(std::make_unique<ExchangeSimulator>(config));
+        venues.back()->seed_book(15000 + static_cast<Price>(i % 5), 10, 100);
+        router.add_exchange(venues.back().get());
+    }
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+
+    OrderRequest req{};
+    req.id = 1;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 15010;
+    req.quantity = static_cast<Quantity>(state.range(0));
+
+    OrderRouter::SweepPlan plan;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(router.plan_sweep(req, plan));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["children"] = static_cast<double>(plan.count);
+}
+BENCHMARK(BM_RouterPlanSweep)->Arg(100)->Arg(4000);
+
+// Per-report venue model update (EWMA + P² tail + fill rate), random venue
+// out of 16
+static void BM_RouterLatencyModel(benchmark::State& state) {
+    std::vector<std::unique_ptr<ExchangeSimulator>> venues;
+    OrderRouter router;
+    for (ExchangeId i = 0; i < MAX_EXCHANGES; ++i) {
+        venues.push_back(std::make_unique<ExchangeSimulator>(ExchangeConfig{i, "VENUE", 1000, 1.0, true}));
+        router.add_exchange(venues.back().get());
+    }
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::LowestLatency);
+
+    uint64_t sample = 1;
+    for (auto _ : state) {
+        sample = sample * 6364136223846793005ULL + 1442695040888963407ULL;
+        auto exchange = static_cast<ExchangeId>(sample >> 60);
+        router.record_latency(exchange, 1000 + (sample >> 50) % 4096);
+        router.record_fill_outcome(exchange, (sample >> 40) % 16 != 0);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["predicted_ns"] = router.predicted_latency_ns(0);
+}
+BENCHMARK(BM_RouterLatencyModel);
+
+// One order's life through the order manager: open, ack, partial fill, fill
+static void BM_OrderManagerLifecycle(benchmark::State& state) {
+    auto orders = std::make_unique<OrderManager>();
+    OrderRequest req{};
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 15000;
+    req.quantity = 100;
+    ExecutionReport report{};
+    report.price = 15000;
+    report.quantity = 100;
+    ExecutionReport publish;
+
+    OrderId id = 1;
+    for (auto _ : state) {
+        req.id = id;
+        orders->open(req);
+        report.order_id = id;
+        report.exec_id = id * 3;
+        report.status = OrderStatus::New;
+        report.filled_quantity = 0;
+        orders->on_report(report, OrderAction::New, publish);
+        report.exec_id = id * 3 + 1;
+        report.status = OrderStatus::PartiallyFilled;
+        report.filled_quantity = 40;
+        orders->on_report(report, OrderAction::New, publish);
+        report.exec_id = id * 3 + 2;
+        report.status = OrderStatus::Filled;
+        report.filled_quantity = 100;
+        orders->on_report(report, OrderAction::New, publish);
+        benchmark::DoNotOptimize(publish);
+        ++id;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderManagerLifecycle);
+
 BENCHMARK_MAIN();
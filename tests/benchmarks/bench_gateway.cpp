@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include "common/clock.hpp"
+#include "execution/exchange_gateway.hpp"
+#include "execution/fix_order_encoder.hpp"
+#include "execution/gateway_transport.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace trading;
+
+namespace {
+
+OrderRequest make_order(OrderId id) {
+    OrderRequest req{};
+    req.id = id;
+    req.instrument = 0;
+    req.side = (id & 1) ? Side::Buy : Side::Sell;
+    req.type = OrderType::IOC;     // Never rests: the book stays the same size
+    req.price = (id & 1) ? 14000 : 16000;
+    req.quantity = 10;
+    return req;
+}
+
+} // namespace
+
+// Wire round trip over loopback TCP: encode D, write, gateway parses and
+// matches, encodes 8, client reads and decodes. range(0) orders per write.
+static void BM_GatewayRoundTrip(benchmark::State& state) {
+    ExchangeGateway gateway(ExchangeConfig{0, "BENCH", 0, 1.0, true});
+    if (!gateway.listen()) {
+        state.SkipWithError("listen failed");
+        return;
+    }
+    gateway.start(1);
+    GatewayTransport transport(0);
+    if (!transport.connect(gateway.port())) {
+        state.SkipWithError("logon failed");
+        gateway.stop();
+        return;
+    }
+
+    const size_t batch = static_cast<size_t>(state.range(0));
+    OrderId id = 1;
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch; ++i) transport.send_order(make_order(id++));
+        transport.flush();
+        size_t received = 0;
+        while (received < batch && transport.connected()) {
+            received += transport.poll_reports([](const ExecutionReport& report, OrderId) {
+                benchmark::DoNotOptimize(report);
+            });
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+
+    transport.disconnect();
+    gateway.stop();
+}
+BENCHMARK(BM_GatewayRoundTrip)->Arg(1)->Arg(16)->Arg(64)->UseRealTime();
+
+// Field-by-field FixSession::Writer encode + queue (no socket write), for comparison
+static void BM_GatewayEncodeNewOrder(benchmark::State& state) {
+    FixSession session("CLIENT", "EXCHANGE");
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        state.SkipWithError("socketpair failed");
+        return;
+    }
+    session.attach(fds[0]);
+    OrderId id = 1;
+    for (auto _ : state) {
+        OrderRequest req = make_order(id++);
+        FixSession::Writer writer = session.begin("D");
+        writer.field(11, req.id)
+              .field(55, static_cast<uint64_t>(req.instrument))
+              .field(54, '1')
+              .field(38, req.quantity)
+              .field(40, '2')
+              .price(44, req.price)
+              .field(59, '3');
+        benchmark::DoNotOptimize(session.send(writer));
+        if (id % FixSession::MAX_BATCH == 0) {
+            state.PauseTiming();
+            session.flush();
+            char sink[64 * 1024];
+            while (::recv(fds[1], sink, sizeof(sink), MSG_DONTWAIT) > 0) {}
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    ::close(fds[1]);
+}
+BENCHMARK(BM_GatewayEncodeNewOrder);
+
+// Template encoder: copy, patch variable fields, incremental checksum
+static void BM_FixOrderEncoder(benchmark::State& state) {
+    FixOrderEncoder encoder("CLIENT", "EXCHANGE");
+    const OrderAction action = static_cast<OrderAction>(state.range(0));
+    alignas(64) char out[FixOrderEncoder::MAX_MESSAGE_SIZE];
+    ThreadClock::use_cached();      // As on the engine thread: one clock read per send batch
+    OrderId id = 1;
+    for (auto _ : state) {
+        if ((id & 63) == 0) ThreadClock::refresh();
+        OrderRequest req = make_order(id);
+        req.action = action;
+        req.orig_id = id - 1;
+        benchmark::DoNotOptimize(encoder.encode(req, id++, out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    ThreadClock::use_system();
+}
+BENCHMARK(BM_FixOrderEncoder)->ArgName("action")->Arg(0)->Arg(1)->Arg(2);
+
+BENCHMARK_MAIN();
@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 #include "risk/risk_manager.hpp"
+#include "monitoring/pnl_monitor.hpp"
+#include <vector>
 
 using namespace trading;
 
@@ -29,6 +31,35 @@ static void BM_RiskCheckApproved(benchmark::State& state) {
 }
 BENCHMARK(BM_RiskCheckApproved);
 
+// Same check with the per-loop cached clock the strategy thread uses
+static void BM_RiskCheckCachedClock(benchmark::State& state) {
+    RiskLimits limits;
+    limits.max_position_per_instrument = 100000;
+    limits.max_total_position = 500000;
+    limits.max_capital = 100'000'000.0;
+    limits.max_order_size = 10000;
+    limits.max_orders_per_second = 1000000;
+    limits.max_price_deviation_pct = 50.0;
+    RiskManager mgr(limits);
+
+    OrderRequest req{};
+    req.id = 1;
+    req.instrument = 0;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 15000;
+    req.quantity = 10;
+    req.timestamp = now_ns();
+
+    ThreadClock::use_cached();
+    for (auto _ : state) {
+        auto result = mgr.check_order(req, 15000);
+        benchmark::DoNotOptimize(result);
+    }
+    ThreadClock::use_system();
+}
+BENCHMARK(BM_RiskCheckCachedClock);
+
 static void BM_RiskCheckWithPosition(benchmark::State& state) {
     RiskLimits limits;
     limits.max_position_per_instrument = 100000;
@@ -59,6 +90,94 @@ static void BM_RiskCheckWithPosition(benchmark::State& state) {
 }
 BENCHMARK(BM_RiskCheckWithPosition);
 
+// Open positions across the whole instrument universe: position and capital
+// aggregates are read on every check
+static void BM_RiskCheckFullUniverse(benchmark::State& state) {
+    RiskLimits limits;
+    limits.max_position_per_instrument = 100000;
+    limits.max_total_position = 50'000'000;
+    limits.max_capital = 1e12;
+    limits.max_order_size = 10000;
+    limits.max_orders_per_second = ~0u;
+    limits.max_price_deviation_pct = 50.0;
+    RiskManager mgr(limits);
+
+    for (InstrumentId i = 0; i < MAX_INSTRUMENTS; ++i) {
+        mgr.position_tracker().on_fill(i, (i & 1) ? Side::Sell : Side::Buy, 100 + i, 10000 + i);
+        mgr.position_tracker().update_mark_price(i, 10000 + i);
+    }
+
+    OrderRequest req{};
+    req.id = 1;
+    req.instrument = 0;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 10000;
+    req.quantity = 10;
+
+    ThreadClock::use_cached();
+    for (auto _ : state) {
+        auto result = mgr.check_order(req, 10000);
+        benchmark::DoNotOptimize(result);
+    }
+    ThreadClock::use_system();
+}
+BENCHMARK(BM_RiskCheckFullUniverse);
+
+// Fill + mark update cost, which now carries the aggregate maintenance
+static void BM_PositionFillAndMark(benchmark::State& state) {
+    PositionTracker tracker;
+    InstrumentId i = 0;
+    Side side = Side::Buy;
+    for (auto _ : state) {
+        tracker.on_fill(i, side, 10, 15000);
+        tracker.update_mark_price(i, 15001);
+        i = (i + 1) & (MAX_INSTRUMENTS - 1);
+        if (i == 0) side = side == Side::Buy ? Side::Sell : Side::Buy;
+    }
+    benchmark::DoNotOptimize(tracker.total_absolute_position());
+}
+BENCHMARK(BM_PositionFillAndMark);
+
+// Fill accounting on a realistic mix: adds, partial reduces, flats and flips
+// across 16 instruments, with a mark update every fourth fill
+static void BM_PositionFillThroughput(benchmark::State& state) {
+    constexpr size_t N = 4096;
+    struct Fill { InstrumentId instrument; Side side; Quantity quantity; Price price; };
+    std::vector<Fill> fills(N);
+    uint64_t x = 88172645463325252ULL;
+    for (auto& f : fills) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        f = {static_cast<InstrumentId>(x % 16), (x >> 8) & 1 ? Side::Buy : Side::Sell,
+             1 + (x >> 16) % 100, 14900 + static_cast<Price>((x >> 32) % 200)};
+    }
+
+    PositionTracker tracker;
+    size_t i = 0;
+    for (auto _ : state) {
+        const Fill& f = fills[i];
+        tracker.on_fill(f.instrument, f.side, f.quantity, f.price);
+        if ((i & 3) == 0) tracker.update_mark_price(f.instrument, f.price);
+        i = (i + 1) & (N - 1);
+    }
+    benchmark::DoNotOptimize(tracker.realized_pnl());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PositionFillThroughput);
+
+// Drawdown check input after every report
+static void BM_PositionTotalPnl(benchmark::State& state) {
+    PositionTracker tracker;
+    for (InstrumentId i = 0; i < 16; ++i) {
+        tracker.on_fill(i, Side::Buy, 100, 15000);
+        tracker.update_mark_price(i, 15010);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tracker.total_pnl());
+    }
+}
+BENCHMARK(BM_PositionTotalPnl);
+
 static void BM_RiskCheckKillSwitch(benchmark::State& state) {
     RiskLimits limits;
     RiskManager mgr(limits);
@@ -79,4 +198,260 @@ static void BM_RiskCheckKillSwitch(benchmark::State& state) {
 }
 BENCHMARK(BM_RiskCheckKillSwitch);
 
+// Approved order while other strategies/instruments/exchanges are halted:
+// the halt test is two loads either way
+static void BM_RiskCheckScopedHalts(benchmark::State& state) {
+    RiskLimits limits;
+    limits.max_position_per_instrument = 100000;
+    limits.max_total_position = 500000;
+    limits.max_capital = 100'000'000.0;
+    limits.max_order_size = 10000;
+    limits.max_orders_per_second = 0;
+    limits.max_price_deviation_pct = 50.0;
+    RiskManager mgr(limits);
+    if (state.range(0)) {
+        mgr.kill_switch().halt(HaltScope::Instrument, 1);
+        mgr.kill_switch().halt(HaltScope::Strategy, 1);
+        mgr.kill_switch().halt(HaltScope::Exchange, 1);
+    }
+
+    OrderRequest req{};
+    req.id = 1;
+    req.instrument = 0;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 15000;
+    req.quantity = 10;
+
+    ThreadClock::use_cached();
+    for (auto _ : state) {
+        auto result = mgr.check_order(req, 15000);
+        benchmark::DoNotOptimize(result);
+    }
+    ThreadClock::use_system();
+}
+BENCHMARK(BM_RiskCheckScopedHalts)->Arg(0)->Arg(1);
+
+// N orders one at a time vs one check_orders call; orders alternate side
+// so none breach limits and every check runs to the end
+static std::vector<OrderRequest> make_batch(size_t n) {
+    std::vector<OrderRequest> orders(n);
+    for (size_t i = 0; i < n; ++i) {
+        OrderRequest& req = orders[i];
+        req.id = i + 1;
+        req.instrument = static_cast<InstrumentId>(i % 4);
+        req.side = (i & 1) ? Side::Sell : Side::Buy;
+        req.type = OrderType::Limit;
+        req.price = 15000 + static_cast<Price>(i % 7);
+        req.quantity = 10;
+    }
+    return orders;
+}
+
+static RiskLimits batch_limits() {
+    RiskLimits limits;
+    limits.max_position_per_instrument = 100000;
+    limits.max_total_position = 500000;
+    limits.max_capital = 100'000'000.0;
+    limits.max_order_size = 10000;
+    limits.max_orders_per_second = ~0u;
+    limits.max_price_deviation_pct = 50.0;
+    return limits;
+}
+
+static void BM_RiskCheckScalarLoop(benchmark::State& state) {
+    RiskManager mgr(batch_limits());
+    auto orders = make_batch(static_cast<size_t>(state.range(0)));
+    ThreadClock::use_cached();
+    for (auto _ : state) {
+        for (const auto& req : orders) {
+            benchmark::DoNotOptimize(mgr.check_order(req, 15000));
+        }
+    }
+    ThreadClock::use_system();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RiskCheckScalarLoop)->Arg(8)->Arg(24)->Arg(64)->Arg(256);
+
+static void BM_RiskCheckBatch(benchmark::State& state) {
+    RiskManager mgr(batch_limits());
+    for (InstrumentId i = 0; i < 4; ++i) mgr.update_market_price(i, 15000);
+    auto orders = make_batch(static_cast<size_t>(state.range(0)));
+    std::vector<RiskCheckResult> results(orders.size());
+    ThreadClock::use_cached();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mgr.check_orders(orders, results));
+        benchmark::ClobberMemory();
+    }
+    ThreadClock::use_system();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RiskCheckBatch)->Arg(8)->Arg(24)->Arg(64)->Arg(256);
+
+// Worst-case check with a thousand orders resting across the universe
+static void BM_RiskCheckWithWorkingOrders(benchmark::State& state) {
+    RiskLimits limits = batch_limits();
+    limits.max_total_position = 50'000'000;
+    limits.max_capital = 1e12;
+    RiskManager mgr(limits);
+
+    OrderRequest resting{};
+    resting.type = OrderType::Limit;
+    resting.quantity = 10;
+    for (OrderId id = 1; id <= 1000; ++id) {
+        resting.id = id;
+        resting.instrument = static_cast<InstrumentId>(id % MAX_INSTRUMENTS);
+        resting.side = (id & 1) ? Side::Sell : Side::Buy;
+        resting.price = 15000 + static_cast<Price>(id % 10);
+        mgr.on_order_sent(resting);
+    }
+
+    OrderRequest req{};
+    req.id = 5000;
+    req.instrument = 0;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 15000;
+    req.quantity = 10;
+
+    ThreadClock::use_cached();
+    for (auto _ : state) {
+        auto result = mgr.check_order(req, 15000);
+        benchmark::DoNotOptimize(result);
+    }
+    ThreadClock::use_system();
+}
+BENCHMARK(BM_RiskCheckWithWorkingOrders);
+
+// Send, acknowledge and fill: the per-order bookkeeping cost
+static void BM_WorkingOrderLifecycle(benchmark::State& state) {
+    WorkingOrders working;
+    OrderRequest req{};
+    req.type = OrderType::Limit;
+    req.price = 15000;
+    req.quantity = 10;
+    ExecutionReport report{};
+    OrderId id = 1;
+    for (auto _ : state) {
+        req.id = id;
+        req.instrument = static_cast<InstrumentId>(id & 15);
+        req.side = (id & 1) ? Side::Sell : Side::Buy;
+        working.on_order_sent(req);
+
+        report.order_id = id;
+        report.instrument = req.instrument;
+        report.status = OrderStatus::New;
+        report.leaves_quantity = 10;
+        working.on_execution_report(report);
+        report.status = OrderStatus::Filled;
+        report.leaves_quantity = 0;
+        working.on_execution_report(report);
+        ++id;
+    }
+    benchmark::DoNotOptimize(working.worst_case_quantity());
+}
+BENCHMARK(BM_WorkingOrderLifecycle);
+
+// Global, per-instrument and per-exchange buckets in one call
+static void BM_RateLimiterThreeScopes(benchmark::State& state) {
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Global, 1'000'000'000);
+    limiter.set_limit(RateLimiter::Scope::Instrument, 1'000'000'000);
+    limiter.set_limit(RateLimiter::Scope::Exchange, 1'000'000'000);
+    Timestamp now = 1'000'000'000ULL;
+    InstrumentId instrument = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(limiter.try_acquire(instrument, 0, now));
+        now += 16;
+        instrument = (instrument + 1) & 15;
+    }
+}
+BENCHMARK(BM_RateLimiterThreeScopes);
+
+// Per-check cost: each built-in check alone through a one-check pipeline,
+// then the default pipeline, on an order that passes everything
+namespace {
+using OnlyKillSwitch = RiskPipeline<risk_checks::KillSwitch>;
+using OnlyOrderSize = RiskPipeline<risk_checks::OrderSize>;
+using OnlyPosition = RiskPipeline<risk_checks::Position>;
+using OnlyCapital = RiskPipeline<risk_checks::Capital>;
+using OnlyRate = RiskPipeline<risk_checks::Rate>;
+using OnlyFatFinger = RiskPipeline<risk_checks::FatFinger>;
+using OnlyMaxNotional = RiskPipeline<risk_checks::MaxNotional>;
+using OnlyPriceCollar = RiskPipeline<risk_checks::PriceCollar>;
+using NoCapital = RiskPipeline<risk_checks::KillSwitch, risk_checks::OrderSize, risk_checks::Position,
+                               risk_checks::Rate, risk_checks::FatFinger>;
+}
+
+template<typename Pipeline>
+static void BM_RiskPipeline(benchmark::State& state) {
+    RiskLimits limits;
+    limits.max_position_per_instrument = 100000;
+    limits.max_total_position = 500000;
+    limits.max_capital = 100'000'000.0;
+    limits.max_order_size = 10000;
+    limits.max_orders_per_second = 1'000'000'000;   // Enabled, never binding
+    limits.max_price_deviation_pct = 50.0;
+    limits.max_order_notional = 1'000'000.0;
+    limits.price_collar_bps = 500.0;
+    RiskManager mgr(limits);
+    mgr.position_tracker().on_fill(0, Side::Buy, 100, 15000);
+
+    OrderRequest req{};
+    req.id = 1;
+    req.instrument = 0;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 15000;
+    req.quantity = 10;
+
+    // Simulated time advances 1us per order so the rate check keeps passing
+    ThreadClock::use_simulated(1'000'000'000);
+    for (auto _ : state) {
+        ThreadClock::advance(1000);
+        auto result = mgr.check_order_with<Pipeline>(req, 15000);
+        benchmark::DoNotOptimize(result);
+    }
+    ThreadClock::use_system();
+}
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyKillSwitch);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyOrderSize);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyPosition);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyCapital);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyRate);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyFatFinger);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyMaxNotional);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, OnlyPriceCollar);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, NoCapital);
+BENCHMARK_TEMPLATE(BM_RiskPipeline, DefaultRiskPipeline);
+
+// Per-report cost on the trading thread: inline drawdown check vs publishing
+// a seqlock snapshot for the monitoring core
+static void BM_PnlDrawdownInline(benchmark::State& state) {
+    RiskLimits limits;
+    RiskManager mgr(limits);
+    PositionTracker& positions = mgr.position_tracker();
+    for (InstrumentId i = 0; i < 16; ++i) positions.on_fill(i, Side::Buy, 100, 15000);
+    Price mark = 15000;
+    for (auto _ : state) {
+        positions.update_mark_price(3, ++mark);
+        mgr.on_pnl_update(positions.total_pnl());
+    }
+}
+BENCHMARK(BM_PnlDrawdownInline);
+
+static void BM_PnlMonitorPublish(benchmark::State& state) {
+    KillSwitch halts;
+    PnlMonitor monitor(halts, 2.0);
+    PositionTracker positions;
+    for (InstrumentId i = 0; i < 16; ++i) positions.on_fill(i, Side::Buy, 100, 15000);
+    Price mark = 15000;
+    Timestamp now = 0;
+    for (auto _ : state) {
+        positions.update_mark_price(3, ++mark);
+        monitor.publish(positions, ++now);
+    }
+}
+BENCHMARK(BM_PnlMonitorPublish);
+
 BENCHMARK_MAIN();
@@ -2,6 +2,9 @@
 #include "strategy/market_maker.hpp"
 #include "strategy/pairs_trading.hpp"
 #include "strategy/momentum.hpp"
+#include "strategy/stat_arb_engine.hpp"
+#include "strategy/features.hpp"
+#include <vector>
 
 using namespace trading;
 
@@ -74,4 +77,56 @@ static void BM_MomentumSignal(benchmark::State& state) {
 }
 BENCHMARK(BM_MomentumSignal);
 
+// Per-tick cost scales with the pairs touching the updated instrument,
+// not with the total number of pairs.
+static void BM_StatArbTick(benchmark::State& state) {
+    const size_t num_pairs = static_cast<size_t>(state.range(0));
+    StatArbEngine::Params params;
+    StatArbEngine engine(params);
+
+    // Spread pairs across the universe so each instrument sits in ~2*N/256 pairs
+    for (size_t p = 0; p < num_pairs; ++p) {
+        InstrumentId a = static_cast<InstrumentId>(p % MAX_INSTRUMENTS);
+        InstrumentId b = static_cast<InstrumentId>((p * 7 + 1 + p / MAX_INSTRUMENTS) % MAX_INSTRUMENTS);
+        if (a == b) b = (b + 1) % MAX_INSTRUMENTS;
+        engine.add_pair({a, b, 1.0});
+    }
+    engine.finalize();
+
+    for (InstrumentId i = 0; i < MAX_INSTRUMENTS; ++i) {
+        for (int k = 0; k < 30; ++k) {
+            engine.on_market_data(make_md(i, 15000 + k % 3, 15010 + k % 3));
+        }
+    }
+    engine.generate_orders();
+
+    InstrumentId inst = 0;
+    int tick = 0;
+    for (auto _ : state) {
+        engine.on_market_data(make_md(inst, 15000 + tick % 5, 15010 + tick % 5));
+        auto orders = engine.generate_orders();
+        benchmark::DoNotOptimize(orders.data());
+        inst = (inst + 1) % MAX_INSTRUMENTS;
+        ++tick;
+    }
+    state.counters["pairs_per_tick"] = static_cast<double>(2 * num_pairs) / MAX_INSTRUMENTS;
+}
+BENCHMARK(BM_StatArbTick)->Arg(256)->Arg(1024)->Arg(4096);
+
+// EWMA mean/variance for every instrument in one pass
+static void BM_EwmaVarianceBatch(benchmark::State& state) {
+    std::vector<double> mean(MAX_INSTRUMENTS, 15000.0);
+    std::vector<double> var(MAX_INSTRUMENTS, 0.0);
+    std::vector<double> x(MAX_INSTRUMENTS);
+    for (size_t i = 0; i < MAX_INSTRUMENTS; ++i) x[i] = 15000.0 + static_cast<double>(i % 7);
+
+    const double alpha = ema_alpha(100);
+    for (auto _ : state) {
+        ewma_variance_update_batch(mean.data(), var.data(), x.data(), MAX_INSTRUMENTS, alpha);
+        benchmark::DoNotOptimize(var.data());
+    }
+    state.SetItemsProcessed(state.iterations() * MAX_INSTRUMENTS);
+}
+BENCHMARK(BM_EwmaVarianceBatch);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+#include "backtest/backtest_engine.hpp"
+#include "strategy/market_maker.hpp"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+
+/// Sends a scripted list of orders on the first event, records what it hears.
+class ScriptedStrategy : public StrategyInterface {
+public:
+    std::vector<OrderRequest> script;
+    std::vector<ExecutionReport> reports;
+    std::vector<Timestamp> report_times;
+    bool sent = false;
+
+    void on_market_data(const MarketDataMessage&) override {}
+    void on_order_book_update(InstrumentId, Price, Quantity, Price, Quantity) override {}
+    void on_trade(const Trade&) override {}
+    void on_execution_report(const ExecutionReport& report) override {
+        reports.push_back(report);
+        report_times.push_back(ThreadClock::now());
+    }
+    std::span<const OrderRequest> generate_orders() override {
+        order_count_ = 0;
+        if (sent) return {};
+        sent = true;
+        for (const auto& req : script) order_buffer_[order_count_++] = req;
+        return std::span<const OrderRequest>(order_buffer_.data(), order_count_);
+    }
+    void on_timer(Timestamp) override {}
+    std::string_view name() const override { return "Scripted"; }
+};
+
+MarketDataMessage make_md(Timestamp t, Price bid, Price ask, Quantity qty = 100) {
+    MarketDataMessage md{};
+    md.instrument = 0;
+    md.bid_price = bid;
+    md.ask_price = ask;
+    md.bid_quantity = qty;
+    md.ask_quantity = qty;
+    md.timestamp = t;
+    md.msg_type = 'W';
+    return md;
+}
+
+OrderRequest make_order(OrderId id, Side side, Price price, Quantity qty,
+                        OrderType type = OrderType::Limit) {
+    OrderRequest req{};
+    req.id = id;
+    req.instrument = 0;
+    req.side = side;
+    req.type = type;
+    req.price = price;
+    req.quantity = qty;
+    return req;
+}
+
+std::vector<MarketDataMessage> random_walk(size_t n, uint32_t seed) {
+    std::vector<MarketDataMessage> events;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> step(-2, 2);
+    Price mid = 15000;
+    Timestamp t = 1'000'000'000;
+    for (size_t i = 0; i < n; ++i) {
+        mid += step(rng);
+        t += 1000 + rng() % 1000;
+        auto md = make_md(t, mid - 5, mid + 5, 50 + rng() % 100);
+        md.last_price = mid + step(rng) * 3;
+        md.last_quantity = rng() % 50;
+        events.push_back(md);
+    }
+    return events;
+}
+
+BacktestConfig make_config() {
+    BacktestConfig config;
+    config.order_latency_ns = 1000;
+    config.report_latency_ns = 500;
+    config.enable_risk_checks = false;
+    return config;
+}
+
+} // namespace
+
+TEST(BacktestEngineTest, RestingOrderAckedAfterLatency) {
+    BacktestEngine engine(make_config());
+    ScriptedStrategy strategy;
+    strategy.script.push_back(make_order(1, Side::Buy, 9990, 10));
+    engine.add_strategy(&strategy);
+
+    std::vector<MarketDataMessage> events{make_md(10'000, 9995, 10005), make_md(20'000, 9995, 10005)};
+    auto result = engine.run(events);
+
+    ASSERT_EQ(strategy.reports.size(), 1u);
+    EXPECT_EQ(strategy.reports[0].status, OrderStatus::New);
+    EXPECT_EQ(strategy.reports[0].timestamp, 11'000u);  // Exchange time
+    EXPECT_EQ(strategy.report_times[0], 11'500u);       // Delivery time
+    EXPECT_EQ(result.orders_sent, 1u);
+    EXPECT_EQ(result.fills, 0u);
+}
+
+TEST(BacktestEngineTest, DuplicateIdIsRejected) {
+    BacktestEngine engine(make_config());
+    ScriptedStrategy strategy;
+    strategy.script.push_back(make_order(1, Side::Buy, 9990, 10));
+    strategy.script.push_back(make_order(1, Side::Buy, 9980, 30));
+    engine.add_strategy(&strategy);
+
+    // The market then trades through the first order's price
+    std::vector<MarketDataMessage> events{make_md(10'000, 9995, 10005), make_md(20'000, 9985, 9989)};
+    auto result = engine.run(events);
+
+    ASSERT_GE(strategy.reports.size(), 2u);
+    EXPECT_EQ(strategy.reports[0].status, OrderStatus::New);
+    EXPECT_EQ(strategy.reports[1].status, OrderStatus::Rejected);
+    EXPECT_EQ(result.duplicate_ids, 1u);
+
+    // The original still rests with its own price and quantity
+    EXPECT_EQ(result.filled_quantity, 10u);
+    EXPECT_EQ(engine.positions().position(0), 10);
+}
+
+TEST(BacktestEngineTest, MarketableOrderTakesDisplayedQuantity) {
+    BacktestEngine engine(make_config());
+    ScriptedStrategy strategy;
+    strategy.script.push_back(make_order(1, Side::Buy, 10005, 150));
+    engine.add_strategy(&strategy);
+
+    std::vector<MarketDataMessage> events{make_md(10'000, 9995, 10005, 100)};
+    auto result = engine.run(events);
+
+    ASSERT_EQ(engine.fills().size(), 1u);
+    EXPECT_TRUE(engine.fills()[0].aggressive);
+    EXPECT_EQ(engine.fills()[0].quantity, 100u);
+    EXPECT_EQ(engine.fills()[0].price, 10005);
+    ASSERT_GE(strategy.reports.size(), 1u);
+    EXPECT_EQ(strategy.reports[0].status, OrderStatus::PartiallyFilled);
+    EXPECT_EQ(strategy.reports[0].leaves_quantity, 50u);
+    EXPECT_EQ(engine.positions().position(0), 100);
+    EXPECT_EQ(result.filled_quantity, 100u);
+}
+
+TEST(BacktestEngineTest, RestingOrderFillsWhenMarketCrosses) {
+    BacktestEngine engine(make_config());
+    ScriptedStrategy strategy;
+    strategy.script.push_back(make_order(1, Side::Buy, 9990, 10));
+    engine.add_strategy(&strategy);
+
+    std::vector<MarketDataMessage> events{
+        make_md(10'000, 9995, 10005),
+        make_md(20'000, 9980, 9990),   // Ask comes down to our bid
+    };
+    engine.run(events);
+
+    ASSERT_EQ(engine.fills().size(), 1u);
+    EXPECT_FALSE(engine.fills()[0].aggressive);
+    EXPECT_EQ(engine.fills()[0].price, 9990);
+    EXPECT_EQ(engine.fills()[0].timestamp, 20'000u);
+    ASSERT_EQ(strategy.reports.size(), 2u);
+    EXPECT_EQ(strategy.reports[1].status, OrderStatus::Filled);
+}
+
+TEST(BacktestEngineTest, CancelRemovesRestingOrder) {
+    BacktestEngine engine(make_config());
+    ScriptedStrategy strategy;
+    strategy.script.push_back(make_order(1, Side::Sell, 10010, 10));
+    OrderRequest cancel = make_order(2, Side::Sell, 10010, 10);
+    cancel.action = OrderAction::Cancel;
+    cancel.orig_id = 1;
+    strategy.script.push_back(cancel);
+    engine.add_strategy(&strategy);
+
+    std::vector<MarketDataMessage> events{
+        make_md(10'000, 9995, 10005),
+        make_md(20'000, 10015, 10020),  // Would have filled the ask
+    };
+    engine.run(events);
+
+    EXPECT_TRUE(engine.fills().empty());
+    ASSERT_EQ(strategy.reports.size(), 2u);
+    EXPECT_EQ(strategy.reports[1].status, OrderStatus::Cancelled);
+    EXPECT_EQ(strategy.reports[1].order_id, 1u);
+}
+
+TEST(BacktestEngineTest, SelfTradeCancelsRestingOrder) {
+    BacktestEngine engine(make_config());
+    ScriptedStrategy strategy;
+    strategy.script.push_back(make_order(1, Side::Sell, 10000, 10));
+    strategy.script.push_back(make_order(2, Side::Buy, 10002, 10));    // Crosses its own ask
+    engine.add_strategy(&strategy);
+
+    std::vector<MarketDataMessage> events{make_md(10'000, 9995, 10005), make_md(20'000, 9995, 10005)};
+    auto result = engine.run(events);
+
+    EXPECT_TRUE(engine.fills().empty());
+    EXPECT_EQ(result.self_trades_prevented, 1u);
+    ASSERT_EQ(strategy.reports.size(), 3u);
+    EXPECT_EQ(strategy.reports[0].order_id, 1u);
+    EXPECT_EQ(strategy.reports[0].status, OrderStatus::New);
+    EXPECT_EQ(strategy.reports[1].order_id, 1u);
+    EXPECT_EQ(strategy.reports[1].status, OrderStatus::Cancelled);
+    EXPECT_EQ(strategy.reports[2].order_id, 2u);
+    EXPECT_EQ(strategy.reports[2].status, OrderStatus::New);
+    EXPECT_EQ(engine.positions().position(0), 0);
+}
+
+TEST(BacktestEngineTest, DifferentStrategiesStillCross) {
+    BacktestEngine engine(make_config());
+    ScriptedStrategy seller;
+    ScriptedStrategy buyer;
+    seller.script.push_back(make_order(1, Side::Sell, 10000, 10));
+    buyer.script.push_back(make_order(2, Side::Buy, 10002, 10));
+    engine.add_strategy(&seller);
+    engine.add_strategy(&buyer);
+
+    std::vector<MarketDataMessage> events{make_md(10'000, 9995, 10005), make_md(20'000, 9995, 10005)};
+    auto result = engine.run(events);
+
+    EXPECT_EQ(result.self_trades_prevented, 0u);
+    ASSERT_EQ(engine.fills().size(), 2u);
+    EXPECT_EQ(engine.fills()[0].price, 10000);
+    EXPECT_EQ(engine.positions().position(0), 0);   // Net flat across both
+}
+
+TEST(BacktestEngineTest, DeterministicAcrossRuns) {
+    auto events = random_walk(20000, 11);
+
+    auto run_once = [&](std::vector<BacktestFill>& fills) {
+        MarketMakerStrategy::Params params;
+        params.base_spread_bps = 5.0;
+        MarketMakerStrategy mm(params);
+        BacktestEngine engine(make_config());
+        engine.add_strategy(&mm);
+        auto result = engine.run(events);
+        fills.assign(engine.fills().begin(), engine.fills().end());
+        return result;
+    };
+
+    std::vector<BacktestFill> fills_a, fills_b;
+    auto a = run_once(fills_a);
+    auto b = run_once(fills_b);
+
+    EXPECT_GT(a.fills, 0u);
+    EXPECT_EQ(a.fills, b.fills);
+    EXPECT_EQ(a.orders_sent, b.orders_sent);
+    EXPECT_DOUBLE_EQ(a.total_pnl, b.total_pnl);
+    ASSERT_EQ(fills_a.size(), fills_b.size());
+    for (size_t i = 0; i < fills_a.size(); ++i) {
+        EXPECT_EQ(fills_a[i].timestamp, fills_b[i].timestamp);
+        EXPECT_EQ(fills_a[i].order_id, fills_b[i].order_id);
+        EXPECT_EQ(fills_a[i].price, fills_b[i].price);
+    }
+    EXPECT_EQ(ThreadClock::mode(), ThreadClock::Mode::System); // Restored after run
+}
+
+TEST(BacktestEngineTest, LoadCsv) {
+    const char* path = "test_backtest_engine.csv";
+    {
+        std::ofstream out(path);
+        out << "timestamp,instrument,bid,ask,bid_qty,ask_qty,last,last_qty\n";
+        out << "1000000000,AAPL,149.97,150.00,164,121,149.98,198\n";
+        out << "1000000604,GOOG,279.89,279.92,266,66,279.89,17\n";
+    }
+
+    std::vector<MarketDataMessage> events;
+    ASSERT_TRUE(load_market_data_csv(path, events));
+    std::remove(path);
+
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].timestamp, 1000000000u);
+    EXPECT_EQ(events[0].instrument, 0u);
+    EXPECT_EQ(events[0].bid_price, 14997);
+    EXPECT_EQ(events[0].ask_quantity, 121u);
+    EXPECT_EQ(events[1].instrument, 1u);
+    EXPECT_EQ(events[1].last_price, 27989);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "order_book/book_features.hpp"
+#include <random>
+#include <vector>
+
+using namespace trading;
+
+class BookFeaturesTest : public ::testing::Test {
+protected:
+    OrderBook book_{0};
+    BookFeatures features_{book_, 3};
+    OrderId next_id_ = 1;
+
+    void SetUp() override { book_.set_listener(&features_); }
+
+    OrderId add_limit(Side side, Price price, Quantity qty) {
+        OrderId id = next_id_++;
+        book_.add_order(id, side, OrderType::Limit, price, qty, now_ns());
+        return id;
+    }
+};
+
+TEST_F(BookFeaturesTest, EmptyBook) {
+    EXPECT_DOUBLE_EQ(features_.imbalance(), 0.0);
+    EXPECT_DOUBLE_EQ(features_.microprice(), 0.0);
+    EXPECT_EQ(features_.bid_depth(), 0u);
+}
+
+TEST_F(BookFeaturesTest, ImbalanceAndMicroprice) {
+    add_limit(Side::Buy, 9900, 300);
+    add_limit(Side::Sell, 10100, 100);
+
+    EXPECT_DOUBLE_EQ(features_.top_imbalance(), 0.5);
+    EXPECT_DOUBLE_EQ(features_.imbalance(), 0.5);
+    // Heavy bid pushes the microprice towards the ask
+    EXPECT_DOUBLE_EQ(features_.microprice(), (9900.0 * 100 + 10100.0 * 300) / 400.0);
+}
+
+TEST_F(BookFeaturesTest, WindowKeepsTopLevels) {
+    add_limit(Side::Buy, 9800, 10);
+    add_limit(Side::Buy, 9700, 10);
+    add_limit(Side::Buy, 9600, 10);
+    add_limit(Side::Buy, 9500, 10); // Outside the 3-level window
+    EXPECT_EQ(features_.bid_levels(), 3u);
+    EXPECT_EQ(features_.bid_depth(), 30u);
+
+    add_limit(Side::Buy, 9900, 40); // New best pushes 9600 out
+    EXPECT_EQ(features_.bid_depth(), 60u);
+    EXPECT_DOUBLE_EQ(features_.weighted_bid_depth(), 40.0 + 10.0 / 2 + 10.0 / 3);
+}
+
+TEST_F(BookFeaturesTest, RemovedLevelRefillsFromBook) {
+    OrderId best = add_limit(Side::Sell, 10000, 10);
+    add_limit(Side::Sell, 10100, 20);
+    add_limit(Side::Sell, 10200, 30);
+    add_limit(Side::Sell, 10300, 40);
+
+    book_.cancel_order(best);
+    EXPECT_EQ(features_.ask_levels(), 3u);
+    EXPECT_EQ(features_.ask_depth(), 90u);
+    EXPECT_EQ(features_.refreshes(), 1u);
+}
+
+TEST_F(BookFeaturesTest, SyncAfterAttach) {
+    OrderBook book(0);
+    book.add_order(1, Side::Buy, OrderType::Limit, 9900, 10, now_ns());
+    book.add_order(2, Side::Sell, OrderType::Limit, 10100, 30, now_ns());
+
+    BookFeatures features(book);
+    book.set_listener(&features);
+    features.sync();
+    EXPECT_DOUBLE_EQ(features.imbalance(), -0.5);
+}
+
+TEST_F(BookFeaturesTest, MatchesBookUnderRandomFlow) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<Price> offset(-50, 50);
+    std::uniform_int_distribution<Quantity> qty(1, 100);
+    std::vector<OrderId> ids;
+
+    for (int i = 0; i < 20000; ++i) {
+        Side side = (rng() & 1) ? Side::Buy : Side::Sell;
+        Price price = 10000 + offset(rng) + (side == Side::Buy ? -20 : 20);
+        OrderType type = (rng() % 10 == 0) ? OrderType::Market : OrderType::Limit;
+        OrderId id = next_id_++;
+        book_.add_order(id, side, type, price, qty(rng), now_ns());
+        ids.push_back(id);
+        if (ids.size() > 50 && rng() % 2 == 0) {
+            book_.cancel_order(ids[rng() % ids.size()]);
+        }
+
+        OrderBook::DepthEntry bids[3], asks[3];
+        size_t nb = book_.get_side_depth(Side::Buy, bids, 3);
+        size_t na = book_.get_side_depth(Side::Sell, asks, 3);
+        Quantity bid_sum = 0, ask_sum = 0;
+        for (size_t k = 0; k < nb; ++k) bid_sum += bids[k].quantity;
+        for (size_t k = 0; k < na; ++k) ask_sum += asks[k].quantity;
+
+        ASSERT_EQ(features_.bid_levels(), nb);
+        ASSERT_EQ(features_.ask_levels(), na);
+        ASSERT_EQ(features_.bid_depth(), bid_sum);
+        ASSERT_EQ(features_.ask_depth(), ask_sum);
+    }
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "common/clock.hpp"
+#include <thread>
+
+using namespace trading;
+
+TEST(ThreadClockTest, SystemModeTracksMonotonicClock) {
+    ASSERT_EQ(ThreadClock::mode(), ThreadClock::Mode::System);
+    Timestamp a = ThreadClock::now();
+    Timestamp b = now_ns();
+    Timestamp c = ThreadClock::now();
+    EXPECT_LE(a, b);
+    EXPECT_LE(b, c);
+}
+
+TEST(ThreadClockTest, CachedModeOnlyMovesOnRefresh) {
+    ThreadClock::use_cached();
+    Timestamp first = ThreadClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(ThreadClock::now(), first);
+
+    Timestamp refreshed = ThreadClock::refresh();
+    EXPECT_GT(refreshed, first);
+    EXPECT_EQ(ThreadClock::now(), refreshed);
+    ThreadClock::use_system();
+}
+
+TEST(ThreadClockTest, SimulatedScopeRestoresMode) {
+    {
+        SimulatedClockScope scope(1000);
+        EXPECT_EQ(ThreadClock::mode(), ThreadClock::Mode::Simulated);
+        EXPECT_EQ(ThreadClock::now(), 1000u);
+        ThreadClock::advance(500);
+        EXPECT_EQ(ThreadClock::refresh(), 1500u); // refresh() does not leave simulated time
+        ThreadClock::set(42);
+        EXPECT_EQ(ThreadClock::now(), 42u);
+    }
+    EXPECT_EQ(ThreadClock::mode(), ThreadClock::Mode::System);
+}
+
+TEST(ThreadClockTest, ModeIsPerThread) {
+    SimulatedClockScope scope(7);
+    ThreadClock::Mode other_mode = ThreadClock::Mode::Simulated;
+    std::thread t([&] { other_mode = ThreadClock::mode(); });
+    t.join();
+    EXPECT_EQ(other_mode, ThreadClock::Mode::System);
+    EXPECT_EQ(ThreadClock::now(), 7u);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "common/config_watcher.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace trading;
+
+class ConfigWatcherTest : public ::testing::Test {
+protected:
+    std::filesystem::path path_;
+
+    void SetUp() override {
+        path_ = std::filesystem::temp_directory_path() /
+                ("config_watcher_test_" + std::to_string(::getpid()) + ".json");
+        write(R"({"max_order_size": 100})");
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    // Write via a temp file and rename, as an operator should; bump the
+    // mtime so back-to-back writes are always distinguishable
+    void write(const std::string& content) {
+        std::filesystem::path tmp = path_;
+        tmp += ".tmp";
+        {
+            std::ofstream out(tmp);
+            out << content;
+        }
+        std::filesystem::rename(tmp, path_);
+        std::filesystem::last_write_time(path_, std::filesystem::file_time_type::clock::now() +
+                                                    std::chrono::seconds(++bumps_));
+    }
+
+    int bumps_ = 0;
+};
+
+TEST_F(ConfigWatcherTest, NoCallbackUntilFileChanges) {
+    int calls = 0;
+    ConfigWatcher watcher(path_.string(), [&](const SystemConfig&) { ++calls; return true; });
+    EXPECT_FALSE(watcher.poll());
+    EXPECT_EQ(calls, 0);
+}
+
+TEST_F(ConfigWatcherTest, DeliversNewConfig) {
+    Quantity seen = 0;
+    ConfigWatcher watcher(path_.string(), [&](const SystemConfig& config) {
+        seen = config.risk_limits.max_order_size;
+        return true;
+    });
+
+    write(R"({"max_order_size": 250})");
+    EXPECT_TRUE(watcher.poll());
+    EXPECT_EQ(seen, 250u);
+    EXPECT_EQ(watcher.reloads(), 1u);
+    EXPECT_FALSE(watcher.poll());   // Same version is not delivered twice
+}
+
+TEST_F(ConfigWatcherTest, RejectedChangeIsOfferedAgain) {
+    int calls = 0;
+    ConfigWatcher watcher(path_.string(), [&](const SystemConfig&) { return ++calls >= 2; });
+
+    write(R"({"max_order_size": 250})");
+    EXPECT_FALSE(watcher.poll());
+    EXPECT_TRUE(watcher.poll());
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(ConfigWatcherTest, MalformedFileIsSkipped) {
+    int calls = 0;
+    ConfigWatcher watcher(path_.string(), [&](const SystemConfig&) { ++calls; return true; });
+
+    write(R"({"max_order_size": "abc"})");
+    EXPECT_FALSE(watcher.poll());
+    EXPECT_EQ(watcher.parse_failures(), 1u);
+    EXPECT_FALSE(watcher.poll());
+
+    write(R"({"max_order_size": 300})");
+    EXPECT_TRUE(watcher.poll());
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(ConfigWatcherTest, BackgroundThreadPicksUpChange) {
+    std::atomic<Quantity> seen{0};
+    ConfigWatcher watcher(path_.string(), [&](const SystemConfig& config) {
+        seen.store(config.risk_limits.max_order_size);
+        return true;
+    });
+    watcher.start(std::chrono::milliseconds(5));
+
+    write(R"({"max_order_size": 400})");
+    for (int i = 0; i < 500 && seen.load() != 400; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    watcher.stop();
+    EXPECT_EQ(seen.load(), 400u);
+    EXPECT_FALSE(watcher.running());
+}
+
+TEST(ValidateRiskLimits, RejectsNonsense) {
+    RiskLimits limits;
+    EXPECT_TRUE(validate_risk_limits(limits));
+
+    RiskLimits bad = limits;
+    bad.max_total_position = 0;
+    EXPECT_FALSE(validate_risk_limits(bad));
+    bad = limits;
+    bad.max_capital = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_FALSE(validate_risk_limits(bad));
+    bad = limits;
+    bad.max_drawdown_pct = 150.0;
+    EXPECT_FALSE(validate_risk_limits(bad));
+
+    RiskLimits no_rate_limit = limits;
+    no_rate_limit.max_orders_per_second = 0;
+    EXPECT_TRUE(validate_risk_limits(no_rate_limit));
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "containers/delay_queue.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace trading;
+
+TEST(DelayQueueTest, StartsEmpty) {
+    DelayQueue<int, 8> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.peek_due(UINT64_MAX), nullptr);
+    EXPECT_EQ(queue.next_due(), UINT64_MAX);
+}
+
+TEST(DelayQueueTest, NothingVisibleBeforeDue) {
+    DelayQueue<int, 8> queue;
+    ASSERT_TRUE(queue.push(100, 1));
+    EXPECT_EQ(queue.peek_due(99), nullptr);
+    ASSERT_NE(queue.peek_due(100), nullptr);
+    EXPECT_EQ(*queue.peek_due(100), 1);
+    EXPECT_EQ(queue.next_due(), 100u);
+}
+
+TEST(DelayQueueTest, PopsInDueOrder) {
+    DelayQueue<int, 8> queue;
+    queue.push(300, 3);
+    queue.push(100, 1);
+    queue.push(200, 2);
+
+    std::vector<int> out;
+    while (const int* v = queue.peek_due(1000)) {
+        out.push_back(*v);
+        queue.pop();
+    }
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(DelayQueueTest, SameDueTimeIsFifo) {
+    DelayQueue<int, 8> queue;
+    for (int i = 0; i < 5; ++i) queue.push(50, i);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_NE(queue.peek_due(50), nullptr);
+        EXPECT_EQ(*queue.peek_due(50), i);
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(DelayQueueTest, PushFailsWhenFull) {
+    DelayQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.push(i, i));
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.push(0, 99));
+    queue.pop();
+    EXPECT_TRUE(queue.push(0, 99));
+}
+
+TEST(DelayQueueTest, RandomisedMatchesSortedOrder) {
+    DelayQueue<uint64_t, 1024> queue;
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> dues;
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t due = rng() % 500;
+        dues.push_back(due);
+        ASSERT_TRUE(queue.push(due, due));
+    }
+    std::sort(dues.begin(), dues.end());
+    for (uint64_t due : dues) {
+        const uint64_t* v = queue.peek_due(UINT64_MAX);
+        ASSERT_NE(v, nullptr);
+        EXPECT_EQ(*v, due);
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "execution/exchange_gateway.hpp"
+#include "execution/execution_engine.hpp"
+#include <thread>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+
+OrderRequest limit_order(OrderId id, Side side, Price price, Quantity quantity) {
+    OrderRequest req{};
+    req.id = id;
+    req.instrument = 3;
+    req.side = side;
+    req.type = OrderType::Limit;
+    req.price = price;
+    req.quantity = quantity;
+    req.timestamp = now_ns();
+    return req;
+}
+
+struct WireReport {
+    ExecutionReport report;
+    OrderId cl_ord_id;
+};
+
+/// Poll until `count` reports have arrived (or give up)
+std::vector<WireReport> wait_reports(GatewayTransport& transport, size_t count) {
+    std::vector<WireReport> reports;
+    for (int i = 0; i < 200000 && reports.size() < count; ++i) {
+        transport.poll_reports([&](const ExecutionReport& report, OrderId cl_ord_id) {
+            reports.push_back({report, cl_ord_id});
+        });
+        std::this_thread::yield();
+    }
+    return reports;
+}
+
+struct GatewayFixture : ::testing::Test {
+    ExchangeGateway gateway{ExchangeConfig{2, "GW", 100, 1.0, true}};
+    GatewayTransport transport{2};
+
+    void SetUp() override {
+        ASSERT_TRUE(gateway.listen());
+        gateway.exchange().seed_book(15000, 5, 100);
+        gateway.start(0);
+        ASSERT_TRUE(transport.connect(gateway.port()));
+    }
+
+    void TearDown() override {
+        transport.disconnect();
+        gateway.stop();
+    }
+};
+
+} // namespace
+
+TEST_F(GatewayFixture, LogsOn) {
+    EXPECT_TRUE(transport.connected());
+    EXPECT_NE(gateway.port(), 0u);
+    EXPECT_EQ(gateway.sessions_accepted(), 1u);
+}
+
+TEST_F(GatewayFixture, NewOrderRestsAndCancels) {
+    ASSERT_TRUE(transport.send_order(limit_order(10, Side::Buy, 14000, 25)));
+    ASSERT_TRUE(transport.flush());
+
+    auto reports = wait_reports(transport, 1);
+    ASSERT_EQ(reports.size(), 1u);
+    ExecutionReport report = reports[0].report;
+    EXPECT_EQ(reports[0].cl_ord_id, 10u);
+    EXPECT_EQ(report.order_id, 10u);
+    EXPECT_EQ(report.status, OrderStatus::New);
+    EXPECT_EQ(report.instrument, 3u);
+    EXPECT_EQ(report.side, Side::Buy);
+    EXPECT_EQ(report.price, 14000);
+    EXPECT_EQ(report.leaves_quantity, 25u);
+    EXPECT_EQ(report.exchange, 2u);
+
+    OrderRequest cancel = limit_order(11, Side::Buy, 0, 0);
+    cancel.action = OrderAction::Cancel;
+    cancel.orig_id = 10;
+    ASSERT_TRUE(transport.send_order(cancel));
+    ASSERT_TRUE(transport.flush());
+    reports = wait_reports(transport, 1);
+    ASSERT_EQ(reports.size(), 1u);
+    report = reports[0].report;
+    EXPECT_EQ(reports[0].cl_ord_id, 11u);
+    EXPECT_EQ(report.order_id, 10u);    // The order the cancel was about
+    EXPECT_EQ(report.status, OrderStatus::Cancelled);
+}
+
+TEST_F(GatewayFixture, CrossingOrderFills) {
+    // Seeded asks at 150.01 .. 150.05, 100 each
+    ASSERT_TRUE(transport.send_order(limit_order(1, Side::Buy, 15002, 150)));
+    ASSERT_TRUE(transport.flush());
+
+    auto reports = wait_reports(transport, 1);
+    ASSERT_EQ(reports.size(), 1u);
+    const ExecutionReport& report = reports[0].report;
+    EXPECT_EQ(report.status, OrderStatus::Filled);
+    EXPECT_EQ(report.filled_quantity, 150u);
+    EXPECT_EQ(report.leaves_quantity, 0u);
+    EXPECT_EQ(report.price, 15002);
+}
+
+TEST_F(GatewayFixture, ReplaceMovesOrder) {
+    ASSERT_TRUE(transport.send_order(limit_order(1, Side::Sell, 16000, 10)));
+    OrderRequest replace = limit_order(2, Side::Sell, 16100, 20);
+    replace.action = OrderAction::Replace;
+    replace.orig_id = 1;
+    ASSERT_TRUE(transport.send_order(replace));
+    ASSERT_TRUE(transport.flush());
+
+    auto reports = wait_reports(transport, 2);
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[0].cl_ord_id, 1u);
+    EXPECT_EQ(reports[1].cl_ord_id, 2u);
+    const ExecutionReport& report = reports[1].report;
+    EXPECT_EQ(report.status, OrderStatus::New);
+    EXPECT_EQ(report.price, 16100);
+    EXPECT_EQ(report.leaves_quantity, 20u);
+}
+
+TEST_F(GatewayFixture, EngineSendsOverTheWire) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.set_transport(&transport);
+    engine.start(0);
+
+    for (OrderId id = 1; id <= 20; ++id) input.try_push(limit_order(id, Side::Buy, 14000, 5));
+
+    int delivered = 0;
+    ExecutionReport report;
+    for (int i = 0; i < 200000 && delivered < 20; ++i) {
+        if (output.try_pop(report)) {
+            EXPECT_EQ(report.status, OrderStatus::New);
+            EXPECT_EQ(report.exchange, 2u);
+            ++delivered;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    engine.stop();
+    EXPECT_EQ(delivered, 20);
+    EXPECT_EQ(gateway.orders_received(), 20u);
+    EXPECT_EQ(engine.in_flight(), 0u);
+    EXPECT_EQ(engine.round_trip_count(), 20u);
+}
+
+TEST(ExchangeGatewayTest, ConnectFailsWithoutGateway) {
+    ExchangeGateway gateway{ExchangeConfig{0, "GW", 100, 1.0, true}};
+    ASSERT_TRUE(gateway.listen());
+    uint16_t port = gateway.port();
+    // Listening but not serving: the Logon is never answered
+    GatewayTransport transport(0);
+    EXPECT_FALSE(transport.connect(port, std::chrono::milliseconds(20)));
+    EXPECT_FALSE(transport.connected());
+}
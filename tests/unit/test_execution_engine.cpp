@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "execution/execution_engine.hpp"
+#include <memory>
+#include <thread>
 
 using namespace trading;
 
@@ -83,3 +85,401 @@ TEST(ExecutionEngineTest, SeedBooks) {
     engine.seed_books(15000, 5, 100);
     // Should not crash
 }
+
+namespace {
+
+OrderRequest resting_order(OrderId id, InstrumentId instrument, StrategyId strategy) {
+    OrderRequest req{};
+    req.id = id;
+    req.instrument = instrument;
+    req.strategy = strategy;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 14000;
+    req.quantity = 10;
+    req.timestamp = now_ns();
+    return req;
+}
+
+} // namespace
+
+TEST(ExecutionEngineTest, HaltedOrdersAreRejected) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 100, 1.0, true});
+    KillSwitch halts;
+    engine.set_kill_switch(&halts);
+
+    halts.halt(HaltScope::Strategy, 2);
+    EXPECT_EQ(engine.process_order(resting_order(1, 0, 2)).status, OrderStatus::Rejected);
+    EXPECT_EQ(engine.process_order(resting_order(2, 0, 1)).status, OrderStatus::New);
+    EXPECT_EQ(engine.orders_halted(), 1u);
+}
+
+TEST(ExecutionEngineTest, CancelOnHaltCancelsOnlyHaltedScope) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 100, 1.0, true});
+    KillSwitch halts;
+    engine.set_kill_switch(&halts);
+
+    engine.process_order(resting_order(1, 0, 0));
+    engine.process_order(resting_order(2, 1, 0));
+    engine.process_order(resting_order(3, 1, 1));
+    EXPECT_EQ(engine.working_order_count(), 3u);
+
+    halts.halt(HaltScope::Instrument, 1);
+    EXPECT_EQ(engine.cancel_halted_orders(), 2u);
+    EXPECT_EQ(engine.working_order_count(), 1u);
+    EXPECT_EQ(engine.halt_cancels(), 2u);
+    engine.deliver_reports(UINT64_MAX);
+
+    ExecutionReport report;
+    int cancels = 0;
+    while (output.try_pop(report)) {
+        EXPECT_EQ(report.status, OrderStatus::Cancelled);
+        EXPECT_EQ(report.instrument, 1u);
+        ++cancels;
+    }
+    EXPECT_EQ(cancels, 2);
+}
+
+TEST(ExecutionEngineTest, CancelOnHaltIsChunkedToReportQueueRoom) {
+    ExecutionEngine::InputQueue input;
+    auto output = std::make_unique<ExecutionEngine::OutputQueue>();
+    ExecutionEngine engine(input, *output);
+    engine.add_exchange({0, "TEST", 100, 1.0, true});
+    engine.set_rate_limit(0);
+    KillSwitch halts;
+    engine.set_kill_switch(&halts);
+
+    // More resting orders than the report queue holds
+    constexpr size_t RESTING = 30000;
+    for (OrderId id = 1; id <= RESTING; ++id) engine.process_order(resting_order(id, 0, 0));
+    ASSERT_EQ(engine.working_order_count(), RESTING);
+
+    halts.halt(HaltScope::Global);
+    size_t first = engine.cancel_halted_orders();
+    EXPECT_GT(first, 0u);
+    EXPECT_LT(first, RESTING);
+    EXPECT_TRUE(engine.halt_cancels_pending());
+    EXPECT_EQ(engine.working_order_count(), RESTING - first);
+
+    EXPECT_EQ(engine.deliver_reports(UINT64_MAX), first);
+    EXPECT_EQ(engine.cancel_halted_orders(), RESTING - first);
+    EXPECT_FALSE(engine.halt_cancels_pending());
+    EXPECT_EQ(engine.deliver_reports(UINT64_MAX), RESTING - first);
+    EXPECT_EQ(engine.halt_cancels(), RESTING);
+    EXPECT_EQ(engine.reports_overflowed(), 0u);
+}
+
+TEST(ExecutionEngineTest, FullWorkingTableRefusesNewOrders) {
+    ExecutionEngine::InputQueue input;
+    auto output = std::make_unique<ExecutionEngine::OutputQueue>();
+    ExecutionEngine engine(input, *output);
+    engine.add_exchange({0, "TEST", 100, 1.0, true});
+    engine.set_rate_limit(0);
+    KillSwitch halts;
+    engine.set_kill_switch(&halts);
+
+    constexpr OrderId RESTING = ExecutionEngine::MAX_WORKING_ORDERS;
+    for (OrderId id = 1; id <= RESTING; ++id) {
+        ASSERT_EQ(engine.process_order(resting_order(id, 0, 0)).status, OrderStatus::New);
+    }
+    EXPECT_EQ(engine.process_order(resting_order(RESTING + 1, 0, 0)).status, OrderStatus::Rejected);
+    EXPECT_EQ(engine.working_overflows(), 1u);
+    EXPECT_EQ(engine.working_order_count(), RESTING);
+
+    // Cancels still go through and make room
+    OrderRequest cancel = resting_order(RESTING + 2, 0, 0);
+    cancel.action = OrderAction::Cancel;
+    cancel.orig_id = 1;
+    EXPECT_EQ(engine.process_order(cancel).status, OrderStatus::Cancelled);
+    EXPECT_EQ(engine.process_order(resting_order(RESTING + 3, 0, 0)).status, OrderStatus::New);
+    EXPECT_EQ(engine.working_overflows(), 1u);
+}
+
+TEST(ExecutionEngineTest, EngineThreadCancelsOnHalt) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 100, 1.0, true});
+    KillSwitch halts;
+    engine.set_kill_switch(&halts);
+    engine.start(0);
+
+    input.try_push(resting_order(1, 0, 3));
+    ExecutionReport report;
+    auto pop = [&] {
+        for (int i = 0; i < 100000; ++i) {
+            if (output.try_pop(report)) return true;
+            std::this_thread::yield();
+        }
+        return false;
+    };
+    ASSERT_TRUE(pop());
+    EXPECT_EQ(report.status, OrderStatus::New);
+
+    halts.halt(HaltScope::Strategy, 3);
+    ASSERT_TRUE(pop());
+    EXPECT_EQ(report.order_id, 1u);
+    EXPECT_EQ(report.status, OrderStatus::Cancelled);
+    engine.stop();
+}
+
+TEST(ExecutionEngineTest, ReportWaitsOutVenueLatency) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 500, 1.0, true});
+    SimulatedClockScope clock(1000);
+
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 0)));
+    EXPECT_EQ(engine.in_flight(), 1u);
+    EXPECT_TRUE(engine.is_in_flight(1));
+    EXPECT_EQ(engine.next_report_due(), 1500u);
+
+    ExecutionReport report;
+    EXPECT_EQ(engine.deliver_reports(1499), 0u);
+    EXPECT_FALSE(output.try_pop(report));
+
+    EXPECT_EQ(engine.deliver_reports(1500), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.order_id, 1u);
+    EXPECT_EQ(report.status, OrderStatus::New);
+    EXPECT_EQ(engine.in_flight(), 0u);
+    EXPECT_EQ(engine.round_trip_count(), 1u);
+    EXPECT_DOUBLE_EQ(engine.mean_round_trip_ns(), 500.0);
+}
+
+TEST(ExecutionEngineTest, ReportsArriveInDueOrderAcrossVenues) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "SLOW", 800, 1.0, true});
+    engine.add_exchange({1, "FAST", 100, 1.0, true});
+    engine.set_routing_strategy(OrderRouter::RoutingStrategy::RoundRobin);
+    SimulatedClockScope clock(0);
+
+    // Round robin: 1 -> SLOW (due 800), 2 -> FAST (due 150)
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 0)));
+    ThreadClock::advance(50);
+    ASSERT_TRUE(engine.send_order(resting_order(2, 0, 0)));
+    EXPECT_EQ(engine.in_flight(), 2u);
+
+    ExecutionReport report;
+    EXPECT_EQ(engine.deliver_reports(200), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.order_id, 2u);
+    EXPECT_TRUE(engine.is_in_flight(1));
+
+    EXPECT_EQ(engine.deliver_reports(800), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.order_id, 1u);
+    EXPECT_EQ(engine.in_flight(), 0u);
+}
+
+TEST(ExecutionEngineTest, EngineRejectsAreDueImmediately) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 500, 1.0, true});
+    KillSwitch halts;
+    engine.set_kill_switch(&halts);
+    halts.halt(HaltScope::Strategy, 1);
+    SimulatedClockScope clock(1000);
+
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 1)));
+    EXPECT_EQ(engine.deliver_reports(1000), 1u);
+    ExecutionReport report;
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.status, OrderStatus::Rejected);
+}
+
+TEST(ExecutionEngineTest, SendFailsWhenInFlightTableIsFull) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 1000, 1.0, true});
+    engine.set_rate_limit(0);
+    SimulatedClockScope clock(0);
+
+    OrderId id = 1;
+    for (size_t i = 0; i < ExecutionEngine::MAX_IN_FLIGHT; ++i) {
+        ASSERT_TRUE(engine.send_order(resting_order(id++, 0, 0)));
+    }
+    EXPECT_FALSE(engine.send_order(resting_order(id, 0, 0)));
+    EXPECT_EQ(engine.peak_in_flight(), ExecutionEngine::MAX_IN_FLIGHT);
+
+    EXPECT_EQ(engine.deliver_reports(1000), ExecutionEngine::MAX_IN_FLIGHT);
+    EXPECT_TRUE(engine.send_order(resting_order(id, 0, 0)));
+}
+
+TEST(ExecutionEngineTest, StopFlushesOutstandingReports) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    // One second: nothing would be delivered before stop() without the flush
+    engine.add_exchange({0, "TEST", 1'000'000'000, 1.0, true});
+    for (OrderId id = 1; id <= 10; ++id) input.try_push(resting_order(id, 0, 0));
+
+    engine.start(0);
+    engine.stop();
+
+    ExecutionReport report;
+    int delivered = 0;
+    while (output.try_pop(report)) ++delivered;
+    EXPECT_EQ(delivered, 10);
+    EXPECT_EQ(engine.in_flight(), 0u);
+}
+
+TEST(ExecutionEngineTest, StopCountsReportsTheConsumerHasNoRoomFor) {
+    ExecutionEngine::InputQueue input;
+    auto output = std::make_unique<ExecutionEngine::OutputQueue>();
+    ExecutionEngine engine(input, *output);
+    engine.add_exchange({0, "TEST", 1'000'000'000, 1.0, true});
+    while (output->try_push(ExecutionReport{})) {}     // Consumer never reads
+    for (OrderId id = 1; id <= 10; ++id) input.try_push(resting_order(id, 0, 0));
+
+    engine.start(0);
+    engine.stop();
+
+    EXPECT_EQ(engine.reports_dropped(), 10u);
+    EXPECT_EQ(engine.in_flight(), 0u);
+}
+
+TEST(ExecutionEngineTest, DeliveredReportsFeedRouterEstimates) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "SLOW", 800, 1.0, true});
+    engine.add_exchange({1, "FAST", 100, 1.0, true});
+    engine.set_routing_strategy(OrderRouter::RoutingStrategy::RoundRobin);
+    KillSwitch halts;
+    engine.set_kill_switch(&halts);
+    halts.halt(HaltScope::Strategy, 9);
+    SimulatedClockScope clock(0);
+
+    ThreadClock::set(1000);
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 9)));   // Engine reject: not a venue sample
+    engine.deliver_reports(1000);
+    EXPECT_EQ(engine.round_trip_count(), 1u);
+    EXPECT_EQ(engine.router().latency_estimator(0)->count(), 0u);
+
+    ThreadClock::set(5000);
+    ASSERT_TRUE(engine.send_order(resting_order(2, 0, 0)));
+    ASSERT_TRUE(engine.send_order(resting_order(3, 0, 0)));
+    engine.deliver_reports(6000);
+    EXPECT_EQ(engine.round_trip_count(), 3u);
+    EXPECT_EQ(engine.router().latency_estimator(0)->count(), 1u);
+    EXPECT_EQ(engine.router().latency_estimator(1)->count(), 1u);
+    EXPECT_DOUBLE_EQ(engine.router().predicted_latency_ns(0), 800.0);
+    EXPECT_DOUBLE_EQ(engine.router().predicted_latency_ns(1), 100.0);
+    EXPECT_DOUBLE_EQ(engine.router().fill_rate(0), 1.0);
+    EXPECT_DOUBLE_EQ(engine.router().fill_rate(1), 1.0);
+}
+
+TEST(ExecutionEngineTest, OrdersTrackedUntilTerminal) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 500, 1.0, true});
+    SimulatedClockScope clock(1000);
+
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 0)));
+    ASSERT_NE(engine.orders().find(1), nullptr);
+    EXPECT_EQ(engine.orders().find(1)->state, OrderState::PendingNew);
+
+    // Same id while the first is live: refused before any venue sees it
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 0)));
+    ExecutionReport report;
+    EXPECT_EQ(engine.deliver_reports(1000), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.status, OrderStatus::Rejected);
+
+    EXPECT_EQ(engine.deliver_reports(1500), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.status, OrderStatus::New);
+    EXPECT_EQ(engine.orders().find(1)->state, OrderState::New);
+
+    OrderRequest cancel{};
+    cancel.id = 2;
+    cancel.action = OrderAction::Cancel;
+    cancel.orig_id = 1;
+    ThreadClock::set(2000);
+    ASSERT_TRUE(engine.send_order(cancel));
+    EXPECT_EQ(engine.deliver_reports(2500), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.status, OrderStatus::Cancelled);
+    EXPECT_EQ(engine.orders().find(1), nullptr);
+    EXPECT_EQ(engine.orders().live_count(), 0u);
+}
+
+TEST(ExecutionEngineTest, DuplicateIdLeavesInFlightEntryAlone) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "TEST", 500, 1.0, true});
+    SimulatedClockScope clock(1000);
+
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 0)));
+    ThreadClock::set(1200);
+    ASSERT_TRUE(engine.send_order(resting_order(1, 0, 0)));    // Rejected at once
+
+    ExecutionReport report;
+    EXPECT_EQ(engine.deliver_reports(1200), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.status, OrderStatus::Rejected);
+    EXPECT_TRUE(engine.is_in_flight(1));
+    EXPECT_EQ(engine.round_trip_count(), 0u);
+
+    // The original's report still measures from its own send
+    EXPECT_EQ(engine.deliver_reports(1500), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.status, OrderStatus::New);
+    EXPECT_EQ(engine.in_flight(), 0u);
+    EXPECT_EQ(engine.round_trip_count(), 1u);
+    EXPECT_DOUBLE_EQ(engine.mean_round_trip_ns(), 500.0);
+    EXPECT_DOUBLE_EQ(engine.router().predicted_latency_ns(0), 500.0);
+}
+
+TEST(ExecutionEngineTest, SplitOrderChildrenReportOnTheirOwnLatency) {
+    ExecutionEngine::InputQueue input;
+    ExecutionEngine::OutputQueue output;
+    ExecutionEngine engine(input, output);
+    engine.add_exchange({0, "SLOW", 800, 1.0, true});
+    engine.add_exchange({1, "FAST", 100, 1.0, true});
+    engine.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+    engine.seed_books(15000, 5, 30);
+    SimulatedClockScope clock(0);
+
+    // 15001 on both, then 15002: SLOW takes 60, FAST 40
+    OrderRequest req = resting_order(1, 0, 0);
+    req.price = 15003;
+    req.quantity = 100;
+    ASSERT_TRUE(engine.send_order(req));
+    EXPECT_EQ(engine.orders().find(1)->children, 2u);
+    EXPECT_EQ(engine.in_flight(), 1u);
+
+    ExecutionReport report;
+    EXPECT_EQ(engine.deliver_reports(100), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.order_id, 1u);
+    EXPECT_EQ(report.status, OrderStatus::PartiallyFilled);
+    EXPECT_EQ(report.filled_quantity, 40u);
+    EXPECT_EQ(report.leaves_quantity, 60u);
+    EXPECT_TRUE(engine.is_in_flight(1));
+
+    EXPECT_EQ(engine.deliver_reports(800), 1u);
+    ASSERT_TRUE(output.try_pop(report));
+    EXPECT_EQ(report.order_id, 1u);
+    EXPECT_EQ(report.status, OrderStatus::Filled);
+    EXPECT_EQ(report.filled_quantity, 60u);
+    EXPECT_EQ(report.leaves_quantity, 0u);
+    EXPECT_EQ(engine.in_flight(), 0u);
+    EXPECT_EQ(engine.round_trip_count(), 2u);
+    EXPECT_EQ(engine.orders().live_count(), 0u);
+    EXPECT_EQ(engine.router().latency_estimator(1)->count(), 1u);
+}
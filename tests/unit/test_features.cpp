@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "strategy/features.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace trading;
+
+TEST(FeaturesTest, EmaSeedsAndDecays) {
+    Ema<3> ema; // alpha = 0.5
+    ema.update(10.0);
+    EXPECT_DOUBLE_EQ(ema.value(), 10.0);
+    ema.update(20.0);
+    EXPECT_DOUBLE_EQ(ema.value(), 15.0);
+
+    Ema<> runtime(ema_alpha(3));
+    runtime.update(10.0);
+    runtime.update(20.0);
+    EXPECT_DOUBLE_EQ(runtime.value(), ema.value());
+}
+
+TEST(FeaturesTest, EwmaVarianceOfConstantIsZero) {
+    EwmaVariance<20> ev;
+    for (int i = 0; i < 100; ++i) ev.update(5.0);
+    EXPECT_DOUBLE_EQ(ev.mean(), 5.0);
+    EXPECT_DOUBLE_EQ(ev.variance(), 0.0);
+}
+
+TEST(FeaturesTest, RollingMeanMatchesNaive) {
+    RollingMean<8> mean;
+    std::vector<double> xs;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+
+    for (int i = 0; i < 100; ++i) {
+        double x = dist(rng);
+        xs.push_back(x);
+        mean.update(x);
+
+        size_t n = std::min<size_t>(xs.size(), 8);
+        double sum = 0.0;
+        for (size_t k = xs.size() - n; k < xs.size(); ++k) sum += xs[k];
+        ASSERT_NEAR(mean.value(), sum / static_cast<double>(n), 1e-9);
+    }
+}
+
+TEST(FeaturesTest, RollingVolatilityMatchesNaive) {
+    RollingVolatility<16> vol;
+    std::vector<double> prices;
+    std::mt19937 rng(2);
+    std::normal_distribution<double> step(0.0, 1.0);
+    double p = 15000.0;
+
+    for (int i = 0; i < 200; ++i) {
+        p += step(rng);
+        prices.push_back(p);
+        vol.update(p);
+    }
+
+    // Population stddev of the last 16 returns
+    double sum = 0.0, sum_sq = 0.0;
+    for (size_t k = prices.size() - 16; k < prices.size(); ++k) {
+        double r = (prices[k] - prices[k - 1]) / prices[k - 1];
+        sum += r;
+        sum_sq += r * r;
+    }
+    double m = sum / 16.0;
+    EXPECT_EQ(vol.size(), 16u);
+    EXPECT_NEAR(vol.value(), std::sqrt(sum_sq / 16.0 - m * m), 1e-12);
+}
+
+TEST(FeaturesTest, RollingVwapEvictsOldTrades) {
+    RollingVwap<2> vwap;
+    vwap.update(100.0, 10.0);
+    vwap.update(110.0, 30.0);
+    EXPECT_DOUBLE_EQ(vwap.value(), (1000.0 + 3300.0) / 40.0);
+    vwap.update(120.0, 10.0); // Evicts the first trade
+    EXPECT_DOUBLE_EQ(vwap.value(), (3300.0 + 1200.0) / 40.0);
+    EXPECT_DOUBLE_EQ(vwap.volume(), 40.0);
+}
+
+TEST(FeaturesTest, RateOfChange) {
+    RateOfChange<2> roc;
+    roc.update(100.0);
+    roc.update(105.0);
+    EXPECT_DOUBLE_EQ(roc.value(), 0.0); // Not enough history
+    roc.update(110.0);
+    EXPECT_DOUBLE_EQ(roc.value(), 0.1);
+}
+
+TEST(FeaturesTest, BatchMatchesScalar) {
+    constexpr size_t N = 37;
+    std::vector<double> ema(N, 100.0), mean(N, 100.0), var(N, 0.0), x(N);
+    std::vector<EwmaVariance<>> scalar(N, EwmaVariance<>(ema_alpha(10)));
+    for (auto& s : scalar) s.update(100.0);
+
+    for (int t = 0; t < 50; ++t) {
+        for (size_t i = 0; i < N; ++i) x[i] = 100.0 + static_cast<double>((t * 7 + i) % 13);
+        ema_update_batch(ema.data(), x.data(), N, ema_alpha(10));
+        ewma_variance_update_batch(mean.data(), var.data(), x.data(), N, ema_alpha(10));
+        for (size_t i = 0; i < N; ++i) scalar[i].update(x[i]);
+    }
+
+    for (size_t i = 0; i < N; ++i) {
+        EXPECT_NEAR(ema[i], scalar[i].mean(), 1e-9);
+        EXPECT_NEAR(mean[i], scalar[i].mean(), 1e-9);
+        EXPECT_NEAR(var[i], scalar[i].variance(), 1e-9);
+    }
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include "execution/fix_order_encoder.hpp"
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace trading;
+
+namespace {
+
+OrderRequest make_request(OrderAction action) {
+    OrderRequest req{};
+    req.id = 123456789;
+    req.instrument = 42;
+    req.side = Side::Sell;
+    req.type = OrderType::Limit;
+    req.price = 15050;
+    req.quantity = 300;
+    req.action = action;
+    req.orig_id = action == OrderAction::New ? 0 : 77;
+    return req;
+}
+
+std::string encode(FixOrderEncoder& encoder, const OrderRequest& request, uint64_t seq) {
+    char out[FixOrderEncoder::MAX_MESSAGE_SIZE];
+    size_t length = encoder.encode(request, seq, out);
+    return std::string(out, length);
+}
+
+/// CheckSum recomputed the slow way
+unsigned full_checksum(const std::string& msg) {
+    unsigned sum = 0;
+    for (size_t i = 0; i + 7 < msg.size(); ++i) sum += static_cast<unsigned char>(msg[i]);
+    return sum & 0xFF;
+}
+
+} // namespace
+
+TEST(FixOrderEncoderTest, NewOrderSingleFields) {
+    FixOrderEncoder encoder("CLIENT", "EXCH");
+    std::string msg = encode(encoder, make_request(OrderAction::New), 5);
+
+    FixParser parser;
+    ASSERT_TRUE(parser.parse(msg));
+    EXPECT_EQ(parser.msg_type(), "D");
+    EXPECT_EQ(parser.get_field(8), "FIX.4.4");
+    EXPECT_EQ(parser.get_field(49), "CLIENT");
+    EXPECT_EQ(parser.get_field(56), "EXCH");
+    EXPECT_EQ(parser.get_uint(34), 5u);
+    EXPECT_EQ(parser.get_order_id(), 123456789u);
+    EXPECT_EQ(parser.get_uint(55), 42u);
+    EXPECT_EQ(parser.get_side(), Side::Sell);
+    EXPECT_EQ(parser.get_price(), 15050);
+    EXPECT_EQ(parser.get_quantity(), 300u);
+    EXPECT_EQ(parser.get_field(40), "2");
+    EXPECT_EQ(parser.get_field(59), "0");
+    EXPECT_EQ(parser.get_field(52).size(), UtcTimestamp::SIZE);
+    EXPECT_EQ(parser.get_field(52), parser.get_field(60));
+    EXPECT_TRUE(parser.get_field(41).empty());
+}
+
+TEST(FixOrderEncoderTest, CancelAndReplaceFields) {
+    FixOrderEncoder encoder("CLIENT", "EXCH");
+    FixParser parser;
+
+    std::string cancel = encode(encoder, make_request(OrderAction::Cancel), 6);
+    ASSERT_TRUE(parser.parse(cancel));
+    EXPECT_EQ(parser.msg_type(), "F");
+    EXPECT_EQ(parser.get_uint(41), 77u);
+    EXPECT_EQ(parser.get_order_id(), 123456789u);
+    EXPECT_TRUE(parser.get_field(38).empty());
+    EXPECT_TRUE(parser.get_field(44).empty());
+
+    std::string replace = encode(encoder, make_request(OrderAction::Replace), 7);
+    ASSERT_TRUE(parser.parse(replace));
+    EXPECT_EQ(parser.msg_type(), "G");
+    EXPECT_EQ(parser.get_uint(41), 77u);
+    EXPECT_EQ(parser.get_price(), 15050);
+    EXPECT_EQ(parser.get_quantity(), 300u);
+}
+
+TEST(FixOrderEncoderTest, OrderTypesMapToOrdTypeAndTimeInForce) {
+    FixOrderEncoder encoder("C", "E");
+    FixParser parser;
+    OrderRequest req = make_request(OrderAction::New);
+
+    req.type = OrderType::Market;
+    ASSERT_TRUE(parser.parse(encode(encoder, req, 1)));
+    EXPECT_EQ(parser.get_field(40), "1");
+    req.type = OrderType::IOC;
+    ASSERT_TRUE(parser.parse(encode(encoder, req, 1)));
+    EXPECT_EQ(parser.get_field(40), "2");
+    EXPECT_EQ(parser.get_field(59), "3");
+    req.type = OrderType::FOK;
+    ASSERT_TRUE(parser.parse(encode(encoder, req, 1)));
+    EXPECT_EQ(parser.get_field(59), "4");
+}
+
+TEST(FixOrderEncoderTest, BodyLengthAndChecksumAreValid) {
+    FixOrderEncoder encoder("CLIENT", "EXCH");
+    for (OrderAction action : {OrderAction::New, OrderAction::Cancel, OrderAction::Replace}) {
+        OrderRequest req = make_request(action);
+        for (uint64_t seq : {1ull, 9ull, 10ull, 999ull, 123456789ull}) {
+            req.id = seq * 7919;
+            req.price = static_cast<Price>(seq % 100000);
+            req.quantity = seq;
+            req.side = (seq & 1) ? Side::Buy : Side::Sell;
+            std::string msg = encode(encoder, req, seq);
+
+            size_t body_start = msg.find('|', msg.find("9=")) + 1;
+            size_t body_len = std::stoul(msg.substr(msg.find("9=") + 2));
+            EXPECT_EQ(msg.compare(body_start + body_len, 3, "10="), 0);
+            EXPECT_EQ(std::stoul(msg.substr(msg.size() - 4, 3)), full_checksum(msg));
+        }
+    }
+}
+
+TEST(FixOrderEncoderTest, LengthIsFixedPerTemplate) {
+    FixOrderEncoder encoder("CLIENT", "EXCH");
+    OrderRequest small = make_request(OrderAction::New);
+    small.id = 1;
+    small.quantity = 1;
+    small.price = 1;
+    OrderRequest large = make_request(OrderAction::New);
+    large.id = UINT64_MAX;
+    large.quantity = 999999999999ull;
+    large.price = 999999999999;
+    EXPECT_EQ(encode(encoder, small, 1).size(), encode(encoder, large, UINT64_MAX).size());
+    EXPECT_EQ(encode(encoder, small, 1).size(), encoder.message_template(OrderAction::New).size());
+
+    FixParser parser;
+    ASSERT_TRUE(parser.parse(encode(encoder, large, 2)));
+    EXPECT_EQ(parser.get_order_id(), UINT64_MAX);
+    EXPECT_EQ(parser.get_price(), 999999999999);
+}
+
+TEST(FixOrderEncoderTest, SequenceNumberDoesNotWrap) {
+    FixOrderEncoder encoder("CLIENT", "EXCH");
+    FixParser parser;
+    ASSERT_TRUE(parser.parse(encode(encoder, make_request(OrderAction::New), 1'000'000'000ull)));
+    EXPECT_EQ(parser.get_uint(34), 1'000'000'000u);
+    ASSERT_TRUE(parser.parse(encode(encoder, make_request(OrderAction::Cancel), UINT64_MAX)));
+    EXPECT_EQ(parser.get_uint(34), UINT64_MAX);
+}
+
+TEST(FixOrderEncoderTest, RefusesOrdersThatDoNotFit) {
+    FixOrderEncoder encoder("CLIENT", "EXCH");
+    for (OrderAction action : {OrderAction::New, OrderAction::Replace}) {
+        OrderRequest negative = make_request(action);
+        negative.price = -15050;
+        EXPECT_TRUE(encode(encoder, negative, 1).empty());
+
+        OrderRequest wide_price = make_request(action);
+        wide_price.price = 1'000'000'000'000;
+        EXPECT_TRUE(encode(encoder, wide_price, 1).empty());
+
+        OrderRequest wide_quantity = make_request(action);
+        wide_quantity.quantity = 1'000'000'000'000ull;
+        EXPECT_TRUE(encode(encoder, wide_quantity, 1).empty());
+    }
+
+    // Cancels carry no price or quantity
+    OrderRequest cancel = make_request(OrderAction::Cancel);
+    cancel.price = -1;
+    EXPECT_FALSE(encode(encoder, cancel, 1).empty());
+}
+
+TEST(FixOrderEncoderTest, LongestCompIdsFitTheMessage) {
+    const std::string comp_id(16, 'X');     // FixSession's longest comp id
+    FixOrderEncoder encoder(comp_id, comp_id);
+    for (OrderAction action : {OrderAction::New, OrderAction::Cancel, OrderAction::Replace}) {
+        EXPECT_LE(encoder.message_template(action).size(), FixOrderEncoder::MAX_MESSAGE_SIZE);
+    }
+}
+
+TEST(FixOrderEncoderTest, SessionAcceptsEncodedMessages) {
+    // The receiving session verifies framing and checksum on every message
+    FixSession sender("CLIENT", "EXCH");
+    FixSession receiver("EXCH", "CLIENT");
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    sender.attach(fds[0]);
+    receiver.attach(fds[1]);
+    ASSERT_TRUE(sender.logon(30));
+    receiver.poll([](const FixParser&) {});
+    sender.poll([](const FixParser&) {});
+    ASSERT_TRUE(sender.active());
+
+    FixOrderEncoder encoder("CLIENT", "EXCH");
+    for (OrderAction action : {OrderAction::New, OrderAction::Cancel, OrderAction::Replace}) {
+        OrderRequest req = make_request(action);
+        ASSERT_TRUE(sender.send_rendered([&](char* out, uint64_t seq) { return encoder.encode(req, seq, out); }));
+    }
+    ASSERT_TRUE(sender.flush());
+
+    std::string types;
+    receiver.poll([&](const FixParser& m) { types += m.msg_type(); });
+    EXPECT_EQ(types, "DFG");
+    EXPECT_EQ(receiver.checksum_errors(), 0u);
+    EXPECT_EQ(receiver.sequence_gaps(), 0u);
+}
@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+#include "execution/fix_session.hpp"
+#include "common/clock.hpp"
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+
+/// Two sessions joined by a socketpair
+struct SessionPair {
+    FixSession client{"CLIENT", "EXCH"};
+    FixSession server{"EXCH", "CLIENT"};
+
+    SessionPair() {
+        int fds[2];
+        EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        client.attach(fds[0]);
+        server.attach(fds[1]);
+    }
+
+    void logon() {
+        ASSERT_TRUE(client.logon(30));
+        server.poll([](const FixParser&) {});
+        client.poll([](const FixParser&) {});
+    }
+};
+
+/// Frame a body ("35=...|...|") the way the session does
+std::string frame(const std::string& body) {
+    std::string msg = "8=FIX.4.4|9=" + std::to_string(body.size()) + "|" + body;
+    unsigned sum = 0;
+    for (char c : msg) sum += static_cast<unsigned char>(c);
+    char trailer[8];
+    snprintf(trailer, sizeof(trailer), "10=%03u|", sum & 0xFF);
+    return msg + trailer;
+}
+
+std::string raw_message(uint64_t seq, const std::string& fields) {
+    return frame("35=D|49=EXCH|56=CLIENT|34=" + std::to_string(seq) + "|" + fields);
+}
+
+std::vector<std::string> collect(FixSession& session) {
+    std::vector<std::string> ids;
+    session.poll([&](const FixParser& m) { ids.emplace_back(m.get_field(11)); });
+    return ids;
+}
+
+} // namespace
+
+TEST(FixSessionTest, LogonHandshake) {
+    SessionPair pair;
+    EXPECT_EQ(pair.client.state(), FixSession::State::Connected);
+    pair.logon();
+    EXPECT_TRUE(pair.client.active());
+    EXPECT_TRUE(pair.server.active());
+    EXPECT_EQ(pair.server.heartbeat_interval_ns(), 30'000'000'000ULL);
+    EXPECT_EQ(pair.client.next_outbound_seq(), 2u);
+    EXPECT_EQ(pair.client.next_inbound_seq(), 2u);
+}
+
+TEST(FixSessionTest, ApplicationMessagesCarryFieldsAndSequence) {
+    SessionPair pair;
+    pair.logon();
+
+    FixSession::Writer writer = pair.client.begin("D");
+    writer.field(11, uint64_t{42}).field(55, "7").field(54, '1').price(44, 15050).field(38, uint64_t{100});
+    ASSERT_TRUE(pair.client.send(writer));
+    ASSERT_TRUE(pair.client.flush());
+
+    int seen = 0;
+    pair.server.poll([&](const FixParser& m) {
+        EXPECT_EQ(m.msg_type(), "D");
+        EXPECT_EQ(m.get_order_id(), 42u);
+        EXPECT_EQ(m.get_symbol(), "7");
+        EXPECT_EQ(m.get_side(), Side::Buy);
+        EXPECT_EQ(m.get_price(), 15050);
+        EXPECT_EQ(m.get_quantity(), 100u);
+        EXPECT_EQ(m.get_uint(34), 2u);
+        EXPECT_EQ(m.get_field(49), "CLIENT");
+        EXPECT_EQ(m.get_field(52).size(), 21u);
+        ++seen;
+    });
+    EXPECT_EQ(seen, 1);
+    EXPECT_EQ(pair.server.checksum_errors(), 0u);
+}
+
+TEST(FixSessionTest, BatchGoesOutInOneWrite) {
+    SessionPair pair;
+    pair.logon();
+    uint64_t writes = pair.client.writev_calls();
+
+    for (uint64_t id = 1; id <= 10; ++id) {
+        FixSession::Writer writer = pair.client.begin("D");
+        writer.field(11, id);
+        ASSERT_TRUE(pair.client.send(writer));
+    }
+    ASSERT_TRUE(pair.client.flush());
+    EXPECT_EQ(pair.client.writev_calls(), writes + 1);
+    EXPECT_EQ(collect(pair.server).size(), 10u);
+}
+
+TEST(FixSessionTest, FullSendBufferDoesNotBlockFlush) {
+    SessionPair pair;
+    pair.logon();
+    int size = 4096;
+    ::setsockopt(pair.client.fd(), SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+
+    // The server does not read: flush() gives up instead of spinning, and
+    // once every slot is unsent new messages are refused
+    const std::string padding(400, 'x');
+    uint64_t sent = 0;
+    while (sent < 100000) {
+        FixSession::Writer writer = pair.client.begin("D");
+        writer.field(11, sent + 1).field(58, padding);
+        if (!pair.client.send(writer)) break;
+        ++sent;
+        pair.client.flush();
+    }
+    ASSERT_LT(sent, 100000u);
+    EXPECT_TRUE(pair.client.write_pending());
+    EXPECT_GT(pair.client.send_stalls(), 0u);
+    EXPECT_EQ(pair.client.state(), FixSession::State::Active);
+
+    // The reader catches up: the queued tail goes out, in sequence
+    std::vector<std::string> ids;
+    for (int i = 0; i < 10000 && ids.size() < sent; ++i) {
+        pair.client.flush();
+        for (auto& id : collect(pair.server)) ids.push_back(id);
+    }
+    ASSERT_EQ(ids.size(), sent);
+    EXPECT_EQ(ids.back(), std::to_string(sent));
+    EXPECT_FALSE(pair.client.write_pending());
+    EXPECT_EQ(pair.server.sequence_gaps(), 0u);
+}
+
+TEST(FixSessionTest, MessageSplitAcrossReads) {
+    FixSession reader("CLIENT", "EXCH");
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    reader.attach(fds[0]);
+
+    std::string logon = frame("35=A|49=EXCH|56=CLIENT|34=1|98=0|108=30|");
+    std::string order = raw_message(2, "11=5|");
+    std::string bytes = logon + order;
+    size_t half = logon.size() + order.size() / 2;
+    ASSERT_EQ(::write(fds[1], bytes.data(), half), static_cast<ssize_t>(half));
+    EXPECT_TRUE(collect(reader).empty());
+    ASSERT_EQ(::write(fds[1], bytes.data() + half, bytes.size() - half), static_cast<ssize_t>(bytes.size() - half));
+    EXPECT_EQ(collect(reader), std::vector<std::string>{"5"});
+    ::close(fds[1]);
+}
+
+TEST(FixSessionTest, DuplicatesDroppedAndGapsCounted) {
+    FixSession session("CLIENT", "EXCH");
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    session.attach(fds[0]);
+
+    std::string bytes = frame("35=A|49=EXCH|56=CLIENT|34=1|98=0|108=30|") +
+                        raw_message(2, "11=1|") +
+                        raw_message(2, "11=1|") +     // Duplicate
+                        raw_message(5, "11=2|") +     // Gap: 3 and 4 missing
+                        raw_message(6, "11=3|");
+    ASSERT_EQ(::write(fds[1], bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+
+    EXPECT_EQ(collect(session), (std::vector<std::string>{"1", "2", "3"}));
+    EXPECT_EQ(session.duplicates(), 1u);
+    EXPECT_EQ(session.sequence_gaps(), 1u);
+    EXPECT_EQ(session.next_inbound_seq(), 7u);
+    ::close(fds[1]);
+}
+
+TEST(FixSessionTest, BadChecksumIsDropped) {
+    FixSession session("CLIENT", "EXCH");
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    session.attach(fds[0]);
+
+    std::string corrupt = raw_message(2, "11=1|");
+    corrupt[corrupt.size() - 2] = corrupt[corrupt.size() - 2] == '9' ? '0' : '9';
+    std::string bytes = frame("35=A|49=EXCH|56=CLIENT|34=1|98=0|108=30|") + corrupt + raw_message(3, "11=2|");
+    ASSERT_EQ(::write(fds[1], bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+
+    EXPECT_EQ(collect(session), std::vector<std::string>{"2"});
+    EXPECT_EQ(session.checksum_errors(), 1u);
+    EXPECT_TRUE(session.active());
+    ::close(fds[1]);
+}
+
+TEST(FixSessionTest, GarbageClosesSession) {
+    FixSession session("CLIENT", "EXCH");
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    session.attach(fds[0]);
+
+    std::string bytes = "GARBAGE-NOT-FIX|";
+    ASSERT_EQ(::write(fds[1], bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+    collect(session);
+    EXPECT_EQ(session.state(), FixSession::State::Closed);
+    ::close(fds[1]);
+}
+
+TEST(FixSessionTest, ApplicationMessagesBeforeLogonAreIgnored) {
+    FixSession session("CLIENT", "EXCH");
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    session.attach(fds[0]);
+
+    std::string bytes = raw_message(1, "11=1|");
+    ASSERT_EQ(::write(fds[1], bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+    EXPECT_TRUE(collect(session).empty());
+    ::close(fds[1]);
+}
+
+TEST(FixSessionTest, HeartbeatAndTestRequestOnSilence) {
+    SimulatedClockScope clock(1);
+    SessionPair pair;
+    pair.logon();
+    const Timestamp interval = pair.client.heartbeat_interval_ns();
+
+    // Nothing sent for one interval: heartbeat
+    uint64_t sent = pair.client.messages_sent();
+    ThreadClock::set(1 + interval);
+    pair.client.service(ThreadClock::now());
+    EXPECT_EQ(pair.client.messages_sent(), sent + 1);
+
+    // Nothing received for 1.5 intervals: TestRequest, which the peer answers
+    ThreadClock::set(1 + interval + interval / 2);
+    pair.client.service(ThreadClock::now());
+    EXPECT_EQ(pair.client.messages_sent(), sent + 2);
+    uint64_t server_sent = pair.server.messages_sent();
+    EXPECT_TRUE(collect(pair.server).empty());
+    EXPECT_EQ(pair.server.messages_sent(), server_sent + 1);
+
+    collect(pair.client);
+    ThreadClock::set(1 + 2 * interval);
+    pair.client.service(ThreadClock::now());
+    EXPECT_TRUE(pair.client.active());
+}
+
+TEST(FixSessionTest, SilentPeerTimesOut) {
+    SessionPair pair;
+    pair.logon();
+    pair.client.service(ThreadClock::now() + 3 * pair.client.heartbeat_interval_ns() + 1);
+    EXPECT_EQ(pair.client.state(), FixSession::State::Closed);
+}
+
+TEST(FixSessionTest, LogoutHandshake) {
+    SessionPair pair;
+    pair.logon();
+    pair.client.logout();
+    collect(pair.server);
+    EXPECT_EQ(pair.server.state(), FixSession::State::Closed);
+    collect(pair.client);
+    EXPECT_EQ(pair.client.state(), FixSession::State::Closed);
+}
+
+TEST(FixSessionTest, OversizedMessageIsNotSent) {
+    SessionPair pair;
+    pair.logon();
+    FixSession::Writer writer = pair.client.begin("D");
+    std::string big(FixSession::MAX_MESSAGE_SIZE, 'x');
+    writer.field(58, big);
+    EXPECT_FALSE(writer.ok());
+    EXPECT_FALSE(pair.client.send(writer));
+    uint64_t seq = pair.client.next_outbound_seq();
+    FixSession::Writer next = pair.client.begin("D");
+    next.field(11, uint64_t{1});
+    EXPECT_TRUE(pair.client.send(next));
+    EXPECT_EQ(pair.client.next_outbound_seq(), seq + 1);
+}
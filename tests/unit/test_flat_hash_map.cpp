@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "containers/flat_hash_map.hpp"
+#include <random>
+#include <unordered_map>
+
+using namespace trading;
+
+TEST(FlatHashMapTest, InsertFindErase) {
+    FlatHashMap<uint64_t, int, 16> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), nullptr);
+
+    EXPECT_TRUE(map.insert(1, 10));
+    EXPECT_TRUE(map.insert(2, 20));
+    ASSERT_NE(map.find(1), nullptr);
+    EXPECT_EQ(*map.find(1), 10);
+    EXPECT_EQ(*map.find(2), 20);
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT_TRUE(map.insert(1, 11));  // Overwrite
+    EXPECT_EQ(*map.find(1), 11);
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(FlatHashMapTest, RefusesInsertBeyondMaxLoad) {
+    FlatHashMap<uint64_t, int, 16> map;
+    for (uint64_t k = 0; k < decltype(map)::MAX_SIZE; ++k) {
+        EXPECT_TRUE(map.insert(k, 0));
+    }
+    EXPECT_FALSE(map.insert(1000, 0));
+    EXPECT_TRUE(map.insert(0, 5));   // Existing keys can still be updated
+    EXPECT_TRUE(map.erase(3));
+    EXPECT_TRUE(map.insert(1000, 0));
+}
+
+TEST(FlatHashMapTest, ChurnMatchesReference) {
+    // Random insert/erase keeps every probe run intact (backward-shift delete)
+    FlatHashMap<uint64_t, uint64_t, 1024> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(42);
+
+    for (int step = 0; step < 200000; ++step) {
+        uint64_t key = rng() % 2000;
+        if (rng() % 2 == 0 && reference.size() < decltype(map)::MAX_SIZE) {
+            ASSERT_TRUE(map.insert(key, step));
+            reference[key] = static_cast<uint64_t>(step);
+        } else {
+            ASSERT_EQ(map.erase(key), reference.erase(key) == 1);
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    for (uint64_t key = 0; key < 2000; ++key) {
+        auto it = reference.find(key);
+        const uint64_t* value = map.find(key);
+        if (it == reference.end()) {
+            EXPECT_EQ(value, nullptr) << key;
+        } else {
+            ASSERT_NE(value, nullptr) << key;
+            EXPECT_EQ(*value, it->second);
+        }
+    }
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(reference.begin()->first));
+}
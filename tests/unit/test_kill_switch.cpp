@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "risk/kill_switch.hpp"
+#include <thread>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+
+OrderRequest make_order(InstrumentId instrument, ExchangeId exchange, StrategyId strategy) {
+    OrderRequest req{};
+    req.id = 1;
+    req.instrument = instrument;
+    req.exchange = exchange;
+    req.strategy = strategy;
+    req.quantity = 10;
+    req.price = 15000;
+    return req;
+}
+
+} // namespace
+
+TEST(KillSwitchTest, NothingHaltedByDefault) {
+    KillSwitch halts;
+    EXPECT_FALSE(halts.any());
+    EXPECT_FALSE(halts.blocks(make_order(0, 0, 0)));
+}
+
+TEST(KillSwitchTest, GlobalBlocksEverything) {
+    KillSwitch halts;
+    halts.halt(HaltScope::Global);
+    EXPECT_TRUE(halts.global());
+    EXPECT_TRUE(halts.blocks(make_order(5, 3, 7)));
+    halts.resume(HaltScope::Global);
+    EXPECT_FALSE(halts.blocks(make_order(5, 3, 7)));
+}
+
+TEST(KillSwitchTest, ScopedHaltsOnlyBlockTheirScope) {
+    KillSwitch halts;
+    halts.halt(HaltScope::Instrument, 200);
+    halts.halt(HaltScope::Strategy, 4);
+    halts.halt(HaltScope::Exchange, 2);
+
+    EXPECT_TRUE(halts.blocks(make_order(200, 0, 0)));
+    EXPECT_TRUE(halts.blocks(make_order(0, 0, 4)));
+    EXPECT_TRUE(halts.blocks(make_order(0, 2, 0)));
+    EXPECT_FALSE(halts.blocks(make_order(199, 1, 3)));
+    EXPECT_FALSE(halts.global());
+
+    // Same bit position in another word / field must not alias
+    EXPECT_FALSE(halts.blocks(make_order(8, 0, 0)));        // 200 & 63 == 8
+    EXPECT_FALSE(halts.halted(HaltScope::Exchange, 4));
+    EXPECT_TRUE(halts.halted(HaltScope::Strategy, 4));
+}
+
+TEST(KillSwitchTest, OutOfRangeIdsAreRejected) {
+    KillSwitch halts;
+    EXPECT_FALSE(halts.halt(HaltScope::Instrument, MAX_INSTRUMENTS));
+    EXPECT_FALSE(halts.halt(HaltScope::Strategy, MAX_STRATEGIES));
+    EXPECT_FALSE(halts.halt(HaltScope::Exchange, MAX_EXCHANGES));
+    EXPECT_FALSE(halts.any());
+    EXPECT_EQ(halts.generation(), 0u);
+}
+
+TEST(KillSwitchTest, GenerationMovesOnHaltOnly) {
+    KillSwitch halts;
+    halts.halt(HaltScope::Instrument, 1);
+    EXPECT_EQ(halts.generation(), 1u);
+    halts.resume(HaltScope::Instrument, 1);
+    EXPECT_EQ(halts.generation(), 1u);
+    halts.halt(HaltScope::Exchange, 1);
+    EXPECT_EQ(halts.generation(), 2u);
+    halts.clear();
+    EXPECT_FALSE(halts.any());
+}
+
+TEST(KillSwitchTest, SnapshotMatchesLiveChecks) {
+    KillSwitch halts;
+    halts.halt(HaltScope::Instrument, 65);
+    halts.halt(HaltScope::Strategy, 31);
+    KillSwitch::Snapshot snap = halts.snapshot();
+    for (InstrumentId i : {0u, 1u, 64u, 65u, 255u}) {
+        for (StrategyId s : {0, 30, 31}) {
+            OrderRequest req = make_order(i, 0, s);
+            EXPECT_EQ(snap.blocks(req), halts.blocks(req));
+        }
+    }
+}
+
+TEST(KillSwitchTest, ConcurrentHaltsAreNotLost) {
+    KillSwitch halts;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&halts, t] {
+            for (uint32_t i = t; i < MAX_INSTRUMENTS; i += 4) halts.halt(HaltScope::Instrument, i);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (uint32_t i = 0; i < MAX_INSTRUMENTS; ++i) {
+        EXPECT_TRUE(halts.halted(HaltScope::Instrument, i)) << i;
+    }
+    EXPECT_EQ(halts.generation(), MAX_INSTRUMENTS);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "monitoring/latency_estimator.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace trading;
+
+TEST(P2QuantileTest, ExactDuringWarmUp) {
+    P2Quantile median(0.5);
+    EXPECT_EQ(median.value(), 0.0);
+    median.record(30);
+    median.record(10);
+    median.record(20);
+    EXPECT_EQ(median.count(), 3u);
+    EXPECT_DOUBLE_EQ(median.value(), 20.0);
+}
+
+TEST(P2QuantileTest, TracksQuantilesOfSkewedStream) {
+    std::mt19937 rng(7);
+    std::exponential_distribution<double> latency(1.0 / 1000.0);   // Mean 1us
+    P2Quantile p50(0.5);
+    P2Quantile p99(0.99);
+    std::vector<double> samples;
+    for (int i = 0; i < 50000; ++i) {
+        double x = latency(rng);
+        samples.push_back(x);
+        p50.record(x);
+        p99.record(x);
+    }
+    std::sort(samples.begin(), samples.end());
+    double exact_p50 = samples[samples.size() / 2];
+    double exact_p99 = samples[samples.size() * 99 / 100];
+    EXPECT_NEAR(p50.value(), exact_p50, exact_p50 * 0.03);
+    EXPECT_NEAR(p99.value(), exact_p99, exact_p99 * 0.05);
+}
+
+TEST(P2QuantileTest, ResetStartsOver) {
+    P2Quantile q(0.9);
+    for (int i = 0; i < 100; ++i) q.record(1000);
+    q.reset();
+    EXPECT_EQ(q.count(), 0u);
+    q.record(5);
+    EXPECT_DOUBLE_EQ(q.value(), 5.0);
+}
+
+TEST(LatencyEstimatorTest, MeanIsEwma) {
+    LatencyEstimator estimator(0.99, 0.5);
+    estimator.record(1000);
+    EXPECT_DOUBLE_EQ(estimator.mean(), 1000.0);    // First sample seeds it
+    estimator.record(2000);
+    EXPECT_DOUBLE_EQ(estimator.mean(), 1500.0);
+    estimator.record(2000);
+    EXPECT_DOUBLE_EQ(estimator.mean(), 1750.0);
+    EXPECT_EQ(estimator.count(), 3u);
+}
+
+TEST(LatencyEstimatorTest, TailForgetsOldWindows) {
+    LatencyEstimator estimator(0.99, 0.125, 256);
+    for (int i = 0; i < 512; ++i) estimator.record(1000 + i % 10);
+    EXPECT_LT(estimator.tail(), 1100.0);
+
+    // Degrades: within a window the tail reflects the new regime
+    for (int i = 0; i < 300; ++i) estimator.record(50000 + i % 10);
+    EXPECT_GT(estimator.tail(), 40000.0);
+
+    // Recovers: two windows later the slow samples are gone
+    for (int i = 0; i < 600; ++i) estimator.record(1000 + i % 10);
+    EXPECT_LT(estimator.tail(), 1100.0);
+    EXPECT_LT(estimator.mean(), 1100.0);
+}
+
+TEST(LatencyEstimatorTest, FreshWindowServesPreviousEstimate) {
+    LatencyEstimator estimator(0.99, 0.125, 64);
+    for (int i = 0; i < 64; ++i) estimator.record(5000);
+    estimator.record(1);     // Starts a new window with one sample
+    EXPECT_DOUBLE_EQ(estimator.tail(), 5000.0);
+}
@@ -118,3 +118,130 @@ TEST_F(MarketMakerTest, VolatilityWidensSpread) {
 
     EXPECT_GT(spread2, spread1);
 }
+
+TEST_F(MarketMakerTest, UnchangedMarketDoesNotRequote) {
+    params_.min_requote_interval_ns = 0;
+    MarketMakerStrategy mm(params_);
+    mm.on_market_data(make_md(15000, 15010));
+    ASSERT_EQ(mm.generate_orders().size(), 2u);
+
+    // Same BBO: live quotes are still on target
+    mm.on_market_data(make_md(15000, 15010));
+    EXPECT_TRUE(mm.generate_orders().empty());
+    EXPECT_EQ(mm.quotes().updates_sent(), 2u);
+}
+
+TEST_F(MarketMakerTest, PriceMoveReplacesQuotes) {
+    params_.min_requote_interval_ns = 0;
+    MarketMakerStrategy mm(params_);
+    mm.on_market_data(make_md(15000, 15010));
+    auto first = mm.generate_orders();
+    ASSERT_EQ(first.size(), 2u);
+    OrderId first_bid = first[0].side == Side::Buy ? first[0].id : first[1].id;
+
+    mm.on_market_data(make_md(15100, 15110));
+    auto orders = mm.generate_orders();
+    ASSERT_EQ(orders.size(), 2u);
+    for (const auto& o : orders) {
+        EXPECT_EQ(o.action, OrderAction::Replace);
+        if (o.side == Side::Buy) {
+            EXPECT_EQ(o.orig_id, first_bid);
+        }
+    }
+}
+
+TEST_F(MarketMakerTest, FlattenCancelsLiveQuotes) {
+    MarketMakerStrategy mm(params_);
+    mm.on_market_data(make_md(15000, 15010));
+    ASSERT_EQ(mm.generate_orders().size(), 2u);
+
+    ExecutionReport fill{};
+    fill.instrument = 0;
+    fill.side = Side::Buy;
+    fill.status = OrderStatus::Filled;
+    fill.filled_quantity = 100;
+    mm.on_execution_report(fill);
+
+    auto orders = mm.generate_orders();
+    ASSERT_EQ(orders.size(), 3u);
+    EXPECT_EQ(orders[0].action, OrderAction::Cancel);
+    EXPECT_EQ(orders[1].action, OrderAction::Cancel);
+    EXPECT_EQ(orders[2].action, OrderAction::New);
+    EXPECT_EQ(orders[2].side, Side::Sell);
+}
+
+TEST_F(MarketMakerTest, HoldingAtLimitKeepsOneFlattenOrder) {
+    params_.min_requote_interval_ns = 0;
+    MarketMakerStrategy mm(params_);
+    mm.on_market_data(make_md(15000, 15010));
+
+    ExecutionReport fill{};
+    fill.instrument = 0;
+    fill.side = Side::Buy;
+    fill.status = OrderStatus::Filled;
+    fill.filled_quantity = 100;
+    mm.on_execution_report(fill);
+
+    // The flatten order rests unfilled while the bid drifts
+    int news = 0;
+    int replaces = 0;
+    for (int tick = 0; tick < 50; ++tick) {
+        mm.on_market_data(make_md(15000 - tick / 10 * 5, 15010 - tick / 10 * 5));
+        for (const auto& order : mm.generate_orders()) {
+            EXPECT_NE(order.side, Side::Buy);
+            news += order.action == OrderAction::New;
+            replaces += order.action == OrderAction::Replace;
+            if (order.action != OrderAction::Cancel) EXPECT_EQ(order.quantity, 100u);
+        }
+    }
+    EXPECT_EQ(news, 1);
+    EXPECT_EQ(replaces, 4);     // Once per move of the bid
+    const auto& flatten = mm.quotes().quote(0, Side::Sell);
+    ASSERT_TRUE(flatten.live);
+    EXPECT_EQ(flatten.price, 14980);
+
+    // Partly filled back under the limit: the rest is cancelled
+    ExecutionReport partial{};
+    partial.order_id = flatten.order_id;
+    partial.instrument = 0;
+    partial.side = Side::Sell;
+    partial.status = OrderStatus::PartiallyFilled;
+    partial.filled_quantity = 30;
+    partial.leaves_quantity = 70;
+    mm.on_execution_report(partial);
+    const OrderId flatten_id = flatten.order_id;
+
+    auto orders = mm.generate_orders();
+    ASSERT_FALSE(orders.empty());
+    EXPECT_EQ(orders[0].action, OrderAction::Cancel);
+    EXPECT_EQ(orders[0].orig_id, flatten_id);
+    for (size_t i = 1; i < orders.size(); ++i) {
+        EXPECT_EQ(orders[i].action, OrderAction::New);
+        EXPECT_EQ(orders[i].quantity, params_.order_size);   // Back to quoting
+    }
+}
+
+TEST_F(MarketMakerTest, MicropriceShiftsQuotes) {
+    OrderBook book(0);
+    BookFeatures features(book);
+    book.set_listener(&features);
+    book.add_order(1, Side::Buy, OrderType::Limit, 15000, 900, now_ns());
+    book.add_order(2, Side::Sell, OrderType::Limit, 15010, 100, now_ns());
+
+    MarketMakerStrategy plain(params_);
+    MarketMakerStrategy micro(params_);
+    micro.set_book_features(&features);
+    plain.on_market_data(make_md(15000, 15010));
+    micro.on_market_data(make_md(15000, 15010));
+
+    auto bid_of = [](std::span<const OrderRequest> orders) {
+        for (const auto& o : orders) {
+            if (o.side == Side::Buy) return o.price;
+        }
+        return Price{0};
+    };
+    Price plain_bid = bid_of(plain.generate_orders());
+    Price micro_bid = bid_of(micro.generate_orders());
+    // Bid-heavy book: microprice sits above mid, so quotes move up
+    EXPECT_GT(micro_bid, plain_bid);
+}
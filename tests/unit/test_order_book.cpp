@@ -181,3 +181,50 @@ TEST_F(OrderBookTest, StressTest) {
     // Should not crash and BBO should be valid
     EXPECT_GE(book_.best_bid(), 0);
 }
+
+TEST_F(OrderBookTest, FullFillReducesLevelQuantity) {
+    add_limit(Side::Sell, 10000, 40);
+    add_limit(Side::Sell, 10000, 60);
+    book_.add_order(next_id_++, Side::Buy, OrderType::Limit, 10000, 50, now_ns());
+
+    OrderBook::DepthEntry asks[1];
+    ASSERT_EQ(book_.get_side_depth(Side::Sell, asks, 1), 1u);
+    EXPECT_EQ(asks[0].quantity, 50u);
+    EXPECT_EQ(asks[0].order_count, 1u);
+}
+
+namespace {
+struct RecordingListener : OrderBookListener {
+    struct Update { Side side; Price price; Quantity quantity; };
+    std::vector<Update> updates;
+    void on_level_update(InstrumentId, Side side, Price price, Quantity qty) override {
+        updates.push_back({side, price, qty});
+    }
+};
+} // namespace
+
+TEST_F(OrderBookTest, ListenerSeesLevelChanges) {
+    RecordingListener listener;
+    book_.set_listener(&listener);
+
+    OrderId a = add_limit(Side::Buy, 9900, 30);
+    add_limit(Side::Buy, 9900, 20);
+    ASSERT_EQ(listener.updates.size(), 2u);
+    EXPECT_EQ(listener.updates[1].quantity, 50u);
+
+    book_.cancel_order(a);
+    ASSERT_EQ(listener.updates.size(), 3u);
+    EXPECT_EQ(listener.updates[2].quantity, 20u);
+
+    // Sweep two ask levels: one notification per level, removed levels report 0
+    add_limit(Side::Sell, 10000, 10);
+    add_limit(Side::Sell, 10100, 10);
+    listener.updates.clear();
+    book_.add_order(next_id_++, Side::Buy, OrderType::Market, 0, 15, now_ns());
+    ASSERT_EQ(listener.updates.size(), 2u);
+    EXPECT_EQ(listener.updates[0].side, Side::Sell);
+    EXPECT_EQ(listener.updates[0].price, 10000);
+    EXPECT_EQ(listener.updates[0].quantity, 0u);
+    EXPECT_EQ(listener.updates[1].price, 10100);
+    EXPECT_EQ(listener.updates[1].quantity, 5u);
+}
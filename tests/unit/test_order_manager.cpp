@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include "execution/order_manager.hpp"
+
+using namespace trading;
+
+namespace {
+
+OrderRequest limit_order(OrderId id, Quantity quantity, OrderType type = OrderType::Limit) {
+    OrderRequest req{};
+    req.id = id;
+    req.side = Side::Buy;
+    req.type = type;
+    req.price = 15000;
+    req.quantity = quantity;
+    return req;
+}
+
+ExecutionReport venue_report(OrderId id, OrderId exec_id, OrderStatus status, Quantity quantity,
+                             Quantity filled, Price price = 15000) {
+    ExecutionReport report{};
+    report.order_id = id;
+    report.exec_id = exec_id;
+    report.status = status;
+    report.price = price;
+    report.quantity = quantity;
+    report.filled_quantity = filled;
+    report.leaves_quantity = quantity - filled;
+    return report;
+}
+
+using Result = OrderManager::ReportResult;
+
+} // namespace
+
+TEST(OrderManagerTest, ReportsDriveStateMachine) {
+    OrderManager orders;
+    ASSERT_NE(orders.open(limit_order(1, 100)), nullptr);
+    EXPECT_EQ(orders.find(1)->state, OrderState::PendingNew);
+    EXPECT_EQ(orders.find(1)->leaves(), 100u);
+
+    ExecutionReport publish;
+    EXPECT_EQ(orders.on_report(venue_report(1, 1, OrderStatus::New, 100, 0), OrderAction::New, publish),
+              Result::Applied);
+    EXPECT_EQ(orders.find(1)->state, OrderState::New);
+    EXPECT_EQ(publish.filled_quantity, 0u);
+
+    // Cumulative 30 then 100: published as 30 and 70
+    EXPECT_EQ(orders.on_report(venue_report(1, 2, OrderStatus::PartiallyFilled, 100, 30, 15000),
+                               OrderAction::New, publish), Result::Applied);
+    EXPECT_EQ(orders.find(1)->state, OrderState::PartiallyFilled);
+    EXPECT_EQ(publish.filled_quantity, 30u);
+    EXPECT_EQ(publish.leaves_quantity, 70u);
+
+    EXPECT_EQ(orders.on_report(venue_report(1, 3, OrderStatus::Filled, 100, 100, 15100),
+                               OrderAction::New, publish), Result::Applied);
+    EXPECT_EQ(publish.status, OrderStatus::Filled);
+    EXPECT_EQ(publish.filled_quantity, 70u);
+    EXPECT_EQ(publish.leaves_quantity, 0u);
+
+    // Terminal: released
+    EXPECT_EQ(orders.find(1), nullptr);
+    EXPECT_EQ(orders.live_count(), 0u);
+}
+
+TEST(OrderManagerTest, DuplicateReportsAreDropped) {
+    OrderManager orders;
+    orders.open(limit_order(1, 100));
+    ExecutionReport publish;
+    ExecutionReport fill = venue_report(1, 7, OrderStatus::PartiallyFilled, 100, 40);
+    EXPECT_EQ(orders.on_report(fill, OrderAction::New, publish), Result::Applied);
+
+    // Same exec id, then same state and fill under a new exec id
+    EXPECT_EQ(orders.on_report(fill, OrderAction::New, publish), Result::Duplicate);
+    fill.exec_id = 8;
+    EXPECT_EQ(orders.on_report(fill, OrderAction::New, publish), Result::Duplicate);
+    EXPECT_EQ(orders.find(1)->filled, 40u);
+    EXPECT_EQ(orders.duplicates(), 2u);
+
+    // Resent after the order was closed
+    orders.on_report(venue_report(1, 9, OrderStatus::Filled, 100, 100), OrderAction::New, publish);
+    EXPECT_EQ(orders.on_report(venue_report(1, 9, OrderStatus::Filled, 100, 100), OrderAction::New, publish),
+              Result::Duplicate);
+    EXPECT_EQ(orders.duplicates(), 3u);
+}
+
+TEST(OrderManagerTest, OutOfOrderReportsAreStale) {
+    OrderManager orders;
+    orders.open(limit_order(1, 100));
+    ExecutionReport publish;
+    EXPECT_EQ(orders.on_report(venue_report(1, 2, OrderStatus::PartiallyFilled, 100, 50),
+                               OrderAction::New, publish), Result::Applied);
+
+    // The ack and an earlier fill arrive late
+    EXPECT_EQ(orders.on_report(venue_report(1, 1, OrderStatus::New, 100, 0), OrderAction::New, publish),
+              Result::Stale);
+    EXPECT_EQ(orders.on_report(venue_report(1, 3, OrderStatus::PartiallyFilled, 100, 20),
+                               OrderAction::New, publish), Result::Stale);
+    EXPECT_EQ(orders.find(1)->state, OrderState::PartiallyFilled);
+    EXPECT_EQ(orders.find(1)->filled, 50u);
+    EXPECT_EQ(orders.stale_reports(), 2u);
+}
+
+TEST(OrderManagerTest, CancelMovesOrderOnlyWhenConfirmed) {
+    OrderManager orders;
+    orders.open(limit_order(1, 100));
+    ExecutionReport publish;
+    orders.on_report(venue_report(1, 1, OrderStatus::PartiallyFilled, 100, 25), OrderAction::New, publish);
+
+    // A refused cancel passes through and leaves the order working
+    EXPECT_EQ(orders.on_report(venue_report(1, 0, OrderStatus::Rejected, 100, 0), OrderAction::Cancel, publish),
+              Result::Untracked);
+    EXPECT_EQ(publish.status, OrderStatus::Rejected);
+    EXPECT_EQ(orders.find(1)->state, OrderState::PartiallyFilled);
+
+    // The confirmation carries no fill total: nothing new is published as filled
+    EXPECT_EQ(orders.on_report(venue_report(1, 2, OrderStatus::Cancelled, 100, 0), OrderAction::Cancel, publish),
+              Result::Applied);
+    EXPECT_EQ(publish.filled_quantity, 0u);
+    EXPECT_EQ(publish.leaves_quantity, 0u);
+    EXPECT_EQ(orders.find(1), nullptr);
+}
+
+TEST(OrderManagerTest, ReplaceClosesOriginal) {
+    OrderManager orders;
+    orders.open(limit_order(1, 100));
+    ExecutionReport publish;
+    orders.on_report(venue_report(1, 1, OrderStatus::New, 100, 0), OrderAction::New, publish);
+
+    OrderRequest replace = limit_order(2, 80);
+    replace.action = OrderAction::Replace;
+    replace.orig_id = 1;
+    ASSERT_NE(orders.open(replace), nullptr);
+    EXPECT_EQ(orders.on_report(venue_report(2, 2, OrderStatus::New, 80, 0), OrderAction::Replace, publish),
+              Result::Applied);
+    EXPECT_EQ(orders.find(1), nullptr);
+    EXPECT_EQ(orders.find(2)->state, OrderState::New);
+    EXPECT_EQ(orders.live_count(), 1u);
+}
+
+TEST(OrderManagerTest, ReplacedOriginalStillAppliesInFlightFills) {
+    OrderManager orders;
+    ExecutionReport publish;
+
+    // Split original: one child acknowledged, the other's report still in flight
+    orders.open(limit_order(1, 100));
+    orders.open_child(1, 11, 0, 60);
+    orders.open_child(1, 12, 1, 40);
+    orders.on_report(venue_report(11, 1, OrderStatus::New, 60, 0), OrderAction::New, publish);
+
+    OrderRequest replace = limit_order(2, 80);
+    replace.action = OrderAction::Replace;
+    replace.orig_id = 1;
+    orders.open(replace);
+    EXPECT_EQ(orders.on_report(venue_report(2, 2, OrderStatus::New, 80, 0), OrderAction::Replace, publish),
+              Result::Applied);
+    ASSERT_NE(orders.find(1), nullptr);
+    EXPECT_EQ(orders.find(1)->open_children, 1u);
+
+    // The late child's fill executed before the pull: published, then the original ends
+    EXPECT_EQ(orders.on_report(venue_report(12, 3, OrderStatus::PartiallyFilled, 40, 30),
+                               OrderAction::New, publish), Result::Applied);
+    EXPECT_EQ(publish.order_id, 1u);
+    EXPECT_EQ(publish.filled_quantity, 30u);
+    EXPECT_EQ(publish.status, OrderStatus::Cancelled);
+    EXPECT_EQ(publish.leaves_quantity, 0u);
+    EXPECT_EQ(orders.find(1), nullptr);
+    EXPECT_EQ(orders.duplicates(), 0u);
+
+    // Unsplit original replaced before its own report landed
+    orders.open(limit_order(3, 100));
+    OrderRequest replace_again = limit_order(4, 50);
+    replace_again.action = OrderAction::Replace;
+    replace_again.orig_id = 3;
+    orders.open(replace_again);
+    orders.on_report(venue_report(4, 4, OrderStatus::New, 50, 0), OrderAction::Replace, publish);
+    EXPECT_EQ(orders.on_report(venue_report(3, 5, OrderStatus::PartiallyFilled, 100, 20),
+                               OrderAction::New, publish), Result::Applied);
+    EXPECT_EQ(publish.filled_quantity, 20u);
+    EXPECT_EQ(publish.status, OrderStatus::Cancelled);
+    EXPECT_EQ(orders.find(3), nullptr);
+    EXPECT_EQ(orders.live_count(), 2u);   // The two replacements
+}
+
+TEST(OrderManagerTest, UnrestedRemainderIsTerminal) {
+    OrderManager orders;
+    orders.open(limit_order(1, 100, OrderType::IOC));
+    ExecutionReport publish;
+    EXPECT_EQ(orders.on_report(venue_report(1, 1, OrderStatus::PartiallyFilled, 100, 60),
+                               OrderAction::New, publish), Result::Applied);
+    EXPECT_EQ(publish.filled_quantity, 60u);
+    EXPECT_EQ(publish.leaves_quantity, 0u);
+    EXPECT_EQ(orders.find(1), nullptr);
+}
+
+TEST(OrderManagerTest, ChildrenRollUpIntoParent) {
+    OrderManager orders;
+    orders.open(limit_order(1, 100));
+    const OrderId child_a = (1ULL << 63) | 1;
+    const OrderId child_b = (1ULL << 63) | 2;
+    ASSERT_NE(orders.open_child(1, child_a, 0, 60), nullptr);
+    ASSERT_NE(orders.open_child(1, child_b, 1, 40), nullptr);
+    EXPECT_EQ(orders.find(1)->children, 2u);
+
+    // First ack moves the parent; the second has nothing new for it
+    ExecutionReport publish;
+    EXPECT_EQ(orders.on_report(venue_report(child_a, 1, OrderStatus::New, 60, 0), OrderAction::New, publish),
+              Result::Applied);
+    EXPECT_EQ(publish.order_id, 1u);
+    EXPECT_EQ(publish.status, OrderStatus::New);
+    EXPECT_EQ(orders.on_report(venue_report(child_b, 2, OrderStatus::New, 40, 0), OrderAction::New, publish),
+              Result::Absorbed);
+
+    EXPECT_EQ(orders.on_report(venue_report(child_a, 3, OrderStatus::Filled, 60, 60, 15000),
+                               OrderAction::New, publish), Result::Applied);
+    EXPECT_EQ(publish.order_id, 1u);
+    EXPECT_EQ(publish.status, OrderStatus::PartiallyFilled);
+    EXPECT_EQ(publish.quantity, 100u);
+    EXPECT_EQ(publish.filled_quantity, 60u);
+    EXPECT_EQ(publish.leaves_quantity, 40u);
+    EXPECT_EQ(orders.find(1)->open_children, 1u);
+
+    EXPECT_EQ(orders.on_report(venue_report(child_b, 4, OrderStatus::Filled, 40, 40, 15100),
+                               OrderAction::New, publish), Result::Applied);
+    EXPECT_EQ(publish.status, OrderStatus::Filled);
+    EXPECT_EQ(publish.filled_quantity, 40u);
+    EXPECT_EQ(publish.leaves_quantity, 0u);
+
+    // Parent and children released together
+    EXPECT_EQ(orders.live_count(), 0u);
+}
+
+TEST(OrderManagerTest, ParentEndsWhenAllChildrenEnd) {
+    OrderManager orders;
+    ExecutionReport publish;
+
+    // Every child rejected: the parent is rejected
+    orders.open(limit_order(1, 100));
+    orders.open_child(1, 11, 0, 50);
+    orders.open_child(1, 12, 1, 50);
+    EXPECT_EQ(orders.on_report(venue_report(11, 1, OrderStatus::Rejected, 50, 0), OrderAction::New, publish),
+              Result::Absorbed);
+    EXPECT_EQ(orders.on_report(venue_report(12, 2, OrderStatus::Rejected, 50, 0), OrderAction::New, publish),
+              Result::Applied);
+    EXPECT_EQ(publish.status, OrderStatus::Rejected);
+    EXPECT_EQ(orders.live_count(), 0u);
+
+    // Part filled, the rest rejected: the parent is done, not rejected
+    orders.open(limit_order(2, 100));
+    orders.open_child(2, 21, 0, 50);
+    orders.open_child(2, 22, 1, 50);
+    orders.on_report(venue_report(21, 3, OrderStatus::Filled, 50, 50), OrderAction::New, publish);
+    EXPECT_EQ(orders.on_report(venue_report(22, 4, OrderStatus::Rejected, 50, 0), OrderAction::New, publish),
+              Result::Applied);
+    EXPECT_EQ(publish.status, OrderStatus::Cancelled);
+    EXPECT_EQ(publish.filled_quantity, 0u);
+    EXPECT_EQ(orders.live_count(), 0u);
+}
+
+TEST(OrderManagerTest, OpenRefusesLiveIdsAndFullTable) {
+    OrderManager orders;
+    ASSERT_NE(orders.open(limit_order(1, 100)), nullptr);
+    EXPECT_EQ(orders.open(limit_order(1, 100)), nullptr);
+    EXPECT_EQ(orders.open_child(99, 100, 0, 10), nullptr);     // Unknown parent
+
+    for (OrderId id = 2; id <= OrderManager::MAX_ORDERS; ++id) {
+        ASSERT_NE(orders.open(limit_order(id, 100)), nullptr);
+    }
+    EXPECT_EQ(orders.open(limit_order(OrderManager::MAX_ORDERS + 1, 100)), nullptr);
+
+    // Releasing one makes room again
+    ExecutionReport publish;
+    orders.on_report(venue_report(1, 1, OrderStatus::Cancelled, 100, 0), OrderAction::Cancel, publish);
+    EXPECT_NE(orders.open(limit_order(OrderManager::MAX_ORDERS + 1, 100)), nullptr);
+}
@@ -82,3 +82,378 @@ TEST_F(OrderRouterTest, NoExchanges) {
     auto report = router.route_order(req);
     EXPECT_EQ(report.status, OrderStatus::Rejected);
 }
+
+TEST_F(OrderRouterTest, ReplaceRouting) {
+    ExchangeSimulator sim1(config1_);
+    ExchangeSimulator sim2(config2_);
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+
+    OrderRequest req{};
+    req.id = 42;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = 15000;
+    req.quantity = 100;
+    auto placed = router.route_order(req);
+
+    OrderRequest replace = req;
+    replace.id = 43;
+    replace.price = 14990;
+    replace.action = OrderAction::Replace;
+    replace.orig_id = 42;
+    auto report = router.route_order(replace);
+
+    EXPECT_EQ(report.order_id, 43u);
+    EXPECT_EQ(report.status, OrderStatus::New);
+    EXPECT_EQ(report.exchange, placed.exchange); // Stays on the original venue
+    EXPECT_EQ(router.open_order_count(), 1u);
+
+    OrderRequest cancel{};
+    cancel.id = 44;
+    cancel.action = OrderAction::Cancel;
+    cancel.orig_id = 42; // Already replaced
+    EXPECT_EQ(router.route_order(cancel).status, OrderStatus::Rejected);
+
+    cancel.orig_id = 43;
+    EXPECT_EQ(router.route_order(cancel).status, OrderStatus::Cancelled);
+    EXPECT_EQ(router.open_order_count(), 0u);
+}
+
+namespace {
+
+OrderRequest buy_limit(OrderId id, Price price, Quantity quantity) {
+    OrderRequest req{};
+    req.id = id;
+    req.side = Side::Buy;
+    req.type = OrderType::Limit;
+    req.price = price;
+    req.quantity = quantity;
+    return req;
+}
+
+} // namespace
+
+TEST_F(OrderRouterTest, BestPriceSweepsAcrossVenues) {
+    ExchangeSimulator sim1(config1_);
+    ExchangeSimulator sim2(config2_);
+    ExchangeConfig config3{2, "EX_WIDE", 100, 1.0, true};
+    ExchangeSimulator sim3(config3);
+    sim1.seed_book(15000, 5, 100);  // Asks 15001..
+    sim2.seed_book(14998, 5, 100);  // Asks 14999..
+    sim3.seed_book(15005, 5, 100);  // Asks 15006.. (above the limit)
+
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.add_exchange(&sim3);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+
+    OrderRequest req = buy_limit(1, 15003, 250);
+    OrderRouter::SweepPlan plan;
+    ASSERT_EQ(router.plan_sweep(req, plan), 2u);
+    EXPECT_EQ(plan.children[0].exchange, &sim2);    // 14999, 15000
+    EXPECT_EQ(plan.children[0].quantity, 200u);
+    EXPECT_EQ(plan.children[1].exchange, &sim1);    // 15001 (ties to the earlier venue)
+    EXPECT_EQ(plan.children[1].quantity, 50u);
+    EXPECT_EQ(plan.displayed, 250u);
+
+    auto report = router.route_order(req);
+    EXPECT_EQ(report.order_id, 1u);
+    EXPECT_EQ(report.status, OrderStatus::Filled);
+    EXPECT_EQ(report.filled_quantity, 250u);
+    EXPECT_EQ(report.leaves_quantity, 0u);
+    EXPECT_EQ(report.exchange, 1u);
+    EXPECT_EQ(router.open_order_count(), 0u);
+    EXPECT_EQ(sim2.fills(), 1u);
+    EXPECT_EQ(sim1.fills(), 1u);
+    EXPECT_EQ(sim3.orders_processed(), 0u);
+}
+
+TEST_F(OrderRouterTest, SweepPricesParentAtChildrenVwap) {
+    ExchangeSimulator sim1(config1_);
+    ExchangeSimulator sim2(config2_);
+    sim1.seed_book(15000, 2, 100);  // Asks 15001, 15002
+    sim2.seed_book(15001, 2, 100);  // Asks 15002, 15003
+
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+
+    // sim1's child walks two levels; its report carries only the last (15002)
+    OrderRouter::ChildReports children;
+    auto report = router.route_order(buy_limit(1, 15002, 300), &children);
+    ASSERT_EQ(children.count, 2u);
+    EXPECT_EQ(children.reports[0].filled_quantity, 200u);
+    EXPECT_EQ(children.reports[0].price, 15002);
+    EXPECT_EQ(children.notionals[0], 15001 * 100 + 15002 * 100);
+    EXPECT_EQ(children.notionals[1], 15002 * 100);
+
+    EXPECT_EQ(report.status, OrderStatus::Filled);
+    EXPECT_EQ(report.price, (15001 * 100 + 15002 * 200) / 300);
+}
+
+TEST_F(OrderRouterTest, BestPriceRanksNetOfFees) {
+    ExchangeConfig cheap_price = config1_;
+    cheap_price.taker_fee_bps = 10.0;   // 15001 -> ~15016 net
+    ExchangeSimulator sim1(cheap_price);
+    ExchangeSimulator sim2(config2_);   // No fee
+    sim1.seed_book(15000, 3, 100);
+    sim2.seed_book(15005, 3, 100);      // 15006 net
+
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+
+    OrderRouter::SweepPlan plan;
+    ASSERT_EQ(router.plan_sweep(buy_limit(1, 15010, 100), plan), 1u);
+    EXPECT_EQ(plan.children[0].exchange, &sim2);
+
+    OrderRequest sell = buy_limit(2, 14990, 100);
+    sell.side = Side::Sell;             // Bids 14999 (less fee) vs 15004
+    ASSERT_EQ(router.plan_sweep(sell, plan), 1u);
+    EXPECT_EQ(plan.children[0].exchange, &sim2);
+}
+
+TEST_F(OrderRouterTest, SweepRemainderRestsAndParentCancelsChildren) {
+    ExchangeSimulator sim1(config1_);
+    ExchangeSimulator sim2(config2_);
+    sim1.seed_book(15000, 1, 100);
+    sim2.seed_book(15000, 1, 100);
+
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+
+    OrderRequest req = buy_limit(7, 15001, 300);
+    OrderRouter::SweepPlan plan;
+    ASSERT_EQ(router.plan_sweep(req, plan), 2u);
+    EXPECT_EQ(plan.children[0].quantity, 200u);     // Remainder rests on the best venue
+    EXPECT_EQ(plan.children[1].quantity, 100u);
+    EXPECT_EQ(plan.displayed, 200u);
+
+    auto report = router.route_order(req);
+    EXPECT_EQ(report.status, OrderStatus::PartiallyFilled);
+    EXPECT_EQ(report.filled_quantity, 200u);
+    EXPECT_EQ(report.leaves_quantity, 100u);
+    EXPECT_EQ(report.price, 15001);
+    EXPECT_EQ(router.open_order_count(), 1u);
+
+    auto cancel = router.cancel_order(7);
+    EXPECT_EQ(cancel.order_id, 7u);
+    EXPECT_EQ(cancel.status, OrderStatus::Cancelled);
+    EXPECT_EQ(router.open_order_count(), 0u);
+    EXPECT_EQ(router.cancel_order(7).status, OrderStatus::Rejected);
+}
+
+TEST_F(OrderRouterTest, SweepFallbacks) {
+    ExchangeConfig pricey = config1_;
+    pricey.taker_fee_bps = 3.0;
+    ExchangeSimulator sim1(pricey);
+    ExchangeSimulator sim2(config2_);
+
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+
+    // Empty books: the whole order goes to the cheapest venue and rests
+    OrderRouter::SweepPlan plan;
+    ASSERT_EQ(router.plan_sweep(buy_limit(1, 15000, 100), plan), 1u);
+    EXPECT_EQ(plan.children[0].exchange, &sim2);
+    EXPECT_EQ(plan.children[0].quantity, 100u);
+    EXPECT_EQ(plan.displayed, 0u);
+
+    // FOK is never split even when it could be
+    sim1.seed_book(15000, 1, 100);
+    sim2.seed_book(15000, 1, 100);
+    OrderRequest fok = buy_limit(2, 15001, 150);
+    fok.type = OrderType::FOK;
+    ASSERT_EQ(router.plan_sweep(fok, plan), 1u);
+    EXPECT_EQ(plan.children[0].quantity, 150u);
+
+    // No enabled venue: nothing to route to
+    OrderRouter disabled_router;
+    ExchangeConfig off = config1_;
+    off.enabled = false;
+    ExchangeSimulator sim_off(off);
+    disabled_router.add_exchange(&sim_off);
+    disabled_router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+    EXPECT_EQ(disabled_router.plan_sweep(buy_limit(3, 15000, 100), plan), 0u);
+    EXPECT_EQ(disabled_router.route_order(buy_limit(3, 15000, 100)).status, OrderStatus::Rejected);
+}
+
+TEST_F(OrderRouterTest, LowestLatencyAvoidsDegradedVenue) {
+    ExchangeSimulator sim1(config1_);   // Configured 100ns
+    ExchangeSimulator sim2(config2_);   // Configured 500ns
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::LowestLatency);
+    EXPECT_DOUBLE_EQ(router.predicted_latency_ns(0), 100.0);   // Config prior
+
+    OrderRequest req{};
+    req.side = Side::Buy;
+    req.type = OrderType::IOC;
+    req.price = 15000;
+    req.quantity = 1;
+    auto route = [&](OrderId id) {
+        req.id = id;
+        return router.route_order(req).exchange;
+    };
+
+    // Measured: the "fast" venue is slow under load
+    for (int i = 0; i < 200; ++i) {
+        router.record_latency(0, 20000);
+        router.record_latency(1, 600);
+    }
+    EXPECT_GT(router.predicted_latency_ns(0), router.predicted_latency_ns(1));
+    EXPECT_EQ(route(1), 1u);
+
+    // It recovers; the other venue starts rejecting everything
+    for (int i = 0; i < 2048; ++i) {
+        router.record_latency(0, 150);
+        router.record_fill_outcome(1, false);
+    }
+    EXPECT_LT(router.fill_rate(1), 0.01);
+    EXPECT_EQ(route(2), 0u);
+}
+
+TEST_F(OrderRouterTest, LowestLatencyWeighsFillRate) {
+    ExchangeSimulator sim1(config1_);
+    ExchangeSimulator sim2(config2_);
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::LowestLatency);
+
+    // 100ns at a 10% fill rate is worse than 500ns that always fills
+    for (int i = 0; i < 100; ++i) router.record_fill_outcome(0, i % 10 == 0);
+    EXPECT_NEAR(router.fill_rate(0), 0.1, 0.05);
+    OrderRequest req{};
+    req.id = 1;
+    req.side = Side::Buy;
+    req.price = 15000;
+    req.quantity = 1;
+    EXPECT_EQ(router.route_order(req).exchange, 1u);
+
+    // Unknown exchanges are ignored
+    router.record_latency(9, 1);
+    EXPECT_EQ(router.predicted_latency_ns(9), 0.0);
+}
+
+TEST_F(OrderRouterTest, OnlyRestingOrdersAreTracked) {
+    ExchangeSimulator sim1(config1_);
+    sim1.seed_book(15000, 5, 1000000);
+    OrderRouter router;
+    router.add_exchange(&sim1);
+
+    // Fills and IOC remainders are terminal on arrival: nothing accumulates
+    OrderRequest req = buy_limit(1, 15001, 10);
+    for (OrderId id = 1; id <= 100000; ++id) {
+        req.id = id;
+        req.type = (id & 1) ? OrderType::Limit : OrderType::IOC;
+        req.price = (id & 3) == 2 ? 14000 : 15001;  // Marketable, or an IOC that misses
+        auto report = router.route_order(req);
+        ASSERT_NE(report.status, OrderStatus::New);
+    }
+    EXPECT_EQ(router.open_order_count(), 0u);
+
+    // A resting order is tracked until cancelled
+    auto placed = router.route_order(buy_limit(200000, 14000, 10));
+    EXPECT_EQ(placed.status, OrderStatus::New);
+    EXPECT_EQ(router.open_order_count(), 1u);
+    EXPECT_EQ(router.cancel_order(200000).status, OrderStatus::Cancelled);
+    EXPECT_EQ(router.open_order_count(), 0u);
+}
+
+TEST_F(OrderRouterTest, CancelOfOrderGoneFromVenueDropsEntry) {
+    ExchangeSimulator sim1(config1_);
+    OrderRouter router;
+    router.add_exchange(&sim1);
+
+    ASSERT_EQ(router.route_order(buy_limit(1, 15000, 10)).status, OrderStatus::New);
+    OrderRequest sell = buy_limit(2, 15000, 10);
+    sell.side = Side::Sell;
+    ASSERT_EQ(router.route_order(sell).status, OrderStatus::Filled);   // Fills order 1 passively
+    EXPECT_EQ(router.open_order_count(), 1u);
+
+    EXPECT_EQ(router.cancel_order(1).status, OrderStatus::Rejected);   // Venue no longer has it
+    EXPECT_EQ(router.open_order_count(), 0u);
+}
+
+TEST_F(OrderRouterTest, FullTrackingTableRejectsNewOrders) {
+    ExchangeSimulator sim1(config1_);
+    OrderRouter router;
+    router.add_exchange(&sim1);
+
+    constexpr size_t MAX_TRACKED = OrderRouter::ORDER_MAP_CAPACITY - OrderRouter::ORDER_MAP_CAPACITY / 4;
+    for (OrderId id = 1; id <= MAX_TRACKED; ++id) {
+        ASSERT_EQ(router.route_order(buy_limit(id, 14000, 1)).status, OrderStatus::New);
+    }
+    EXPECT_EQ(router.open_order_count(), MAX_TRACKED);
+
+    uint64_t sent = sim1.orders_processed();
+    EXPECT_EQ(router.route_order(buy_limit(MAX_TRACKED + 1, 14000, 1)).status, OrderStatus::Rejected);
+    EXPECT_EQ(sim1.orders_processed(), sent);     // Never reached the venue
+
+    // Cancels free room
+    EXPECT_EQ(router.cancel_order(1).status, OrderStatus::Cancelled);
+    EXPECT_EQ(router.route_order(buy_limit(MAX_TRACKED + 1, 14000, 1)).status, OrderStatus::New);
+}
+
+TEST_F(OrderRouterTest, VenueRateLimitRoutesAroundThrottledVenue) {
+    ExchangeSimulator sim1(config1_);
+    ExchangeSimulator sim2(config2_);
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::LowestLatency);
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Exchange, 1000, 1);   // One per venue per ms
+    router.set_rate_limiter(&limiter);
+    SimulatedClockScope clock(0);
+
+    // The request's exchange tag plays no part: the venue picked is charged
+    OrderRequest req = buy_limit(1, 14000, 1);
+    req.exchange = 1;
+    EXPECT_EQ(router.route_order(req).exchange, 0u);
+    EXPECT_EQ(router.route_order(buy_limit(2, 14000, 1)).exchange, 1u);     // Fast venue spent
+    EXPECT_EQ(router.route_order(buy_limit(3, 14000, 1)).status, OrderStatus::Rejected);
+    EXPECT_EQ(router.venue_throttled(), 1u);
+    EXPECT_EQ(sim1.orders_processed() + sim2.orders_processed(), 2u);
+
+    // Cancels are never throttled
+    EXPECT_EQ(router.cancel_order(1).status, OrderStatus::Cancelled);
+
+    ThreadClock::set(1'000'000);
+    EXPECT_EQ(router.route_order(buy_limit(4, 14000, 1)).exchange, 0u);
+}
+
+TEST_F(OrderRouterTest, SweepChargesEachChildVenue) {
+    ExchangeSimulator sim1(config1_);
+    ExchangeSimulator sim2(config2_);
+    sim1.seed_book(15000, 5, 100);  // Asks 15001..
+    sim2.seed_book(14998, 5, 100);  // Asks 14999..
+    OrderRouter router;
+    router.add_exchange(&sim1);
+    router.add_exchange(&sim2);
+    router.set_routing_strategy(OrderRouter::RoutingStrategy::BestPrice);
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Exchange, 1000, 1);
+    router.set_rate_limiter(&limiter);
+    SimulatedClockScope clock(0);
+
+    EXPECT_EQ(router.route_order(buy_limit(1, 15003, 250)).status, OrderStatus::Filled);
+    EXPECT_FALSE(limiter.exchange_conforms(0, 0));
+    EXPECT_FALSE(limiter.exchange_conforms(1, 0));
+
+    // Both venues spent: nothing to plan on
+    OrderRouter::SweepPlan plan;
+    EXPECT_EQ(router.plan_sweep(buy_limit(2, 15003, 10), plan), 0u);
+    EXPECT_EQ(router.route_order(buy_limit(2, 15003, 10)).status, OrderStatus::Rejected);
+}
@@ -101,3 +101,110 @@ TEST_F(PairsTradingTest, ExecutionReportUpdatesPosition) {
     EXPECT_EQ(strategy.position_a(), 10);
     EXPECT_EQ(strategy.position_b(), 0);
 }
+
+TEST_F(PairsTradingTest, HedgeRatioConvergesOnline) {
+    PairsTradingStrategy strategy(params_);
+
+    // A tracks half of B's moves: true hedge ratio 0.5
+    Price b = 28000;
+    for (int i = 0; i < 2000; ++i) {
+        b += (i % 7 < 3) ? 13 : -9;
+        Price a = 1000 + b / 2;
+        strategy.on_market_data(make_md(1, b - 1, b + 1));
+        strategy.on_market_data(make_md(0, a - 1, a + 1));
+    }
+
+    EXPECT_NEAR(strategy.hedge_ratio(), 0.5, 0.02);
+}
+
+TEST_F(PairsTradingTest, FixedHedgeRatio) {
+    params_.dynamic_hedge_ratio = false;
+    params_.hedge_ratio = 0.8;
+    PairsTradingStrategy strategy(params_);
+
+    for (int i = 0; i < 100; ++i) {
+        strategy.on_market_data(make_md(0, 15000 + i, 15010 + i));
+        strategy.on_market_data(make_md(1, 28000 - i, 28010 - i));
+    }
+
+    EXPECT_DOUBLE_EQ(strategy.hedge_ratio(), 0.8);
+}
+
+TEST(HedgeRatioEstimatorTest, KeepsInitialUntilWarm) {
+    HedgeRatioEstimator estimator(1.0, 100, 50);
+    for (int i = 0; i < 49; ++i) {
+        estimator.update(100.0 + i, 300.0 + 2.0 * i);
+    }
+    EXPECT_DOUBLE_EQ(estimator.beta(), 1.0);
+
+    estimator.update(149.0, 398.0);
+    EXPECT_NEAR(estimator.beta(), 2.0, 1e-9);
+}
+
+TEST(HedgeRatioEstimatorTest, FlatInputKeepsEstimate) {
+    HedgeRatioEstimator estimator(1.5, 100, 1);
+    for (int i = 0; i < 100; ++i) {
+        estimator.update(100.0, 200.0 + i);
+    }
+    EXPECT_DOUBLE_EQ(estimator.beta(), 1.5);
+}
+
+TEST_F(PairsTradingTest, NegativeHedgeRatioTradesLegsTogether) {
+    params_.dynamic_hedge_ratio = false;
+    params_.hedge_ratio = -0.5;
+    PairsTradingStrategy strategy(params_);
+
+    for (int i = 0; i < 30; ++i) {
+        strategy.on_market_data(make_md(0, 15000 + (i % 3), 15010 + (i % 3)));
+        strategy.on_market_data(make_md(1, 15000, 15010));
+        strategy.generate_orders();
+    }
+
+    // Spread A + 0.5*B is rich: sell both legs
+    strategy.on_market_data(make_md(0, 15500, 15510));
+    ASSERT_GT(strategy.z_score(), 2.0);
+    auto entry = strategy.generate_orders();
+    ASSERT_EQ(entry.size(), 2u);
+    EXPECT_EQ(entry[0].side, Side::Sell);
+    EXPECT_EQ(entry[1].instrument, 1u);
+    EXPECT_EQ(entry[1].side, Side::Sell);
+    EXPECT_EQ(entry[1].quantity, 5u);
+
+    for (const auto& order : entry) {
+        ExecutionReport fill{};
+        fill.instrument = order.instrument;
+        fill.side = order.side;
+        fill.status = OrderStatus::Filled;
+        fill.filled_quantity = order.quantity;
+        strategy.on_execution_report(fill);
+    }
+
+    // Flattening buys back both
+    std::span<const OrderRequest> exit;
+    for (int i = 0; i < 200 && exit.empty(); ++i) {
+        strategy.on_market_data(make_md(0, 15000, 15010));
+        exit = strategy.generate_orders();
+    }
+    ASSERT_EQ(exit.size(), 2u);
+    EXPECT_EQ(exit[0].side, Side::Buy);
+    EXPECT_EQ(exit[1].side, Side::Buy);
+    EXPECT_EQ(exit[1].quantity, 5u);
+}
+
+TEST_F(PairsTradingTest, NoEntryWhenHedgeRatioLeavesWarmUp) {
+    params_.min_hedge_samples = 50;
+    params_.entry_z_threshold = 3.0;    // Above the wave's own swings
+    PairsTradingStrategy strategy(params_);
+
+    // A tracks a third of B's moves; the initial ratio of 1.0 is far off, so
+    // the ratio steps when the estimator leaves warm-up
+    static constexpr Price WAVE[] = {0, 30, 45, 30, 0, -30, -45, -30};
+    for (int i = 0; i < 300; ++i) {
+        Price b = 28200 + 3 * WAVE[i % 8];
+        Price a = 5000 + b / 3;
+        strategy.on_market_data(make_md(1, b - 1, b + 1));
+        strategy.on_market_data(make_md(0, a - 1, a + 1));
+        EXPECT_TRUE(strategy.generate_orders().empty()) << "tick " << i << ", z " << strategy.z_score();
+    }
+    EXPECT_LT(strategy.hedge_ratio(), 0.5);     // Retuned once warm
+}
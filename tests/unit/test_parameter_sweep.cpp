@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "backtest/parameter_sweep.hpp"
+#include "backtest/replay_dataset.hpp"
+#include "strategy/strategy_set.hpp"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+
+std::vector<MarketDataMessage> make_session(size_t n) {
+    std::vector<MarketDataMessage> events;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> step(-3, 3);
+    std::array<Price, 2> mids{15000, 28000};
+    Timestamp t = 1'000'000'000;
+    for (size_t i = 0; i < n; ++i) {
+        InstrumentId inst = static_cast<InstrumentId>(i % 2);
+        mids[inst] += step(rng);
+        t += 1000;
+        MarketDataMessage md{};
+        md.instrument = inst;
+        md.bid_price = mids[inst] - 2;
+        md.ask_price = mids[inst] + 2;
+        md.bid_quantity = 100;
+        md.ask_quantity = 100;
+        md.last_price = mids[inst] + step(rng);
+        md.last_quantity = 20;
+        md.timestamp = t;
+        md.msg_type = 'W';
+        events.push_back(md);
+    }
+    return events;
+}
+
+} // namespace
+
+TEST(ParameterSweepTest, SetParameterByKey) {
+    SystemConfig config = default_config();
+    EXPECT_TRUE(set_sweep_parameter(config, "pairs_entry_z", 1.5));
+    EXPECT_DOUBLE_EQ(config.pairs_entry_z, 1.5);
+    EXPECT_TRUE(set_sweep_parameter(config, "momentum_fast_window", 7.0));
+    EXPECT_EQ(config.momentum_fast_window, 7);
+    EXPECT_FALSE(set_sweep_parameter(config, "execution_core", 3.0));
+}
+
+TEST(ParameterSweepTest, SweptParametersReachStrategies) {
+    SystemConfig config = default_config();
+    set_sweep_parameter(config, "market_maker_spread_bps", 12.0);
+    set_sweep_parameter(config, "pairs_exit_z", 0.25);
+    set_sweep_parameter(config, "momentum_slow_window", 40.0);
+    EXPECT_DOUBLE_EQ(market_maker_params(config).base_spread_bps, 12.0);
+    EXPECT_DOUBLE_EQ(pairs_params(config).exit_z_threshold, 0.25);
+    EXPECT_EQ(momentum_params(config).slow_window, 40);
+}
+
+TEST(ParameterSweepTest, GridDecoding) {
+    ParameterSweep sweep(default_config(), BacktestConfig{});
+    EXPECT_EQ(sweep.point_count(), 1u);
+    ASSERT_TRUE(sweep.add_axis("market_maker_spread_bps", {5.0, 10.0}));
+    ASSERT_TRUE(sweep.add_axis("momentum_fast_window", {5.0, 8.0, 12.0}));
+    EXPECT_FALSE(sweep.add_axis("not_a_key", {1.0}));
+    EXPECT_FALSE(sweep.add_axis("pairs_entry_z", {}));
+
+    EXPECT_EQ(sweep.point_count(), 6u);
+    auto values = sweep.point_values(4); // (1, 1): last axis varies fastest
+    EXPECT_DOUBLE_EQ(values[0], 10.0);
+    EXPECT_DOUBLE_EQ(values[1], 8.0);
+    SystemConfig config = sweep.point_config(4);
+    EXPECT_DOUBLE_EQ(config.market_maker_spread_bps, 10.0);
+    EXPECT_EQ(config.momentum_fast_window, 8);
+}
+
+TEST(ParameterSweepTest, ThreadCountDoesNotChangeResults) {
+    auto events = make_session(20000);
+
+    auto run = [&](size_t threads) {
+        ParameterSweep sweep(default_config(), BacktestConfig{});
+        sweep.add_axis("market_maker_spread_bps", {2.0, 5.0, 10.0});
+        sweep.add_axis("pairs_entry_z", {1.0, 2.0});
+        return sweep.run(events, threads);
+    };
+
+    auto serial = run(1);
+    auto parallel = run(4);
+    ASSERT_EQ(serial.size(), 6u);
+    ASSERT_EQ(parallel.size(), 6u);
+    for (size_t p = 0; p < serial.size(); ++p) {
+        EXPECT_EQ(serial[p].events, events.size());
+        EXPECT_EQ(serial[p].orders_sent, parallel[p].orders_sent);
+        EXPECT_EQ(serial[p].fills, parallel[p].fills);
+        EXPECT_DOUBLE_EQ(serial[p].total_pnl, parallel[p].total_pnl);
+    }
+}
+
+TEST(ParameterSweepTest, WritesCsv) {
+    auto events = make_session(1000);
+    ParameterSweep sweep(default_config(), BacktestConfig{});
+    sweep.add_axis("momentum_breakout_bps", {1.0, 2.0, 3.0});
+    sweep.run(events, 2);
+
+    const char* path = "test_parameter_sweep.csv";
+    ASSERT_TRUE(sweep.write_csv(path));
+    std::ifstream in(path);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(in, line)) lines.push_back(line);
+    std::remove(path);
+
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0].rfind("momentum_breakout_bps,events,", 0), 0u);
+    EXPECT_EQ(lines[2].rfind("2,1000,", 0), 0u);
+}
+
+TEST(ReplayDatasetTest, WriteAndMap) {
+    auto events = make_session(500);
+    const char* path = "test_replay_dataset.bin";
+    ASSERT_TRUE(ReplayDataset::write(path, events));
+
+    ReplayDataset dataset;
+    ASSERT_TRUE(dataset.open(path));
+    ASSERT_EQ(dataset.size(), events.size());
+    EXPECT_EQ(dataset.events()[123].timestamp, events[123].timestamp);
+    EXPECT_EQ(dataset.events()[499].bid_price, events[499].bid_price);
+
+    ReplayDataset moved = std::move(dataset);
+    EXPECT_FALSE(dataset.is_open());
+    EXPECT_TRUE(moved.is_open());
+    moved.close();
+    std::remove(path);
+}
+
+TEST(ReplayDatasetTest, RejectsForeignFile) {
+    const char* path = "test_replay_dataset.txt";
+    {
+        std::ofstream out(path);
+        out << "timestamp,instrument,bid,ask,bid_qty,ask_qty,last,last_qty\n";
+    }
+    ReplayDataset dataset;
+    EXPECT_FALSE(dataset.open(path));
+    EXPECT_FALSE(dataset.open("does_not_exist.bin"));
+    std::remove(path);
+}
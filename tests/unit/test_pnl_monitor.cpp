@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "monitoring/pnl_monitor.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace trading;
+
+TEST(PnlMonitorTest, PublishedTotalsAreReadBack) {
+    KillSwitch halts;
+    PnlMonitor monitor(halts, 2.0);
+    PositionTracker positions;
+    positions.on_fill(0, Side::Buy, 100, 15000);
+    positions.update_mark_price(0, 15100);
+
+    monitor.publish(positions, 123);
+    PnlMonitor::Snapshot snap = monitor.snapshot();
+    EXPECT_EQ(snap.unrealized_pnl, positions.unrealized_pnl_scaled());
+    EXPECT_EQ(snap.realized_pnl, 0);
+    EXPECT_EQ(snap.total_absolute_position, 100);
+    EXPECT_EQ(snap.timestamp, 123u);
+}
+
+TEST(PnlMonitorTest, DrawdownFiresGlobalHalt) {
+    KillSwitch halts;
+    PnlMonitor monitor(halts, 2.0);
+    PositionTracker positions;
+    positions.on_fill(0, Side::Buy, 100, 10000);
+
+    positions.update_mark_price(0, 20000);      // +$10,000
+    monitor.publish(positions, 1);
+    EXPECT_FALSE(monitor.evaluate());
+    EXPECT_DOUBLE_EQ(monitor.peak_pnl(), 10000.0);
+
+    positions.update_mark_price(0, 19900);      // -1% of peak
+    monitor.publish(positions, 2);
+    EXPECT_FALSE(monitor.evaluate());
+    EXPECT_FALSE(halts.global());
+
+    positions.update_mark_price(0, 19700);      // -3% of peak
+    monitor.publish(positions, 3);
+    EXPECT_TRUE(monitor.evaluate());
+    EXPECT_TRUE(halts.global());
+    EXPECT_NEAR(monitor.max_drawdown(), 0.03, 1e-9);
+}
+
+TEST(PnlMonitorTest, UnchangedSnapshotIsNotReevaluated) {
+    KillSwitch halts;
+    PnlMonitor monitor(halts, 2.0);
+    PositionTracker positions;
+    monitor.publish(positions, 1);
+    monitor.evaluate();
+    monitor.evaluate();
+    EXPECT_EQ(monitor.evaluations(), 1u);
+}
+
+TEST(PnlMonitorTest, MonitorThreadHaltsOnDrawdown) {
+    KillSwitch halts;
+    PnlMonitor monitor(halts, 2.0);
+    PositionTracker positions;
+    positions.on_fill(0, Side::Buy, 100, 10000);
+    positions.update_mark_price(0, 20000);
+    monitor.publish(positions, 1);
+
+    monitor.start(0, std::chrono::microseconds(100));
+    while (monitor.evaluations() == 0) std::this_thread::yield();
+    positions.update_mark_price(0, 15000);
+    monitor.publish(positions, 2);
+    for (int i = 0; i < 5000 && !halts.global(); ++i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    monitor.stop();
+    EXPECT_TRUE(halts.global());
+}
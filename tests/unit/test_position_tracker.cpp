@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "risk/position_tracker.hpp"
+#include <array>
+#include <random>
 
 using namespace trading;
 
@@ -72,3 +74,105 @@ TEST(PositionTrackerTest, ShortCover) {
     // P&L = 100 * (151.00 - 150.00) = $100 profit on short
     EXPECT_NEAR(tracker.realized_pnl(), 100.0, 0.01);
 }
+
+TEST(PositionTrackerTest, CapitalUsesAverageUntilMarked) {
+    PositionTracker tracker;
+    tracker.on_fill(0, Side::Buy, 100, 15000);
+    EXPECT_EQ(tracker.gross_notional(), 0);
+    EXPECT_NEAR(tracker.capital_used(), 15000.0, 0.01);
+
+    tracker.update_mark_price(0, 16000);
+    EXPECT_EQ(tracker.gross_notional(), 100 * 16000);
+    EXPECT_NEAR(tracker.capital_used(), 16000.0, 0.01);
+
+    tracker.on_fill(0, Side::Sell, 100, 16000);
+    EXPECT_EQ(tracker.gross_notional(), 0);
+    EXPECT_EQ(tracker.total_absolute_position(), 0);
+    EXPECT_EQ(tracker.capital_used(), 0.0);
+}
+
+TEST(PositionTrackerTest, IncrementalAggregatesMatchRecomputation) {
+    PositionTracker tracker;
+    std::array<Price, 16> marks{};
+    std::mt19937 rng(7);
+    for (int step = 0; step < 20000; ++step) {
+        InstrumentId instrument = rng() % 16;
+        if (rng() % 4 == 0) {
+            marks[instrument] = 9000 + static_cast<Price>(rng() % 2000);
+            tracker.update_mark_price(instrument, marks[instrument]);
+        } else {
+            Side side = (rng() & 1) ? Side::Buy : Side::Sell;
+            tracker.on_fill(instrument, side, 1 + rng() % 50, 9000 + static_cast<Price>(rng() % 2000));
+        }
+    }
+
+    int64_t total = 0;
+    int64_t notional = 0;
+    for (InstrumentId i = 0; i < 16; ++i) {
+        ASSERT_GT(marks[i], 0);
+        total += std::abs(tracker.position(i));
+        notional += std::abs(tracker.position(i)) * marks[i];
+    }
+    EXPECT_EQ(tracker.total_absolute_position(), total);
+    EXPECT_EQ(tracker.gross_notional(), notional);
+    // Every instrument is marked, so capital is exactly the notional
+    EXPECT_DOUBLE_EQ(tracker.capital_used(), static_cast<double>(notional) / PRICE_SCALE);
+
+    tracker.reset();
+    EXPECT_EQ(tracker.total_absolute_position(), 0);
+    EXPECT_EQ(tracker.gross_notional(), 0);
+    EXPECT_EQ(tracker.capital_used(), 0.0);
+}
+
+TEST(PositionTrackerTest, FlipOpensAtFillPrice) {
+    PositionTracker tracker;
+    tracker.on_fill(0, Side::Buy, 100, 15000);
+    tracker.on_fill(0, Side::Sell, 150, 15100);  // Close 100, open 50 short
+    EXPECT_EQ(tracker.position(0), -50);
+    EXPECT_EQ(tracker.realized_pnl_scaled(), 100 * 100);
+    EXPECT_EQ(tracker.cost_basis(0), -50 * 15100);
+    EXPECT_NEAR(tracker.avg_price(0), 151.0, 1e-9);
+}
+
+TEST(PositionTrackerTest, PartialReducesRealizeExactlyOverRoundTrip) {
+    PositionTracker tracker;
+    // Average cost 150.01 + 1/3 cent: not representable in cents
+    tracker.on_fill(0, Side::Buy, 1, 15001);
+    tracker.on_fill(0, Side::Buy, 1, 15001);
+    tracker.on_fill(0, Side::Buy, 1, 15002);
+    tracker.on_fill(0, Side::Sell, 1, 15010);
+    tracker.on_fill(0, Side::Sell, 1, 15010);
+    tracker.on_fill(0, Side::Sell, 1, 15010);
+
+    // Proceeds - cost = 3 * 15010 - (15001 + 15001 + 15002), whatever the split
+    EXPECT_EQ(tracker.position(0), 0);
+    EXPECT_EQ(tracker.cost_basis(0), 0);
+    EXPECT_EQ(tracker.realized_pnl_scaled(), 3 * 15010 - (15001 + 15001 + 15002));
+}
+
+TEST(PositionTrackerTest, PnlDoesNotDriftOverManyFills) {
+    PositionTracker tracker;
+    // One cent per share on 3 shares, a million times: exactly $30,000.00
+    for (int i = 0; i < 1'000'000; ++i) {
+        tracker.on_fill(0, Side::Buy, 3, 15001);
+        tracker.on_fill(0, Side::Sell, 3, 15002);
+    }
+    EXPECT_EQ(tracker.realized_pnl_scaled(), 3'000'000);
+    EXPECT_EQ(tracker.realized_pnl(), 30000.0);
+}
+
+TEST(PositionTrackerTest, UnrealizedFollowsMarksIncrementally) {
+    PositionTracker tracker;
+    tracker.on_fill(0, Side::Buy, 100, 15000);
+    tracker.on_fill(1, Side::Sell, 10, 28000);
+    EXPECT_EQ(tracker.unrealized_pnl_scaled(), 0);   // Unmarked
+
+    tracker.update_mark_price(0, 15050);
+    tracker.update_mark_price(1, 27900);
+    EXPECT_EQ(tracker.unrealized_pnl_scaled(), 100 * 50 + 10 * 100);
+
+    tracker.on_fill(0, Side::Sell, 40, 15050);       // Realize part at the mark
+    EXPECT_EQ(tracker.realized_pnl_scaled(), 40 * 50);
+    EXPECT_EQ(tracker.unrealized_pnl_scaled(), 60 * 50 + 10 * 100);
+    EXPECT_NEAR(tracker.total_pnl(), 60.0, 1e-9);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "strategy/quote_manager.hpp"
+
+using namespace trading;
+
+class QuoteManagerTest : public ::testing::Test {
+protected:
+    QuoteManager::Params params_;
+    void SetUp() override {
+        params_.price_tolerance = 2;
+        params_.size_tolerance = 0;
+        params_.min_update_interval_ns = 1000;
+    }
+
+    ExecutionReport make_report(OrderId id, Side side, OrderStatus status, Quantity leaves = 0) {
+        ExecutionReport report{};
+        report.order_id = id;
+        report.instrument = 0;
+        report.side = side;
+        report.status = status;
+        report.leaves_quantity = leaves;
+        return report;
+    }
+};
+
+TEST_F(QuoteManagerTest, NewWhenNoLiveQuote) {
+    QuoteManager qm(params_);
+    EXPECT_EQ(qm.evaluate(0, Side::Buy, 15000, 10, 0), QuoteManager::Action::New);
+    EXPECT_FALSE(qm.quote(0, Side::Buy).live);
+}
+
+TEST_F(QuoteManagerTest, WithinToleranceNoAction) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Buy, 1, 15000, 10, 0);
+
+    EXPECT_EQ(qm.evaluate(0, Side::Buy, 15002, 10, 5000), QuoteManager::Action::None);
+    EXPECT_EQ(qm.evaluate(0, Side::Buy, 14998, 10, 5000), QuoteManager::Action::None);
+}
+
+TEST_F(QuoteManagerTest, PriceDriftReplaces) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Sell, 1, 15010, 10, 0);
+    EXPECT_EQ(qm.evaluate(0, Side::Sell, 15013, 10, 5000), QuoteManager::Action::Replace);
+}
+
+TEST_F(QuoteManagerTest, SizeDriftReplaces) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Buy, 1, 15000, 10, 0);
+    EXPECT_EQ(qm.evaluate(0, Side::Buy, 15000, 20, 5000), QuoteManager::Action::Replace);
+}
+
+TEST_F(QuoteManagerTest, RateShaping) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Buy, 1, 15000, 10, 10000);
+
+    // Large move but inside the min update interval
+    EXPECT_EQ(qm.evaluate(0, Side::Buy, 15100, 10, 10500), QuoteManager::Action::None);
+    EXPECT_EQ(qm.evaluate(0, Side::Buy, 15100, 10, 11000), QuoteManager::Action::Replace);
+}
+
+TEST_F(QuoteManagerTest, FillClearsQuote) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Buy, 7, 15000, 10, 0);
+    qm.on_execution_report(make_report(7, Side::Buy, OrderStatus::Filled));
+    EXPECT_FALSE(qm.quote(0, Side::Buy).live);
+    EXPECT_EQ(qm.evaluate(0, Side::Buy, 15000, 10, 0), QuoteManager::Action::New);
+}
+
+TEST_F(QuoteManagerTest, PartialFillTracksLeaves) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Sell, 7, 15010, 10, 0);
+    qm.on_execution_report(make_report(7, Side::Sell, OrderStatus::PartiallyFilled, 4));
+
+    EXPECT_TRUE(qm.quote(0, Side::Sell).live);
+    EXPECT_EQ(qm.quote(0, Side::Sell).quantity, 4u);
+    EXPECT_EQ(qm.evaluate(0, Side::Sell, 15010, 10, 5000), QuoteManager::Action::Replace);
+}
+
+TEST_F(QuoteManagerTest, StaleReportIgnored) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Buy, 7, 15000, 10, 0);
+    qm.on_quote_sent(0, Side::Buy, 8, 15010, 10, 5000); // Replaced 7 with 8
+
+    qm.on_execution_report(make_report(7, Side::Buy, OrderStatus::Rejected));
+    EXPECT_TRUE(qm.quote(0, Side::Buy).live);
+    EXPECT_EQ(qm.quote(0, Side::Buy).order_id, 8u);
+}
+
+TEST_F(QuoteManagerTest, CancelSent) {
+    QuoteManager qm(params_);
+    qm.on_quote_sent(0, Side::Buy, 7, 15000, 10, 0);
+    qm.on_cancel_sent(0, Side::Buy);
+    EXPECT_FALSE(qm.quote(0, Side::Buy).live);
+    EXPECT_EQ(qm.cancels_sent(), 1u);
+}
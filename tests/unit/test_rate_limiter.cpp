@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "risk/rate_limiter.hpp"
+
+using namespace trading;
+
+namespace {
+constexpr Timestamp MS = 1'000'000ULL;
+constexpr Timestamp T0 = 1'000'000'000ULL;
+}
+
+TEST(RateLimiterTest, UnlimitedByDefault) {
+    RateLimiter limiter;
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_TRUE(limiter.try_acquire(0, 0, T0));
+    }
+}
+
+TEST(RateLimiterTest, BurstThenSteadyRate) {
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Global, 1000, 10);  // 1 per ms, burst 10
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(limiter.try_acquire(0, 0, T0)) << i;
+    }
+    EXPECT_FALSE(limiter.try_acquire(0, 0, T0));
+
+    // One interval later exactly one more conforms
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0 + MS));
+    EXPECT_FALSE(limiter.try_acquire(0, 0, T0 + MS));
+
+    // After a quiet period the bucket is full again, but no fuller
+    int accepted = 0;
+    while (limiter.try_acquire(0, 0, T0 + 1000 * MS)) ++accepted;
+    EXPECT_EQ(accepted, 10);
+}
+
+TEST(RateLimiterTest, NoDoubleBurstAtWindowEdge) {
+    // A fixed one-second window lets 2x through around the boundary;
+    // GCRA allows the burst once, then only the steady rate
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Global, 100);
+
+    int accepted = 0;
+    for (Timestamp t = T0; t < T0 + 1000 * MS; t += MS) {
+        while (limiter.try_acquire(0, 0, t)) ++accepted;
+    }
+    // 100 up front + one per 10ms for the rest of the second
+    EXPECT_LE(accepted, 200);
+    EXPECT_GE(accepted, 199);
+
+    accepted = 0;
+    while (limiter.try_acquire(0, 0, T0 + 1000 * MS)) ++accepted;
+    EXPECT_LE(accepted, 1);
+}
+
+TEST(RateLimiterTest, InstrumentBucketsAreIndependent) {
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Instrument, 1000, 2);
+
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0));
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0));
+    EXPECT_FALSE(limiter.try_acquire(0, 0, T0));
+    EXPECT_TRUE(limiter.try_acquire(1, 0, T0));
+    EXPECT_TRUE(limiter.try_acquire(1, 0, T0));
+    EXPECT_FALSE(limiter.try_acquire(1, 0, T0));
+}
+
+TEST(RateLimiterTest, DeniedOrderChargesNoBucket) {
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Global, 1000, 3);
+    limiter.set_limit(RateLimiter::Scope::Exchange, 1000, 1);
+
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0));
+    // Exchange 0 is empty: the global bucket must not be charged for these
+    EXPECT_FALSE(limiter.try_acquire(0, 0, T0));
+    EXPECT_FALSE(limiter.try_acquire(0, 0, T0));
+    EXPECT_TRUE(limiter.try_acquire(0, 1, T0));
+    EXPECT_TRUE(limiter.try_acquire(0, 2, T0));
+    EXPECT_FALSE(limiter.try_acquire(0, 3, T0));   // Global burst of 3 used up
+}
+
+TEST(RateLimiterTest, ExchangeBucketChargedSeparately) {
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Global, 1000, 2);
+    limiter.set_limit(RateLimiter::Scope::Exchange, 1000, 1);
+
+    // Admission before routing: global and instrument only
+    EXPECT_TRUE(limiter.try_acquire(0, T0));
+    EXPECT_TRUE(limiter.exchange_conforms(3, T0));
+    EXPECT_TRUE(limiter.try_acquire_exchange(3, T0));
+    EXPECT_FALSE(limiter.exchange_conforms(3, T0));
+    EXPECT_FALSE(limiter.try_acquire_exchange(3, T0));
+    EXPECT_TRUE(limiter.try_acquire_exchange(4, T0));
+
+    EXPECT_TRUE(limiter.try_acquire(0, T0));
+    EXPECT_FALSE(limiter.try_acquire(0, T0));      // Global burst of 2 used up
+}
+
+TEST(RateLimiterTest, ResetAndDisable) {
+    RateLimiter limiter;
+    limiter.set_limit(RateLimiter::Scope::Global, 10, 1);
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0));
+    EXPECT_FALSE(limiter.try_acquire(0, 0, T0));
+
+    limiter.reset();
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0));
+
+    limiter.set_limit(RateLimiter::Scope::Global, 0);
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0));
+    EXPECT_TRUE(limiter.try_acquire(0, 0, T0));
+}
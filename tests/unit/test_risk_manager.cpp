@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 #include "risk/risk_manager.hpp"
+#include <array>
+#include <atomic>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
 
 using namespace trading;
 
@@ -116,3 +122,398 @@ TEST_F(RiskManagerTest, ChecksStats) {
 
     EXPECT_EQ(mgr.checks_performed(), 2u);
 }
+
+TEST_F(RiskManagerTest, BatchMatchesScalarVerdicts) {
+    RiskManager scalar(limits_);
+    RiskManager batch(limits_);
+    batch.update_market_price(0, 15000);
+
+    std::array<OrderRequest, 4> orders = {
+        make_order(10), make_order(600), make_order(10, 20000), make_order(10, 15100, Side::Sell)};
+    std::array<RiskCheckResult, 4> results{};
+
+    EXPECT_EQ(batch.check_orders(orders, results), 2u);
+    for (size_t i = 0; i < orders.size(); ++i) {
+        EXPECT_EQ(results[i], scalar.check_order(orders[i], 15000)) << "order " << i;
+    }
+    EXPECT_EQ(batch.checks_performed(), 4u);
+    EXPECT_EQ(batch.checks_rejected(), 2u);
+}
+
+namespace {
+
+using FullPipeline = RiskPipeline<risk_checks::KillSwitch, risk_checks::OrderSize, risk_checks::MaxNotional,
+                                  risk_checks::Position, risk_checks::Capital, risk_checks::Rate,
+                                  risk_checks::FatFinger, risk_checks::PriceCollar>;
+
+/// Random batches through check_orders_with<Pipeline> against check_order_with
+/// on each order in turn (approved orders sent before the next), from the
+/// same starting state. Returns how often each verdict came up.
+template<typename Pipeline>
+std::map<RiskCheckResult, int> batch_scalar_parity(const RiskLimits& limits, uint32_t seed) {
+    SimulatedClockScope clock(1'000'000'000);
+    RiskManager batched(limits);
+    RiskManager sequential(limits);
+    for (RiskManager* mgr : {&batched, &sequential}) {
+        for (InstrumentId instrument = 0; instrument < 8; ++instrument) {
+            mgr->update_market_price(instrument, 10000 + 1000 * static_cast<Price>(instrument));
+        }
+        mgr->update_market_price(7, 0);     // No reference: price checks skip
+        mgr->position_tracker().on_fill(1, Side::Buy, 300, 11000);
+        mgr->position_tracker().on_fill(2, Side::Sell, 200, 12000);
+        mgr->kill_switch().halt(HaltScope::Strategy, 3);
+        mgr->kill_switch().halt(HaltScope::Instrument, 5);
+    }
+
+    std::mt19937 rng(seed);
+    auto pick = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+    std::map<RiskCheckResult, int> seen;
+    OrderId next_id = 1;
+    std::vector<OrderRequest> orders;
+    std::vector<RiskCheckResult> results;
+
+    for (int round = 0; round < 40; ++round) {
+        orders.resize(static_cast<size_t>(pick(1, 150)));
+        for (OrderRequest& order : orders) {
+            order = OrderRequest{};
+            order.id = next_id++;
+            order.action = pick(0, 19) == 0 ? OrderAction::Cancel : OrderAction::New;
+            order.instrument = static_cast<InstrumentId>(pick(0, 7));
+            order.side = pick(0, 1) ? Side::Buy : Side::Sell;
+            order.type = OrderType::Limit;
+            const Price reference = 10000 + 1000 * static_cast<Price>(order.instrument);
+            order.price = reference + reference * pick(-30, 30) / 1000;
+            order.quantity = static_cast<Quantity>(pick(1, 600));
+            order.strategy = static_cast<StrategyId>(pick(0, 4));
+            order.exchange = static_cast<ExchangeId>(pick(0, 3));
+        }
+        results.assign(orders.size(), RiskCheckResult::Approved);
+
+        const size_t approved = batched.template check_orders_with<Pipeline>(orders, results);
+        size_t expected_approved = 0;
+        for (size_t i = 0; i < orders.size(); ++i) {
+            const OrderRequest& order = orders[i];
+            const RiskCheckResult expected =
+                sequential.template check_order_with<Pipeline>(order, sequential.market_price(order.instrument));
+            EXPECT_EQ(results[i], expected) << "round " << round << ", order " << i;
+            ++seen[expected];
+            if (expected == RiskCheckResult::Approved) {
+                ++expected_approved;
+                if (order.action != OrderAction::Cancel) sequential.on_order_sent(order);
+            }
+            if (results[i] == RiskCheckResult::Approved && order.action != OrderAction::Cancel) {
+                batched.on_order_sent(order);
+            }
+        }
+        EXPECT_EQ(approved, expected_approved);
+
+        // Between batches the first order of the round fills and the rest
+        // are cancelled; rate buckets refill
+        for (RiskManager* mgr : {&batched, &sequential}) {
+            bool first = true;
+            for (size_t i = 0; i < orders.size(); ++i) {
+                const OrderRequest& order = orders[i];
+                if (results[i] != RiskCheckResult::Approved || order.action == OrderAction::Cancel) continue;
+                ExecutionReport report{};
+                report.order_id = order.id;
+                report.instrument = order.instrument;
+                report.side = order.side;
+                report.status = first ? OrderStatus::Filled : OrderStatus::Cancelled;
+                report.quantity = order.quantity;
+                report.filled_quantity = first ? order.quantity : 0;
+                report.price = order.price;
+                mgr->on_execution_report(report);
+                if (first) mgr->position_tracker().on_fill(order.instrument, order.side, order.quantity, order.price);
+                first = false;
+            }
+        }
+        ThreadClock::advance(1'000'000'000);
+    }
+    EXPECT_EQ(batched.checks_rejected(), sequential.checks_rejected());
+    return seen;
+}
+
+} // namespace
+
+TEST_F(RiskManagerTest, BatchMatchesSequentialChecksOnRandomOrders) {
+    limits_.max_position_per_instrument = 2500;
+    limits_.max_total_position = 12000;
+    limits_.max_capital = 900'000.0;
+    limits_.max_orders_per_second = 400;
+    limits_.max_orders_per_second_per_instrument = 8;
+    limits_.max_orders_per_second_per_exchange = 30;
+    limits_.max_price_deviation_pct = 2.5;
+    limits_.max_order_notional = 60'000.0;
+    limits_.price_collar_bps = 150.0;
+
+    std::map<RiskCheckResult, int> seen;
+    for (uint32_t seed : {1u, 2u, 3u}) {
+        for (auto [result, count] : batch_scalar_parity<DefaultRiskPipeline>(limits_, seed)) seen[result] += count;
+        for (auto [result, count] : batch_scalar_parity<FullPipeline>(limits_, seed)) seen[result] += count;
+    }
+    // Every check got to reject something (the global switch is never thrown)
+    for (RiskCheckResult result : {RiskCheckResult::Approved, RiskCheckResult::PositionLimitBreached,
+                                   RiskCheckResult::CapitalLimitBreached, RiskCheckResult::OrderSizeTooLarge,
+                                   RiskCheckResult::OrderRateExceeded, RiskCheckResult::FatFingerPrice,
+                                   RiskCheckResult::TradingHalted, RiskCheckResult::NotionalTooLarge,
+                                   RiskCheckResult::OutsidePriceCollar}) {
+        EXPECT_GT(seen[result], 0) << "verdict " << static_cast<int>(result);
+    }
+}
+
+TEST_F(RiskManagerTest, BatchCountsEarlierOrdersAgainstPositionLimit) {
+    RiskManager mgr(limits_);
+    // Each order fits alone; working with the first two, the third would
+    // take the instrument past 1000
+    std::array<OrderRequest, 4> orders = {
+        make_order(400), make_order(400), make_order(400), make_order(400, 15000, Side::Sell)};
+    std::array<RiskCheckResult, 4> results{};
+
+    EXPECT_EQ(mgr.check_orders(orders, results), 3u);
+    EXPECT_EQ(results[0], RiskCheckResult::Approved);
+    EXPECT_EQ(results[1], RiskCheckResult::Approved);
+    EXPECT_EQ(results[2], RiskCheckResult::PositionLimitBreached);
+    EXPECT_EQ(results[3], RiskCheckResult::Approved);
+
+    // Pending deltas do not leak into the next batch
+    std::array<OrderRequest, 1> next = {make_order(400)};
+    std::array<RiskCheckResult, 1> next_result{};
+    EXPECT_EQ(mgr.check_orders(next, next_result), 1u);
+}
+
+TEST_F(RiskManagerTest, BatchCountsEarlierOrdersAgainstCapital) {
+    limits_.max_capital = 100'000.0;
+    RiskManager mgr(limits_);
+    // $60,000 each, on different instruments so only capital binds
+    OrderRequest a = make_order(400);
+    OrderRequest b = make_order(400);
+    b.instrument = 1;
+    std::array<OrderRequest, 2> orders = {a, b};
+    std::array<RiskCheckResult, 2> results{};
+
+    EXPECT_EQ(mgr.check_orders(orders, results), 1u);
+    EXPECT_EQ(results[0], RiskCheckResult::Approved);
+    EXPECT_EQ(results[1], RiskCheckResult::CapitalLimitBreached);
+}
+
+TEST_F(RiskManagerTest, BatchKillSwitchStillPassesCancels) {
+    RiskManager mgr(limits_);
+    mgr.activate_kill_switch();
+    OrderRequest cancel = make_order();
+    cancel.action = OrderAction::Cancel;
+    std::array<OrderRequest, 2> orders = {make_order(), cancel};
+    std::array<RiskCheckResult, 2> results{};
+
+    EXPECT_EQ(mgr.check_orders(orders, results), 1u);
+    EXPECT_EQ(results[0], RiskCheckResult::KillSwitchActive);
+    EXPECT_EQ(results[1], RiskCheckResult::Approved);
+}
+
+TEST_F(RiskManagerTest, BatchFatFingerUsesPerInstrumentReference) {
+    RiskManager mgr(limits_);
+    mgr.update_market_price(0, 15000);
+    mgr.update_market_price(1, 30000);
+    OrderRequest a = make_order(10, 30000);
+    OrderRequest b = make_order(10, 30000);
+    b.instrument = 1;
+    OrderRequest c = make_order(10, 99999);
+    c.instrument = 2;   // No reference price yet: not checked
+    std::array<OrderRequest, 3> orders = {a, b, c};
+    std::array<RiskCheckResult, 3> results{};
+
+    mgr.check_orders(orders, results);
+    EXPECT_EQ(results[0], RiskCheckResult::FatFingerPrice);
+    EXPECT_EQ(results[1], RiskCheckResult::Approved);
+    EXPECT_EQ(results[2], RiskCheckResult::Approved);
+}
+
+TEST_F(RiskManagerTest, BatchSpansSeveralChunks) {
+    limits_.max_orders_per_second = 1'000'000;
+    RiskManager mgr(limits_);
+    mgr.update_market_price(0, 15000);
+
+    // 150 buys of 10 across chunk boundaries: the position limit (1000)
+    // is reached at order 100 and carries over into later chunks
+    std::vector<OrderRequest> orders(150, make_order(10));
+    std::vector<RiskCheckResult> results(orders.size());
+
+    EXPECT_EQ(mgr.check_orders(orders, results), 100u);
+    EXPECT_EQ(results[99], RiskCheckResult::Approved);
+    EXPECT_EQ(results[100], RiskCheckResult::PositionLimitBreached);
+    EXPECT_EQ(results[149], RiskCheckResult::PositionLimitBreached);
+}
+
+TEST_F(RiskManagerTest, WorkingOrdersCountAgainstPositionLimit) {
+    RiskManager mgr(limits_);
+    // Resting orders of 400 each pass alone; the third would breach 1000 if all filled
+    for (OrderId id = 1; id <= 2; ++id) {
+        auto req = make_order(400);
+        req.id = id;
+        ASSERT_EQ(mgr.check_order(req, 15000), RiskCheckResult::Approved);
+        mgr.on_order_sent(req);
+    }
+    auto third = make_order(400);
+    third.id = 3;
+    EXPECT_EQ(mgr.check_order(third, 15000), RiskCheckResult::PositionLimitBreached);
+
+    // Sells are checked against the short side: still fine
+    EXPECT_EQ(mgr.check_order(make_order(400, 15000, Side::Sell), 15000), RiskCheckResult::Approved);
+
+    // Once one is cancelled there is room again
+    ExecutionReport cancelled{};
+    cancelled.order_id = 1;
+    cancelled.instrument = 0;
+    cancelled.status = OrderStatus::Cancelled;
+    mgr.on_execution_report(cancelled);
+    EXPECT_EQ(mgr.check_order(third, 15000), RiskCheckResult::Approved);
+}
+
+TEST_F(RiskManagerTest, WorkingOrdersCountAgainstCapital) {
+    limits_.max_capital = 100'000.0;
+    RiskManager mgr(limits_);
+    auto first = make_order(400);   // $60,000
+    mgr.on_order_sent(first);
+
+    auto second = make_order(400);
+    second.id = 2;
+    second.instrument = 1;
+    EXPECT_EQ(mgr.check_order(second, 15000), RiskCheckResult::CapitalLimitBreached);
+}
+
+TEST_F(RiskManagerTest, BatchAddsToWorkingOrders) {
+    RiskManager mgr(limits_);
+    auto resting = make_order(800);
+    mgr.on_order_sent(resting);
+
+    std::array<OrderRequest, 2> orders = {make_order(200), make_order(10)};
+    std::array<RiskCheckResult, 2> results{};
+    EXPECT_EQ(mgr.check_orders(orders, results), 1u);
+    EXPECT_EQ(results[0], RiskCheckResult::Approved);
+    EXPECT_EQ(results[1], RiskCheckResult::PositionLimitBreached);
+}
+
+TEST_F(RiskManagerTest, SetLimitsTakesEffectOnNextCheck) {
+    RiskManager mgr(limits_);
+    EXPECT_EQ(mgr.check_order(make_order(400), 15000), RiskCheckResult::Approved);
+
+    RiskLimits tighter = limits_;
+    tighter.max_order_size = 300;
+    EXPECT_TRUE(mgr.set_limits(tighter));
+    EXPECT_EQ(mgr.limits().max_order_size, 300u);
+    EXPECT_EQ(mgr.check_order(make_order(400), 15000), RiskCheckResult::OrderSizeTooLarge);
+}
+
+TEST_F(RiskManagerTest, InvalidLimitsAreNotPublished) {
+    RiskManager mgr(limits_);
+    uint64_t version = mgr.limits_version();
+
+    RiskLimits bad = limits_;
+    bad.max_price_deviation_pct = 0.0;
+    EXPECT_EQ(mgr.publish_limits(bad), RiskManager::LimitsUpdate::Invalid);
+    bad = limits_;
+    bad.max_order_size = 0;
+    EXPECT_FALSE(mgr.set_limits(bad));
+
+    EXPECT_EQ(mgr.limits_version(), version);
+    EXPECT_EQ(mgr.limits().max_order_size, limits_.max_order_size);
+}
+
+TEST_F(RiskManagerTest, PublishWaitsForTradingThreadToPickUp) {
+    RiskManager mgr(limits_);
+    RiskLimits next = limits_;
+    next.max_order_size = 200;
+    EXPECT_EQ(mgr.publish_limits(next), RiskManager::LimitsUpdate::Published);
+
+    // The previous block may still be in use until a check adopts the new one
+    next.max_order_size = 100;
+    EXPECT_EQ(mgr.publish_limits(next), RiskManager::LimitsUpdate::Busy);
+    EXPECT_EQ(mgr.limits().max_order_size, 200u);
+
+    EXPECT_EQ(mgr.check_order(make_order(150), 15000), RiskCheckResult::Approved);
+    EXPECT_EQ(mgr.publish_limits(next), RiskManager::LimitsUpdate::Published);
+    EXPECT_EQ(mgr.check_order(make_order(150), 15000), RiskCheckResult::OrderSizeTooLarge);
+}
+
+TEST_F(RiskManagerTest, PublishedRateLimitReachesLimiter) {
+    limits_.max_orders_per_second = 1'000'000;
+    RiskManager mgr(limits_);
+    ThreadClock::use_simulated(1'000'000'000);
+
+    RiskLimits strict = limits_;
+    strict.max_orders_per_second = 2;
+    EXPECT_TRUE(mgr.set_limits(strict));
+    mgr.reset_rate_counter();
+    EXPECT_EQ(mgr.check_order(make_order(), 15000), RiskCheckResult::Approved);
+    EXPECT_EQ(mgr.check_order(make_order(), 15000), RiskCheckResult::Approved);
+    EXPECT_EQ(mgr.check_order(make_order(), 15000), RiskCheckResult::OrderRateExceeded);
+    ThreadClock::use_system();
+}
+
+TEST_F(RiskManagerTest, ConcurrentPublishSeesConsistentBlocks) {
+    // Each publish keeps max_order_size == max_position_per_instrument, so a
+    // torn read would show up as a position-limit rejection for an order of
+    // exactly max_order_size
+    limits_.max_orders_per_second = 0;
+    limits_.max_total_position = 1'000'000;
+    limits_.max_capital = 1e12;
+    limits_.max_order_size = 100;
+    limits_.max_position_per_instrument = 100;
+    RiskManager mgr(limits_);
+
+    std::atomic<bool> done{false};
+    std::thread publisher([&] {
+        RiskLimits next = limits_;
+        for (Quantity size = 100; !done.load(std::memory_order_relaxed);) {
+            next.max_order_size = size;
+            next.max_position_per_instrument = static_cast<int64_t>(size);
+            if (mgr.publish_limits(next) == RiskManager::LimitsUpdate::Published) {
+                size = size == 100 ? 200 : 100;
+            }
+        }
+    });
+
+    uint64_t mismatches = 0;
+    for (int i = 0; i < 200'000; ++i) {
+        Quantity size = (i & 1) ? 100 : 200;
+        RiskCheckResult result = mgr.check_order(make_order(size), 15000);
+        mismatches += result == RiskCheckResult::PositionLimitBreached;
+    }
+    done.store(true, std::memory_order_relaxed);
+    publisher.join();
+
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_GT(mgr.limits_version(), 1u);
+}
+
+TEST_F(RiskManagerTest, ScopedHaltBlocksOnlyItsScope) {
+    RiskManager mgr(limits_);
+    mgr.kill_switch().halt(HaltScope::Instrument, 1);
+    mgr.kill_switch().halt(HaltScope::Strategy, 2);
+
+    auto req = make_order();
+    EXPECT_EQ(mgr.check_order(req, 15000), RiskCheckResult::Approved);
+    req.instrument = 1;
+    EXPECT_EQ(mgr.check_order(req, 15000), RiskCheckResult::TradingHalted);
+    req.instrument = 0;
+    req.strategy = 2;
+    EXPECT_EQ(mgr.check_order(req, 15000), RiskCheckResult::TradingHalted);
+    EXPECT_FALSE(mgr.kill_switch_active());
+
+    // Global takes precedence in the reported reason
+    mgr.activate_kill_switch();
+    EXPECT_EQ(mgr.check_order(req, 15000), RiskCheckResult::KillSwitchActive);
+}
+
+TEST_F(RiskManagerTest, BatchHonoursScopedHalts) {
+    RiskManager mgr(limits_);
+    mgr.update_market_price(0, 15000);
+    mgr.kill_switch().halt(HaltScope::Exchange, 1);
+
+    std::array<OrderRequest, 3> orders{make_order(), make_order(), make_order()};
+    orders[1].exchange = 1;
+    std::array<RiskCheckResult, 3> results{};
+    EXPECT_EQ(mgr.check_orders(orders, results), 2u);
+    EXPECT_EQ(results[0], RiskCheckResult::Approved);
+    EXPECT_EQ(results[1], RiskCheckResult::TradingHalted);
+    EXPECT_EQ(results[2], RiskCheckResult::Approved);
+}
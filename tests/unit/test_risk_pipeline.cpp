@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "risk/risk_manager.hpp"
+
+using namespace trading;
+
+namespace {
+
+// A deployment-specific check, added without touching the built-in ones
+struct NoSellsOnInstrumentSeven {
+    static RiskCheckResult check(const RiskContext& ctx) noexcept {
+        return ctx.request.instrument == 7 && ctx.request.side == Side::Sell
+            ? RiskCheckResult::TradingHalted : RiskCheckResult::Approved;
+    }
+};
+
+} // namespace
+
+class RiskPipelineTest : public ::testing::Test {
+protected:
+    RiskLimits limits_;
+    void SetUp() override {
+        limits_.max_position_per_instrument = 1000;
+        limits_.max_total_position = 5000;
+        limits_.max_capital = 10'000.0;
+        limits_.max_order_size = 500;
+        limits_.max_orders_per_second = 0;
+        limits_.max_price_deviation_pct = 5.0;
+    }
+
+    OrderRequest make_order(Quantity qty = 10, Price price = 15000, Side side = Side::Buy) {
+        OrderRequest req{};
+        req.id = 1;
+        req.side = side;
+        req.type = OrderType::Limit;
+        req.price = price;
+        req.quantity = qty;
+        return req;
+    }
+};
+
+TEST_F(RiskPipelineTest, DefaultPipelineMatchesCheckOrder) {
+    RiskManager a(limits_);
+    RiskManager b(limits_);
+    for (Quantity qty : {10u, 100u, 600u}) {
+        for (Price price : {15000, 15500, 16000}) {
+            OrderRequest req = make_order(qty, price);
+            EXPECT_EQ(a.check_order(req, 15000), b.check_order_with<DefaultRiskPipeline>(req, 15000));
+        }
+    }
+}
+
+TEST_F(RiskPipelineTest, PipelineWithoutCapitalSkipsIt) {
+    using NoCapital = RiskPipeline<risk_checks::KillSwitch, risk_checks::OrderSize,
+                                   risk_checks::Position, risk_checks::Rate, risk_checks::FatFinger>;
+    RiskManager mgr(limits_);
+    OrderRequest req = make_order(100);     // $15,000 > $10,000 capital
+    EXPECT_EQ(mgr.check_order(req, 15000), RiskCheckResult::CapitalLimitBreached);
+    EXPECT_EQ(mgr.check_order_with<NoCapital>(req, 15000), RiskCheckResult::Approved);
+}
+
+TEST_F(RiskPipelineTest, OrderOfChecksSetsPrecedence) {
+    RiskManager mgr(limits_);
+    OrderRequest req = make_order(600, 20000);  // Too large and fat-fingered
+    using SizeFirst = RiskPipeline<risk_checks::OrderSize, risk_checks::FatFinger>;
+    using PriceFirst = RiskPipeline<risk_checks::FatFinger, risk_checks::OrderSize>;
+    EXPECT_EQ(mgr.check_order_with<SizeFirst>(req, 15000), RiskCheckResult::OrderSizeTooLarge);
+    EXPECT_EQ(mgr.check_order_with<PriceFirst>(req, 15000), RiskCheckResult::FatFingerPrice);
+}
+
+TEST_F(RiskPipelineTest, MaxNotional) {
+    limits_.max_order_notional = 1'000.0;
+    RiskManager mgr(limits_);
+    using Pipeline = RiskPipeline<risk_checks::MaxNotional>;
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(make_order(6, 15000), 15000), RiskCheckResult::Approved);
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(make_order(7, 15000), 15000), RiskCheckResult::NotionalTooLarge);
+
+    limits_.max_order_notional = 0.0;   // Off
+    RiskManager off(limits_);
+    EXPECT_EQ(off.check_order_with<Pipeline>(make_order(7, 15000), 15000), RiskCheckResult::Approved);
+}
+
+TEST_F(RiskPipelineTest, PriceCollarIsOneSided) {
+    limits_.price_collar_bps = 50.0;    // 0.5%: 75 cents on $150
+    RiskManager mgr(limits_);
+    using Pipeline = RiskPipeline<risk_checks::PriceCollar>;
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(make_order(10, 15075, Side::Buy), 15000), RiskCheckResult::Approved);
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(make_order(10, 15076, Side::Buy), 15000),
+              RiskCheckResult::OutsidePriceCollar);
+    // Passive prices are never collared
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(make_order(10, 14000, Side::Buy), 15000), RiskCheckResult::Approved);
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(make_order(10, 14924, Side::Sell), 15000),
+              RiskCheckResult::OutsidePriceCollar);
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(make_order(10, 16000, Side::Sell), 15000), RiskCheckResult::Approved);
+}
+
+TEST_F(RiskPipelineTest, CustomCheckAndStats) {
+    RiskManager mgr(limits_);
+    using Pipeline = RiskPipeline<risk_checks::KillSwitch, NoSellsOnInstrumentSeven, risk_checks::OrderSize>;
+    OrderRequest req = make_order(10, 15000, Side::Sell);
+    req.instrument = 7;
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(req, 15000), RiskCheckResult::TradingHalted);
+    req.side = Side::Buy;
+    EXPECT_EQ(mgr.check_order_with<Pipeline>(req, 15000), RiskCheckResult::Approved);
+    EXPECT_EQ(mgr.checks_performed(), 2u);
+    EXPECT_EQ(mgr.checks_rejected(), 1u);
+}
+
+TEST_F(RiskPipelineTest, CancelsBypassThePipeline) {
+    RiskManager mgr(limits_);
+    mgr.activate_kill_switch();
+    OrderRequest req = make_order();
+    req.action = OrderAction::Cancel;
+    EXPECT_EQ(mgr.check_order_with<RiskPipeline<risk_checks::KillSwitch>>(req, 15000), RiskCheckResult::Approved);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "containers/seqlock.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace trading;
+
+namespace {
+
+struct Payload {
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+    uint32_t d;     // Odd size: exercises the partial last word
+};
+
+} // namespace
+
+TEST(SeqLockTest, StartsWithValueInitialisedPayload) {
+    SeqLock<Payload> lock;
+    Payload p = lock.load();
+    EXPECT_EQ(p.a, 0u);
+    EXPECT_EQ(p.d, 0u);
+    EXPECT_EQ(lock.version(), 0u);
+}
+
+TEST(SeqLockTest, StoreThenLoad) {
+    SeqLock<Payload> lock;
+    lock.store({1, 2, 3, 4});
+    Payload p{};
+    ASSERT_TRUE(lock.try_load(p));
+    EXPECT_EQ(p.a, 1u);
+    EXPECT_EQ(p.b, 2u);
+    EXPECT_EQ(p.c, 3u);
+    EXPECT_EQ(p.d, 4u);
+    EXPECT_EQ(lock.version(), 1u);
+}
+
+TEST(SeqLockTest, ReaderNeverSeesTornWrite) {
+    // Every write keeps all fields equal; a torn read would mix two writes
+    SeqLock<Payload> lock;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= 200'000; ++i) {
+            lock.store({i, i, i, static_cast<uint32_t>(i)});
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint64_t torn = 0;
+    uint64_t last = 0;
+    uint64_t backwards = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        Payload p = lock.load();
+        torn += !(p.a == p.b && p.b == p.c && static_cast<uint32_t>(p.a) == p.d);
+        backwards += p.a < last;
+        last = p.a;
+    }
+    writer.join();
+
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(backwards, 0u);
+    EXPECT_EQ(lock.load().a, 200'000u);
+}
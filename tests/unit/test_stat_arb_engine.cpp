@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "strategy/stat_arb_engine.hpp"
+
+using namespace trading;
+
+class StatArbEngineTest : public ::testing::Test {
+protected:
+    StatArbEngine::Params params_;
+    void SetUp() override {
+        params_.lookback_window = 100;
+        params_.entry_z_threshold = 2.0;
+        params_.exit_z_threshold = 0.5;
+        params_.order_size = 10;
+    }
+
+    MarketDataMessage make_md(InstrumentId inst, Price bid, Price ask) {
+        MarketDataMessage md{};
+        md.instrument = inst;
+        md.bid_price = bid;
+        md.ask_price = ask;
+        md.bid_quantity = 100;
+        md.ask_quantity = 100;
+        md.timestamp = now_ns();
+        md.msg_type = 'W';
+        return md;
+    }
+};
+
+TEST_F(StatArbEngineTest, RejectsInvalidPairs) {
+    StatArbEngine engine(params_);
+    EXPECT_EQ(engine.add_pair({0, 0, 1.0}), -1);
+    EXPECT_EQ(engine.add_pair({0, MAX_INSTRUMENTS, 1.0}), -1);
+    EXPECT_EQ(engine.add_pair({0, 1, 1.0}), 0);
+    engine.finalize();
+    EXPECT_EQ(engine.add_pair({1, 2, 1.0}), -1); // Index already built
+}
+
+TEST_F(StatArbEngineTest, OnlyAffectedPairsTouched) {
+    StatArbEngine engine(params_);
+    engine.add_pair({0, 1, 1.0});
+    engine.add_pair({0, 2, 1.0});
+    engine.add_pair({3, 4, 1.0});
+    engine.finalize();
+
+    engine.on_market_data(make_md(0, 15000, 15010));
+    EXPECT_EQ(engine.pairs_touched_last_tick(), 2u);
+
+    engine.on_market_data(make_md(4, 15000, 15010));
+    EXPECT_EQ(engine.pairs_touched_last_tick(), 1u);
+
+    engine.on_market_data(make_md(9, 15000, 15010));
+    EXPECT_EQ(engine.pairs_touched_last_tick(), 0u);
+    EXPECT_EQ(engine.mid(9), 15005);
+}
+
+TEST_F(StatArbEngineTest, NoSignalOnNoise) {
+    StatArbEngine engine(params_);
+    engine.add_pair({0, 1, 1.0});
+    engine.finalize();
+
+    for (int i = 0; i < 50; ++i) {
+        engine.on_market_data(make_md(0, 15000, 15010));
+        engine.on_market_data(make_md(1, 15000, 15010));
+    }
+
+    EXPECT_TRUE(engine.generate_orders().empty());
+    EXPECT_NEAR(engine.z_score(0), 0.0, 1e-9);
+}
+
+TEST_F(StatArbEngineTest, DivergenceEntryAndExit) {
+    StatArbEngine engine(params_);
+    engine.add_pair({0, 1, 1.0});
+    engine.add_pair({2, 3, 1.0}); // Untouched pair stays flat
+    engine.finalize();
+
+    for (int i = 0; i < 30; ++i) {
+        engine.on_market_data(make_md(0, 15000 + (i % 3), 15010 + (i % 3)));
+        engine.on_market_data(make_md(1, 15000, 15010));
+        engine.generate_orders();
+    }
+
+    // A jumps relative to B: spread rich → sell A, buy B
+    engine.on_market_data(make_md(0, 15500, 15510));
+    EXPECT_GT(engine.z_score(0), 2.0);
+    auto entry = engine.generate_orders();
+    ASSERT_EQ(entry.size(), 2u);
+    EXPECT_EQ(entry[0].instrument, 0u);
+    EXPECT_EQ(entry[0].side, Side::Sell);
+    EXPECT_EQ(entry[1].instrument, 1u);
+    EXPECT_EQ(entry[1].side, Side::Buy);
+    EXPECT_EQ(engine.pair_state(0), -1);
+    EXPECT_EQ(engine.pair_state(1), 0);
+
+    // Converge back until the exit threshold is crossed
+    std::span<const OrderRequest> exit;
+    for (int i = 0; i < 200 && exit.empty(); ++i) {
+        engine.on_market_data(make_md(0, 15000, 15010));
+        exit = engine.generate_orders();
+    }
+    ASSERT_EQ(exit.size(), 2u);
+    EXPECT_EQ(exit[0].side, Side::Buy);
+    EXPECT_EQ(exit[1].side, Side::Sell);
+    EXPECT_EQ(engine.pair_state(0), 0);
+}
+
+TEST_F(StatArbEngineTest, NegativeHedgeRatioTradesLegsTogether) {
+    StatArbEngine engine(params_);
+    engine.add_pair({0, 1, -0.5});
+    engine.finalize();
+
+    for (int i = 0; i < 30; ++i) {
+        engine.on_market_data(make_md(0, 15000 + (i % 3), 15010 + (i % 3)));
+        engine.on_market_data(make_md(1, 15000, 15010));
+        engine.generate_orders();
+    }
+
+    // Spread A + 0.5*B is rich: sell both legs
+    engine.on_market_data(make_md(0, 15500, 15510));
+    auto entry = engine.generate_orders();
+    ASSERT_EQ(entry.size(), 2u);
+    EXPECT_EQ(entry[0].side, Side::Sell);
+    EXPECT_EQ(entry[1].side, Side::Sell);
+    EXPECT_EQ(entry[1].quantity, 5u);
+
+    std::span<const OrderRequest> exit;
+    for (int i = 0; i < 200 && exit.empty(); ++i) {
+        engine.on_market_data(make_md(0, 15000, 15010));
+        exit = engine.generate_orders();
+    }
+    ASSERT_EQ(exit.size(), 2u);
+    EXPECT_EQ(exit[0].side, Side::Buy);
+    EXPECT_EQ(exit[1].side, Side::Buy);
+}
+
+TEST_F(StatArbEngineTest, ManyPairsShareInstrument) {
+    StatArbEngine engine(params_);
+    for (InstrumentId b = 1; b < 201; ++b) {
+        ASSERT_GE(engine.add_pair({0, b, 1.0}), 0);
+    }
+    engine.finalize();
+    EXPECT_EQ(engine.pair_count(), 200u);
+
+    for (InstrumentId b = 1; b < 201; ++b) {
+        engine.on_market_data(make_md(b, 15000, 15010));
+    }
+    engine.generate_orders();
+
+    engine.on_market_data(make_md(0, 15000, 15010));
+    EXPECT_EQ(engine.pairs_touched_last_tick(), 200u);
+    EXPECT_EQ(engine.pending_pairs(), 200u);
+    engine.generate_orders();
+    EXPECT_EQ(engine.pending_pairs(), 0u);
+}
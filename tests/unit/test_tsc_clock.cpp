@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "common/clock.hpp"
+#include <thread>
+
+using namespace trading;
+
+// Calibration is process-wide; the uncalibrated case has to run first.
+TEST(TscClockTest, UncalibratedFallsBackToMonotonicClock) {
+    ASSERT_FALSE(TscClock::calibrated());
+    EXPECT_FALSE(ThreadClock::use_tsc());
+    EXPECT_EQ(ThreadClock::mode(), ThreadClock::Mode::System);
+    EXPECT_EQ(TscClock::cycles_to_ns(12345), 12345u);
+
+    Timestamp a = now_ns();
+    Timestamp b = TscClock::now();
+    EXPECT_LE(a, b);
+}
+
+TEST(TscClockTest, CalibrateMatchesMonotonicClock) {
+    if (!TscClock::calibrate()) GTEST_SKIP() << "No invariant TSC";
+    EXPECT_TRUE(TscClock::calibrated());
+    EXPECT_GT(TscClock::ghz(), 0.1);
+    EXPECT_LT(TscClock::ghz(), 10.0);
+
+    // Both clocks share the CLOCK_MONOTONIC timeline
+    Timestamp tsc = TscClock::now();
+    Timestamp sys = now_ns();
+    int64_t skew = static_cast<int64_t>(sys) - static_cast<int64_t>(tsc);
+    EXPECT_LT(std::abs(skew), 1'000'000);
+}
+
+TEST(TscClockTest, NowIsMonotonic) {
+    if (!TscClock::calibrate()) GTEST_SKIP() << "No invariant TSC";
+    Timestamp prev = TscClock::now();
+    for (int i = 0; i < 10000; ++i) {
+        Timestamp t = TscClock::now();
+        ASSERT_GE(t, prev);
+        prev = t;
+    }
+}
+
+TEST(TscClockTest, CyclesConvertToElapsedTime) {
+    if (!TscClock::calibrate()) GTEST_SKIP() << "No invariant TSC";
+    uint64_t c0 = TscClock::start();
+    Timestamp n0 = now_ns();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t c1 = TscClock::stop();
+    Timestamp n1 = now_ns();
+
+    double measured = static_cast<double>(TscClock::cycles_to_ns(c1 - c0));
+    double expected = static_cast<double>(n1 - n0);
+    EXPECT_NEAR(measured / expected, 1.0, 0.05);
+}
+
+TEST(TscClockTest, CycleTimerMeasuresRegion) {
+    if (!TscClock::calibrate()) GTEST_SKIP() << "No invariant TSC";
+    CycleTimer timer;
+    timer.start();
+    volatile uint64_t sink = 0;
+    for (int i = 0; i < 1000; ++i) sink = sink + static_cast<uint64_t>(i);
+    uint64_t cycles = timer.stop();
+
+    EXPECT_GT(cycles, 0u);
+    EXPECT_EQ(timer.cycles(), cycles);
+    EXPECT_EQ(timer.nanoseconds(), TscClock::cycles_to_ns(cycles));
+}
+
+TEST(TscClockTest, ThreadClockTscMode) {
+    if (!TscClock::calibrate()) GTEST_SKIP() << "No invariant TSC";
+    ASSERT_TRUE(ThreadClock::use_tsc());
+    EXPECT_EQ(ThreadClock::mode(), ThreadClock::Mode::Tsc);
+    Timestamp a = ThreadClock::now();
+    Timestamp b = ThreadClock::now();
+    EXPECT_LE(a, b);
+    ThreadClock::use_system();
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "risk/working_orders.hpp"
+
+using namespace trading;
+
+namespace {
+
+OrderRequest order(OrderId id, Side side, Quantity qty, Price price = 15000,
+                   OrderType type = OrderType::Limit) {
+    OrderRequest req{};
+    req.id = id;
+    req.instrument = 0;
+    req.side = side;
+    req.type = type;
+    req.price = price;
+    req.quantity = qty;
+    return req;
+}
+
+ExecutionReport report(OrderId id, OrderStatus status, Quantity leaves) {
+    ExecutionReport r{};
+    r.order_id = id;
+    r.instrument = 0;
+    r.status = status;
+    r.leaves_quantity = leaves;
+    return r;
+}
+
+} // namespace
+
+TEST(WorkingOrdersTest, SendAddsPendingQuantityAndNotional) {
+    WorkingOrders working;
+    EXPECT_TRUE(working.on_order_sent(order(1, Side::Buy, 100)));
+    EXPECT_TRUE(working.on_order_sent(order(2, Side::Buy, 50, 14900)));
+    EXPECT_TRUE(working.on_order_sent(order(3, Side::Sell, 30)));
+
+    EXPECT_EQ(working.count(), 3u);
+    EXPECT_EQ(working.pending_buy(0), 150);
+    EXPECT_EQ(working.pending_sell(0), 30);
+    EXPECT_EQ(working.pending_buy_notional(0), 100 * 15000 + 50 * 14900);
+    EXPECT_EQ(working.pending_sell_notional(0), 30 * 15000);
+    // A two-sided quote counts its larger side once
+    EXPECT_EQ(working.worst_case_quantity(), 150);
+    EXPECT_EQ(working.worst_case_notional(), 100 * 15000 + 50 * 14900);
+}
+
+TEST(WorkingOrdersTest, ReportsShrinkAndEndOrders) {
+    WorkingOrders working;
+    working.on_order_sent(order(1, Side::Buy, 100));
+    working.on_order_sent(order(2, Side::Buy, 100));
+    working.on_order_sent(order(3, Side::Buy, 100));
+
+    working.on_execution_report(report(1, OrderStatus::New, 100));
+    EXPECT_EQ(working.pending_buy(0), 300);
+
+    working.on_execution_report(report(1, OrderStatus::PartiallyFilled, 40));
+    EXPECT_EQ(working.pending_buy(0), 240);
+    EXPECT_EQ(working.pending_buy_notional(0), 240 * 15000);
+
+    working.on_execution_report(report(1, OrderStatus::Filled, 0));
+    working.on_execution_report(report(2, OrderStatus::Cancelled, 100));
+    working.on_execution_report(report(3, OrderStatus::Rejected, 100));
+    EXPECT_EQ(working.count(), 0u);
+    EXPECT_EQ(working.pending_buy(0), 0);
+    EXPECT_EQ(working.worst_case_quantity(), 0);
+    EXPECT_EQ(working.worst_case_notional(), 0);
+
+    // Reports for unknown ids are ignored
+    working.on_execution_report(report(99, OrderStatus::Filled, 0));
+    EXPECT_EQ(working.pending_buy(0), 0);
+}
+
+TEST(WorkingOrdersTest, IocRemainderIsNotWorking) {
+    WorkingOrders working;
+    working.on_order_sent(order(1, Side::Sell, 100, 15000, OrderType::IOC));
+    EXPECT_EQ(working.pending_sell(0), 100);
+    working.on_execution_report(report(1, OrderStatus::PartiallyFilled, 60));
+    EXPECT_EQ(working.pending_sell(0), 0);
+    EXPECT_EQ(working.count(), 0u);
+}
+
+TEST(WorkingOrdersTest, ReplaceDropsOriginalOnFirstReport) {
+    WorkingOrders working;
+    working.on_order_sent(order(1, Side::Buy, 100, 15000));
+
+    OrderRequest replace = order(2, Side::Buy, 80, 15010);
+    replace.action = OrderAction::Replace;
+    replace.orig_id = 1;
+    working.on_order_sent(replace);
+    EXPECT_EQ(working.pending_buy(0), 180);   // Both until the venue answers
+
+    working.on_execution_report(report(2, OrderStatus::New, 80));
+    EXPECT_EQ(working.pending_buy(0), 80);
+    EXPECT_EQ(working.pending_buy_notional(0), 80 * 15010);
+    EXPECT_EQ(working.find(1), nullptr);
+    ASSERT_NE(working.find(2), nullptr);
+    EXPECT_EQ(working.find(2)->replaces, 0u);
+}
+
+TEST(WorkingOrdersTest, CancelRequestWaitsForReport) {
+    WorkingOrders working;
+    working.on_order_sent(order(1, Side::Sell, 100));
+
+    OrderRequest cancel = order(2, Side::Sell, 100);
+    cancel.action = OrderAction::Cancel;
+    cancel.orig_id = 1;
+    EXPECT_TRUE(working.on_order_sent(cancel));
+    EXPECT_EQ(working.pending_sell(0), 100);
+    EXPECT_EQ(working.count(), 1u);
+
+    working.on_execution_report(report(1, OrderStatus::Cancelled, 0));
+    EXPECT_EQ(working.pending_sell(0), 0);
+}
+
+TEST(WorkingOrdersTest, RejectsUntrackableOrders) {
+    WorkingOrders working;
+    OrderRequest bad = order(1, Side::Buy, 100);
+    bad.instrument = MAX_INSTRUMENTS;
+    EXPECT_FALSE(working.on_order_sent(bad));
+    EXPECT_EQ(working.pending_buy(MAX_INSTRUMENTS), 0);
+    EXPECT_EQ(working.count(), 0u);
+}